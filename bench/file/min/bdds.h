@@ -0,0 +1,101 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __BENCHDDS__
+#define __BENCHDDS__
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "file/min/dds.h"
+
+double bench_dds_load(const std::string &file)
+{
+    // Start the time clock
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Load every mip level
+    const min::dds d(file);
+
+    // Calculate the difference between start and end
+    const auto dtime = std::chrono::high_resolution_clock::now() - start;
+
+    // Print the execution time and memory held
+    const double out = std::chrono::duration<double, std::milli>(dtime).count();
+    std::cout << "dds: full load of " << d.get_mips() << " mips in: " << out << " ms, holding " << d.get_size() << " bytes" << std::endl;
+
+    return out;
+}
+
+double bench_dds_stream(const std::string &file, const uint32_t levels)
+{
+    // Start the time clock
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Read the header and only the smallest mips
+    min::dds_stream stream(file);
+    std::vector<uint8_t> level;
+    const uint32_t mips = stream.get_mips();
+    for (uint32_t i = mips; i-- > mips - levels;)
+    {
+        stream.read_level(i, level);
+    }
+
+    // Calculate the difference between start and end
+    const auto dtime = std::chrono::high_resolution_clock::now() - start;
+
+    // Print the execution time and memory held
+    const double out = std::chrono::duration<double, std::milli>(dtime).count();
+    std::cout << "dds: stream of smallest " << levels << " mips in: " << out << " ms, holding " << level.capacity() << " bytes" << std::endl;
+
+    return out;
+}
+
+double bench_dds()
+{
+    // Running dds test
+    std::cout << std::endl
+              << "dds: Time to first mips of a large texture" << std::endl;
+
+    // Write a 4096x4096 DXT1 texture with a full mip chain
+    const uint32_t size = 4096;
+    const uint32_t mips = 13;
+    uint32_t bytes = 0;
+    for (uint32_t i = 0; i < mips; i++)
+    {
+        const uint32_t w = std::max((uint32_t)1, size >> i);
+        bytes += ((w + 3) / 4) * ((w + 3) / 4) * 8;
+    }
+    std::vector<uint8_t> pixels(bytes);
+    for (size_t i = 0; i < bytes; i++)
+    {
+        pixels[i] = static_cast<uint8_t>(i * 31);
+    }
+    const std::vector<uint8_t> data = min::dds(size, size, mips, min::dds::DXT1, pixels).to_file();
+    std::ofstream file("bin/bench_stream.dds", std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    file.close();
+
+    // Time the full load versus the smallest mips
+    double out = 0.0;
+    out += bench_dds_load("bin/bench_stream.dds");
+    out += bench_dds_stream("bin/bench_stream.dds", 6);
+
+    // Calculate cost of calculation (milliseconds)
+    return out;
+}
+
+#endif
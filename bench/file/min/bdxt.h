@@ -0,0 +1,75 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __BENCHDXT__
+#define __BENCHDXT__
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+#include "file/min/dxt_encoder.h"
+#include "platform/min/thread_pool.h"
+
+double bench_dxt_compress(const min::dxt_encoder &encoder, const min::bmp &image, const std::string &type, const uint32_t format)
+{
+    // Start the time clock
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Compress the image with a full mip chain
+    const min::dds d = (format == min::dds::DXT1) ? encoder.compress_bmp_dds_dxt1(image) : encoder.compress_bmp_dds_dxt5(image);
+
+    // Calculate the difference between start and end
+    const auto dtime = std::chrono::high_resolution_clock::now() - start;
+
+    // Print the execution time and throughput
+    const double out = std::chrono::duration<double, std::milli>(dtime).count();
+    const double pixels = image.get_width() * image.get_height();
+    std::cout << "dxt: " << type << ((format == min::dds::DXT1) ? " DXT1" : " DXT5") << " with " << d.get_mips() << " mips compressed in: "
+              << out << " ms, " << pixels / (out * 1000.0) << " MPixel/s" << std::endl;
+
+    return out;
+}
+
+double bench_dxt()
+{
+    // Running dxt test
+    std::cout << std::endl
+              << "dxt: Compressing textures on the CPU" << std::endl;
+
+    const min::bmp image("data/texture/stone.bmp");
+    min::thread_pool pool;
+
+    double out = 0.0;
+
+    // Compress at each quality level on one thread and on the pool
+    const std::vector<std::pair<unsigned, std::string>> quality = {
+        {min::dxt_encoder::FAST, "fast"},
+        {min::dxt_encoder::NORMAL, "normal"},
+        {min::dxt_encoder::HIGH, "high"}};
+    for (const auto &q : quality)
+    {
+        const min::dxt_encoder serial(q.first);
+        const min::dxt_encoder parallel(pool, q.first);
+        out += bench_dxt_compress(serial, image, q.second, min::dds::DXT1);
+        out += bench_dxt_compress(parallel, image, q.second + " pool", min::dds::DXT1);
+        out += bench_dxt_compress(serial, image, q.second, min::dds::DXT5);
+        out += bench_dxt_compress(parallel, image, q.second + " pool", min::dds::DXT5);
+    }
+
+    // Calculate cost of calculation (milliseconds)
+    return out;
+}
+
+#endif
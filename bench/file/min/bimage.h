@@ -0,0 +1,71 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __BENCHIMAGE__
+#define __BENCHIMAGE__
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+#include "file/min/image.h"
+#include "platform/min/thread_pool.h"
+
+double bench_image_mips(const min::image &image, const std::string &type, const unsigned filter, const bool srgb, min::thread_pool *const pool)
+{
+    // Start the time clock
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Filter a full mip chain
+    const std::vector<min::image> mips = image.mip_chain(filter, srgb, pool);
+
+    // Calculate the difference between start and end
+    const auto dtime = std::chrono::high_resolution_clock::now() - start;
+
+    // Print the execution time and throughput
+    const double out = std::chrono::duration<double, std::milli>(dtime).count();
+    const double pixels = image.get_width() * image.get_height();
+    std::cout << "image: " << type << ((srgb) ? " srgb" : "") << ((pool) ? " pool" : "") << " with " << mips.size() << " mips filtered in: "
+              << out << " ms, " << pixels / (out * 1000.0) << " MPixel/s" << std::endl;
+
+    return out;
+}
+
+double bench_image()
+{
+    // Running image test
+    std::cout << std::endl
+              << "image: Filtering mip chains on the CPU" << std::endl;
+
+    const min::image image(min::bmp("data/texture/stone.bmp"));
+    min::thread_pool pool;
+
+    double out = 0.0;
+
+    // Filter with each filter, in linear and sRGB space, on one thread and on the pool
+    const std::vector<std::pair<unsigned, std::string>> filter = {
+        {min::image::BOX, "box"},
+        {min::image::KAISER, "kaiser"}};
+    for (const auto &f : filter)
+    {
+        out += bench_image_mips(image, f.second, f.first, false, nullptr);
+        out += bench_image_mips(image, f.second, f.first, true, nullptr);
+        out += bench_image_mips(image, f.second, f.first, true, &pool);
+    }
+
+    // Calculate cost of calculation (milliseconds)
+    return out;
+}
+
+#endif
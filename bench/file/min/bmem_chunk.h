@@ -0,0 +1,81 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __BENCHMEMCHUNK__
+#define __BENCHMEMCHUNK__
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "file/min/mem_chunk.h"
+
+double bench_mem_chunk_load(const std::string &file, const std::vector<std::string> &names, const bool map)
+{
+    // Start the time clock
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Open the archive and read every file
+    min::mem_chunk chunk(file, map);
+    size_t bytes = 0;
+    for (const auto &name : names)
+    {
+        bytes += chunk.get_file(name).size();
+    }
+
+    // Calculate the difference between start and end
+    const auto dtime = std::chrono::high_resolution_clock::now() - start;
+
+    // Print the execution time and throughput
+    const double out = std::chrono::duration<double, std::milli>(dtime).count();
+    std::cout << "mem_chunk: " << file << ((map) ? " mapped" : " loaded") << " in: " << out << " ms, "
+              << bytes / (out * 1000.0) << " MB/s" << std::endl;
+
+    return out;
+}
+
+double bench_mem_chunk()
+{
+    // Running mem_chunk test
+    std::cout << std::endl
+              << "mem_chunk: Packing models and textures, raw and compressed" << std::endl;
+
+    const std::vector<std::string> names = {
+        "data/models/mech_warrior.md5mesh",
+        "data/models/mech_warrior_walk.md5anim",
+        "data/models/art_cube.obj",
+        "data/texture/art_cube.bmp",
+        "data/texture/stone.dds"};
+
+    // Write raw and compressed archives
+    min::mem_chunk raw;
+    min::mem_chunk packed;
+    for (const auto &name : names)
+    {
+        raw.add_file(name);
+        packed.add_file(name, true);
+    }
+    raw.write_memory_file("bin/bench_chunk_raw");
+    packed.write_memory_file("bin/bench_chunk_lz");
+
+    // Time loading and mapping each archive
+    double out = 0.0;
+    out += bench_mem_chunk_load("bin/bench_chunk_raw", names, false);
+    out += bench_mem_chunk_load("bin/bench_chunk_raw", names, true);
+    out += bench_mem_chunk_load("bin/bench_chunk_lz", names, false);
+    out += bench_mem_chunk_load("bin/bench_chunk_lz", names, true);
+
+    // Calculate cost of calculation (milliseconds)
+    return out;
+}
+#endif
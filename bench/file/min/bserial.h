@@ -0,0 +1,107 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __BENCHSERIAL__
+#define __BENCHSERIAL__
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "file/min/mem_chunk.h"
+#include "geom/min/mesh.h"
+
+template <typename T, typename K>
+min::mesh<T, K> make_serial_mesh(const size_t N)
+{
+    // Create an N x N grid of vertices with every attribute filled in
+    min::mesh<T, K> out("grid");
+    for (size_t i = 0; i < N; i++)
+    {
+        for (size_t j = 0; j < N; j++)
+        {
+            const T x = static_cast<T>(i);
+            const T z = static_cast<T>(j);
+            out.vertex.emplace_back(x, 0.0, z, 1.0);
+            out.uv.emplace_back(x / N, z / N);
+            out.normal.emplace_back(0.0, 1.0, 0.0);
+            out.tangent.emplace_back(1.0, 0.0, 0.0);
+            out.bitangent.emplace_back(0.0, 0.0, 1.0);
+            out.bone_index.emplace_back(0.0, 1.0, 2.0, 3.0);
+            out.bone_weight.emplace_back(0.25, 0.25, 0.25, 0.25);
+        }
+    }
+
+    // Two triangles per grid cell
+    for (size_t i = 0; i < N - 1; i++)
+    {
+        for (size_t j = 0; j < N - 1; j++)
+        {
+            const K a = static_cast<K>(i * N + j);
+            const K b = static_cast<K>(a + N);
+            out.index.insert(out.index.end(), {a, b, static_cast<K>(a + 1), static_cast<K>(a + 1), b, static_cast<K>(b + 1)});
+        }
+    }
+
+    return out;
+}
+
+template <typename T, typename K, typename M>
+double bench_deserialize(const M &stream, const std::string &type, const size_t bytes)
+{
+    // Start the time clock
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Deserialize the mesh
+    min::mesh<T, K> m("grid");
+    m.deserialize(stream);
+
+    // Calculate the difference between start and end
+    const auto dtime = std::chrono::high_resolution_clock::now() - start;
+
+    // Print the execution time and throughput
+    const double out = std::chrono::duration<double, std::milli>(dtime).count();
+    std::cout << "serial: " << type << " mesh with " << m.vertex.size() << " vertices deserialized in: " << out << " ms, "
+              << bytes / (out * 1000.0) << " MB/s" << std::endl;
+
+    return out;
+}
+
+double bench_serial()
+{
+    // Running serial test
+    std::cout << std::endl
+              << "serial: Deserializing large meshes from memory" << std::endl;
+
+    double out = 0.0;
+
+    // Deserialize a float mesh from a byte vector and from a mem_file
+    {
+        std::vector<uint8_t> stream;
+        make_serial_mesh<float, uint32_t>(1000).serialize(stream);
+        const min::mem_file mem(&stream, 0, stream.size());
+        out += bench_deserialize<float, uint32_t>(stream, "float", stream.size());
+        out += bench_deserialize<float, uint32_t>(mem, "float mem_file", stream.size());
+    }
+
+    // Deserialize a double mesh from a byte vector
+    {
+        std::vector<uint8_t> stream;
+        make_serial_mesh<double, uint16_t>(250).serialize(stream);
+        out += bench_deserialize<double, uint16_t>(stream, "double", stream.size());
+    }
+
+    // Calculate cost of calculation (milliseconds)
+    return out;
+}
+#endif
@@ -13,9 +13,15 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 #include <iostream>
+#include <min/bbatch.h>
+#include <min/bdds.h>
+#include <min/bdxt.h>
+#include <min/bimage.h>
 #include <min/bmd5.h>
+#include <min/bmem_chunk.h>
 #include <min/bmesh.h>
 #include <min/bphysics.h>
+#include <min/bserial.h>
 #include <min/bspatial.h>
 #include <min/bwavefront.h>
 #include "scene/min/grid.h"
@@ -370,6 +376,30 @@ int main(int argc, char *argv[])
         iR = bench_md5();
         I += 100.0 / iR;
 
+        // Test batch transforms
+        iR = bench_batch();
+        I += 100.0 / iR;
+
+        // Test load mem_chunk
+        iR = bench_mem_chunk();
+        I += 100.0 / iR;
+
+        // Test deserialize mesh
+        iR = bench_serial();
+        I += 100.0 / iR;
+
+        // Test stream dds mips
+        iR = bench_dds();
+        I += 100.0 / iR;
+
+        // Test filter mip chains
+        iR = bench_image();
+        I += 100.0 / iR;
+
+        // Test compress dxt textures
+        iR = bench_dxt();
+        I += 100.0 / iR;
+
         // Enable logging to cout
         std::cout.clear();
 
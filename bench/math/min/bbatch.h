@@ -0,0 +1,66 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __BENCHBATCH__
+#define __BENCHBATCH__
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "math/min/batch.h"
+
+double bench_batch()
+{
+    // Running batch transform test
+    std::cout << std::endl
+              << "batch: Transforming 1048576 points and multiplying 65536 matrices" << std::endl;
+
+    // Local variables
+    const size_t points = 1048576;
+    const size_t matrices = 65536;
+    const min::mat4<float> m(min::vec3<float>(1.0, 2.0, 3.0), min::mat3<float>(min::quat<float>(min::vec3<float>(0.0, 1.0, 0.0), 45.0)));
+    std::vector<min::vec4<float>> p(points, min::vec4<float>(1.0, 2.0, 3.0, 1.0));
+    std::vector<min::mat4<float>> a(matrices, m);
+    std::vector<min::mat4<float>> b(matrices, m);
+    std::vector<min::mat4<float>> c(matrices);
+
+    // Time the per element loops
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < points; i++)
+    {
+        p[i] = m * p[i];
+    }
+    for (size_t i = 0; i < matrices; i++)
+    {
+        c[i] = a[i] * b[i];
+    }
+    auto dtime = std::chrono::high_resolution_clock::now() - start;
+    const double element = std::chrono::duration<double, std::milli>(dtime).count();
+    std::cout << "batch: per element loops in: " << element << " ms" << std::endl;
+
+    // Reset the points and time the batch kernels
+    std::fill(p.begin(), p.end(), min::vec4<float>(1.0, 2.0, 3.0, 1.0));
+    start = std::chrono::high_resolution_clock::now();
+    min::transform_points(m, p.data(), p.size());
+    min::multiply_matrices(a.data(), b.data(), c.data(), c.size());
+    dtime = std::chrono::high_resolution_clock::now() - start;
+
+    // Print the execution time
+    const double out = std::chrono::duration<double, std::milli>(dtime).count();
+    std::cout << "batch: batch kernels in: " << out << " ms" << std::endl;
+
+    // Calculate cost of calculation (milliseconds)
+    return out;
+}
+#endif
@@ -16,7 +16,42 @@ limitations under the License.
 #define BENCHWAVEFRONT
 
 #include <chrono>
+#include <sstream>
 #include "file/min/wavefront.h"
+#include "platform/min/thread_pool.h"
+
+std::vector<uint8_t> make_wavefront(const size_t N)
+{
+    // Generate a triangulated N x N grid as OBJ text
+    std::ostringstream s;
+    s << "o grid" << std::endl;
+    for (size_t i = 0; i < N; i++)
+    {
+        for (size_t j = 0; j < N; j++)
+        {
+            s << "v " << j * 0.01 << " " << ((i * j) % 7) * 0.125 << " " << i * -0.01 << std::endl;
+            s << "vt " << j / (N - 1.0) << " " << i / (N - 1.0) << std::endl;
+        }
+    }
+    s << "vn 0.0 1.0 0.0" << std::endl;
+
+    // Two triangles per grid cell
+    for (size_t i = 0; i < N - 1; i++)
+    {
+        for (size_t j = 0; j < N - 1; j++)
+        {
+            const size_t a = i * N + j + 1;
+            const size_t b = a + 1;
+            const size_t c = a + N;
+            const size_t d = c + 1;
+            s << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << c << "/" << c << "/1" << std::endl;
+            s << "f " << b << "/" << b << "/1 " << d << "/" << d << "/1 " << c << "/" << c << "/1" << std::endl;
+        }
+    }
+
+    const std::string str = s.str();
+    return std::vector<uint8_t>(str.begin(), str.end());
+}
 
 double bench_wavefront()
 {
@@ -40,7 +75,27 @@ double bench_wavefront()
     const double out = std::chrono::duration<double, std::milli>(dtime).count();
     std::cout << "wavefront: OBJ mesh loaded in: " << out << " ms" << std::endl;
 
+    // Generate a very large OBJ in memory
+    std::vector<uint8_t> data = make_wavefront(500);
+    const min::mem_file mem(&data, 0, data.size());
+    std::cout << "wavefront: Parsing a generated " << data.size() / 1048576 << " MB model" << std::endl;
+
+    // Parse on this thread
+    const auto serial_start = std::chrono::high_resolution_clock::now();
+    min::wavefront<float, uint32_t> serial(mem);
+    const auto serial_time = std::chrono::high_resolution_clock::now() - serial_start;
+    const double serial_out = std::chrono::duration<double, std::milli>(serial_time).count();
+    std::cout << "wavefront: serial parse in: " << serial_out << " ms" << std::endl;
+
+    // Parse on the thread pool
+    min::thread_pool pool;
+    const auto pool_start = std::chrono::high_resolution_clock::now();
+    min::wavefront<float, uint32_t> parallel(mem, pool);
+    const auto pool_time = std::chrono::high_resolution_clock::now() - pool_start;
+    const double pool_out = std::chrono::duration<double, std::milli>(pool_time).count();
+    std::cout << "wavefront: " << pool.get_size() << " thread parse in: " << pool_out << " ms" << std::endl;
+
     // Calculate cost of calculation (milliseconds)
-    return out;
+    return out + serial_out + pool_out;
 }
 #endif
@@ -155,16 +155,17 @@ class md5_render_loop_test
         // Get model ID for later use
         _model_id = _ubuffer.add_matrix(_model_matrix);
 
-        // Add bones matrices to uniform buffer
+        // Add bones matrices to uniform buffer, each bone is three vector rows
         for (const auto &bone : _md5_model.get_bones())
         {
-            size_t bone_id = _ubuffer.add_matrix(bone);
+            size_t bone_id = _ubuffer.add_affine(bone);
             _bone_id.push_back(bone_id);
         }
 
         // Load the uniform buffer with the program we will use
         _ubuffer.set_program_lights(_vert_prog);
         _ubuffer.set_program_matrix(_vert_prog);
+        _ubuffer.set_program_vector(_vert_prog);
 
         // Bind this uniform buffer for use
         _ubuffer.bind();
@@ -185,7 +186,7 @@ class md5_render_loop_test
           _text_prog(_text_vertex, _text_fragment),
           _md5_model(std::move(min::md5_mesh<float, uint32_t>("data/models/mech_warrior.md5mesh"))),
           _text_buffer("data/fonts/open_sans.ttf", 14),
-          _ubuffer(1, 100, 0),
+          _ubuffer(1, 3, 300),
           _light_color(1.0, 1.0, 1.0, 1.0),
           _light_position(-9.0, 10.0, 0.0, 1.0),
           _light_power(0.1, 200.0, 100.0, 1.0)
@@ -260,7 +261,7 @@ class md5_render_loop_test
         const size_t size = bones.size();
         for (size_t i = 0; i < size; i++)
         {
-            _ubuffer.set_matrix(bones[i], _bone_id[i]);
+            _ubuffer.set_affine(bones[i], _bone_id[i]);
         }
 
         // Update the matrix and light buffer
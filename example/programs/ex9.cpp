@@ -115,16 +115,17 @@ class character
         // Get model ID for later use
         _model_id = _ubuffer.add_matrix(_model_matrix);
 
-        // Add bones matrices to uniform buffer
+        // Add bones matrices to uniform buffer, each bone is three vector rows
         for (const auto &bone : _md5_model.get_bones())
         {
-            size_t bone_id = _ubuffer.add_matrix(bone);
+            size_t bone_id = _ubuffer.add_affine(bone);
             _bone_id.push_back(bone_id);
         }
 
         // Load the uniform buffer with the program we will use
         _ubuffer.set_program_lights(_prog);
         _ubuffer.set_program_matrix(_prog);
+        _ubuffer.set_program_vector(_prog);
     }
 
   public:
@@ -132,7 +133,7 @@ class character
                   _fragment("data/shader/md5.fragment", GL_FRAGMENT_SHADER),
                   _prog(_vertex, _fragment),
                   _md5_model(std::move(min::md5_mesh<float, uint32_t>("data/models/mech_warrior.md5mesh"))),
-                  _ubuffer(1, 100, 0),
+                  _ubuffer(1, 3, 300),
                   _light_color(1.0, 1.0, 1.0, 1.0),
                   _light_position(0.0, 40.0, 0.0, 1.0),
                   _light_power(0.1, 1000.0, 10.0, 1.0)
@@ -162,7 +163,7 @@ class character
         const size_t size = bones.size();
         for (size_t i = 0; i < size; i++)
         {
-            _ubuffer.set_matrix(bones[i], _bone_id[i]);
+            _ubuffer.set_affine(bones[i], _bone_id[i]);
         }
 
         // Bind this uniform buffer for use
@@ -0,0 +1,266 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "asset_loader.h"
+
+template std::future<std::shared_ptr<min::bmp>> min::asset_loader::load<min::bmp>(const std::string&);
+template std::future<std::shared_ptr<min::bmp>> min::asset_loader::load<min::bmp>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::bmp>(const std::string&, const std::function<void(const std::shared_ptr<min::bmp>&)>&);
+template void min::asset_loader::load<min::bmp>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::bmp>&)>&);
+template std::future<std::shared_ptr<min::dds>> min::asset_loader::load<min::dds>(const std::string&);
+template std::future<std::shared_ptr<min::dds>> min::asset_loader::load<min::dds>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::dds>(const std::string&, const std::function<void(const std::shared_ptr<min::dds>&)>&);
+template void min::asset_loader::load<min::dds>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::dds>&)>&);
+template std::future<std::shared_ptr<min::ogg>> min::asset_loader::load<min::ogg>(const std::string&);
+template std::future<std::shared_ptr<min::ogg>> min::asset_loader::load<min::ogg>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::ogg>(const std::string&, const std::function<void(const std::shared_ptr<min::ogg>&)>&);
+template void min::asset_loader::load<min::ogg>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::ogg>&)>&);
+template std::future<std::shared_ptr<min::wave>> min::asset_loader::load<min::wave>(const std::string&);
+template std::future<std::shared_ptr<min::wave>> min::asset_loader::load<min::wave>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::wave>(const std::string&, const std::function<void(const std::shared_ptr<min::wave>&)>&);
+template void min::asset_loader::load<min::wave>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::wave>&)>&);
+template std::future<std::shared_ptr<min::wavefront<float, unsigned int>>> min::asset_loader::load<min::wavefront<float, unsigned int>>(const std::string&);
+template std::future<std::shared_ptr<min::wavefront<float, unsigned int>>> min::asset_loader::load<min::wavefront<float, unsigned int>>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::wavefront<float, unsigned int>>(const std::string&, const std::function<void(const std::shared_ptr<min::wavefront<float, unsigned int>>&)>&);
+template void min::asset_loader::load<min::wavefront<float, unsigned int>>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::wavefront<float, unsigned int>>&)>&);
+template std::future<std::shared_ptr<min::wavefront<double, unsigned short>>> min::asset_loader::load<min::wavefront<double, unsigned short>>(const std::string&);
+template std::future<std::shared_ptr<min::wavefront<double, unsigned short>>> min::asset_loader::load<min::wavefront<double, unsigned short>>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::wavefront<double, unsigned short>>(const std::string&, const std::function<void(const std::shared_ptr<min::wavefront<double, unsigned short>>&)>&);
+template void min::asset_loader::load<min::wavefront<double, unsigned short>>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::wavefront<double, unsigned short>>&)>&);
+template std::future<std::shared_ptr<min::md5_mesh<float, unsigned short>>> min::asset_loader::load<min::md5_mesh<float, unsigned short>>(const std::string&);
+template std::future<std::shared_ptr<min::md5_mesh<float, unsigned short>>> min::asset_loader::load<min::md5_mesh<float, unsigned short>>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::md5_mesh<float, unsigned short>>(const std::string&, const std::function<void(const std::shared_ptr<min::md5_mesh<float, unsigned short>>&)>&);
+template void min::asset_loader::load<min::md5_mesh<float, unsigned short>>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::md5_mesh<float, unsigned short>>&)>&);
+template std::future<std::shared_ptr<min::md5_anim<float>>> min::asset_loader::load<min::md5_anim<float>>(const std::string&);
+template std::future<std::shared_ptr<min::md5_anim<float>>> min::asset_loader::load<min::md5_anim<float>>(const min::mem_chunk&, const std::string&);
+template void min::asset_loader::load<min::md5_anim<float>>(const std::string&, const std::function<void(const std::shared_ptr<min::md5_anim<float>>&)>&);
+template void min::asset_loader::load<min::md5_anim<float>>(const min::mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<min::md5_anim<float>>&)>&);
+
+void min::asset_loader::defer(std::function<void()> &&task)
+{
+    // Wait for room in the upload queue, this throttles workers if the render thread falls behind
+    std::unique_lock<std::mutex> lock(_lock);
+    _upload_space.wait(lock, [this]() { return _kill || _upload.size() < _upload_size; });
+    if (_kill)
+    {
+        return;
+    }
+
+    // Queue the task for the render thread
+    _upload.push_back(std::move(task));
+    _upload_ready.notify_one();
+}
+
+void min::asset_loader::push(std::function<void()> &&task)
+{
+    // Queue the task for the workers
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _work.push_back(std::move(task));
+        _pending++;
+    }
+    _work_ready.notify_one();
+}
+
+void min::asset_loader::worker()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true)
+    {
+        // Sleep until there is work to do or we are shutting down
+        _work_ready.wait(lock, [this]() { return _kill || !_work.empty(); });
+        if (_kill)
+        {
+            return;
+        }
+
+        // Take the oldest task
+        std::function<void()> task = std::move(_work.front());
+        _work.pop_front();
+
+        // Load without holding the lock
+        lock.unlock();
+        task();
+        lock.lock();
+
+        // Signal the render thread if we are the last load to finish
+        if (--_pending == 0)
+        {
+            _upload_ready.notify_all();
+        }
+    }
+}
+
+template <typename L>
+std::future<std::shared_ptr<L>> min::asset_loader::load_future(const std::function<std::shared_ptr<L>()> &read)
+{
+    // The promise is shared so the task can be copied into a std::function
+    std::shared_ptr<std::promise<std::shared_ptr<L>>> promise = std::make_shared<std::promise<std::shared_ptr<L>>>();
+    std::future<std::shared_ptr<L>> out = promise->get_future();
+
+    // Errors are stored in the future
+    push([promise, read]() {
+        try
+        {
+            promise->set_value(read());
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    return out;
+}
+
+template <typename L>
+void min::asset_loader::load_callback(const std::function<std::shared_ptr<L>()> &read, const std::function<void(const std::shared_ptr<L>&)> &done)
+{
+    // Errors are rethrown on the render thread
+    push([this, read, done]() {
+        std::shared_ptr<L> asset;
+        try
+        {
+            asset = read();
+        }
+        catch (...)
+        {
+            const std::exception_ptr error = std::current_exception();
+            defer([error]() { std::rethrow_exception(error); });
+            return;
+        }
+
+        // Hand the asset to the render thread
+        defer([asset, done]() { done(asset); });
+    });
+}
+
+min::asset_loader::asset_loader() : asset_loader(std::thread::hardware_concurrency(), 64) {}
+
+min::asset_loader::asset_loader(const size_t size, const size_t upload_size)
+    : _upload_size((upload_size > 0) ? upload_size : 1), _pending(0), _kill(false)
+{
+    // Always have at least one worker
+    const size_t workers = (size > 0) ? size : 1;
+    _threads.reserve(workers);
+    for (size_t i = 0; i < workers; i++)
+    {
+        _threads.emplace_back(&asset_loader::worker, this);
+    }
+}
+
+min::asset_loader::~asset_loader()
+{
+    // Wake up all workers and tell them to quit, queued loads are dropped
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _kill = true;
+    }
+    _work_ready.notify_all();
+    _upload_space.notify_all();
+
+    // Wait for all workers to quit
+    for (auto &t : _threads)
+    {
+        t.join();
+    }
+}
+
+template <typename L>
+std::future<std::shared_ptr<L>> min::asset_loader::load(const std::string &file)
+{
+    return load_future<L>([file]() { return std::make_shared<L>(file); });
+}
+
+template <typename L>
+std::future<std::shared_ptr<L>> min::asset_loader::load(const mem_chunk &chunk, const std::string &name)
+{
+    const mem_chunk *const c = &chunk;
+    return load_future<L>([c, name]() { return std::make_shared<L>(c->get_file(name)); });
+}
+
+template <typename L>
+void min::asset_loader::load(const std::string &file, const std::function<void(const std::shared_ptr<L>&)> &done)
+{
+    load_callback<L>([file]() { return std::make_shared<L>(file); }, done);
+}
+
+template <typename L>
+void min::asset_loader::load(const mem_chunk &chunk, const std::string &name, const std::function<void(const std::shared_ptr<L>&)> &done)
+{
+    const mem_chunk *const c = &chunk;
+    load_callback<L>([c, name]() { return std::make_shared<L>(c->get_file(name)); }, done);
+}
+
+void min::asset_loader::finish()
+{
+    // Run uploads on this thread until all loads are done
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true)
+    {
+        while (!_upload.empty())
+        {
+            std::function<void()> task = std::move(_upload.front());
+            _upload.pop_front();
+            _upload_space.notify_one();
+
+            // Upload without holding the lock
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+
+        // Check if all loads are done
+        if (_pending == 0)
+        {
+            break;
+        }
+
+        // Sleep until there is an upload or all loads are done
+        _upload_ready.wait(lock, [this]() { return !_upload.empty() || _pending == 0; });
+    }
+}
+
+size_t min::asset_loader::get_pending() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _pending;
+}
+
+size_t min::asset_loader::get_size() const
+{
+    return _threads.size();
+}
+
+size_t min::asset_loader::upload(const size_t count)
+{
+    // Run up to count uploads on this thread without waiting for loads
+    size_t out = 0;
+    std::unique_lock<std::mutex> lock(_lock);
+    while (out < count && !_upload.empty())
+    {
+        std::function<void()> task = std::move(_upload.front());
+        _upload.pop_front();
+        _upload_space.notify_one();
+
+        // Upload without holding the lock
+        lock.unlock();
+        task();
+        lock.lock();
+        out++;
+    }
+
+    return out;
+}
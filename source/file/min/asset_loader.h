@@ -0,0 +1,92 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __ASSET_LOADER__
+#define __ASSET_LOADER__
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bmp.h"
+#include "dds.h"
+#include "md5_anim.h"
+#include "md5_mesh.h"
+#include "mem_chunk.h"
+#include "ogg.h"
+#include "wave.h"
+#include "wavefront.h"
+
+// Loads assets on a set of worker threads
+// Each load returns a future, or takes a callback that is run later on the render thread by upload()
+// Callbacks go through a bounded queue, workers wait when it is full so decoded assets can not pile up
+// Use the callbacks to upload to the GPU, since GL calls must be made on the render thread
+
+// Assets can be read from files or from a mem_chunk, the mem_chunk must outlive all of its loads
+
+namespace min
+{
+
+class asset_loader
+{
+  private:
+    std::vector<std::thread> _threads;
+    std::deque<std::function<void()>> _work;
+    std::deque<std::function<void()>> _upload;
+    mutable std::mutex _lock;
+    std::condition_variable _work_ready;
+    std::condition_variable _upload_ready;
+    std::condition_variable _upload_space;
+    size_t _upload_size;
+    size_t _pending;
+    bool _kill;
+
+    void defer(std::function<void()>&&);
+    void push(std::function<void()>&&);
+    void worker();
+    template <typename L>
+    std::future<std::shared_ptr<L>> load_future(const std::function<std::shared_ptr<L>()>&);
+    template <typename L>
+    void load_callback(const std::function<std::shared_ptr<L>()>&, const std::function<void(const std::shared_ptr<L>&)>&);
+
+  public:
+    asset_loader();
+    asset_loader(const size_t, const size_t);
+    ~asset_loader();
+    asset_loader(const asset_loader &) = delete;
+    asset_loader &operator=(const asset_loader &) = delete;
+
+    template <typename L>
+    std::future<std::shared_ptr<L>> load(const std::string&);
+    template <typename L>
+    std::future<std::shared_ptr<L>> load(const mem_chunk&, const std::string&);
+    template <typename L>
+    void load(const std::string&, const std::function<void(const std::shared_ptr<L>&)>&);
+    template <typename L>
+    void load(const mem_chunk&, const std::string&, const std::function<void(const std::shared_ptr<L>&)>&);
+    void finish();
+    size_t get_pending() const;
+    size_t get_size() const;
+    size_t upload(const size_t);
+};
+}
+
+#endif
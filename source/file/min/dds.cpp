@@ -248,3 +248,181 @@ std::vector<uint8_t> min::dds::to_file() const
 
     return out;
 }
+
+void min::dds_stream::load_header(const uint8_t *const header, const size_t size)
+{
+    // Check the header
+    if (size < DDS_HEADER_SIZE)
+    {
+        throw std::runtime_error("dds_stream: File not large enough to be dds file");
+    }
+    else if (header[0] != 'D' || header[1] != 'D' || header[2] != 'S' || header[3] != ' ')
+    {
+        throw std::runtime_error("dds_stream: Invalid dds header");
+    }
+
+    // Wrap the header so we can read it like the dds loader does
+    std::vector<uint8_t> data(header, header + DDS_HEADER_SIZE);
+
+    // 4 bytes the height of the image
+    size_t next = 12;
+    _h = read_le<uint32_t>(data, next);
+
+    // 4 bytes the width of the image
+    next = 16;
+    _w = read_le<uint32_t>(data, next);
+
+    // 4 bytes the linear size of the image
+    next = 20;
+    const uint32_t linear = read_le<uint32_t>(data, next);
+
+    // 4 bytes the number of mip maps in this image
+    next = 28;
+    _mips = read_le<uint32_t>(data, next);
+
+    // 4 bytes the fourCC value from the data
+    next = 84;
+    _format = read_le<uint32_t>(data, next);
+
+    // Check format
+    if (_format != dds::DXT1 && _format != dds::DXT3 && _format != dds::DXT5)
+    {
+        throw std::runtime_error("dds_stream: Unsupported DXT format value of '" + std::to_string(_format) + "'");
+    }
+    else if (_mips == 0 || _w == 0 || _h == 0)
+    {
+        throw std::runtime_error("dds_stream: image has zero pixel data");
+    }
+
+    // A mip chain can not be longer than the chain down to 1x1
+    const uint32_t max_mips = 1 + (uint32_t)std::floor(std::log2(std::max(_w, _h)));
+    if (_mips > max_mips)
+    {
+        throw std::runtime_error("dds_stream: Invalid mip map count '" + std::to_string(_mips) + "' for image of size " + std::to_string(_w) + "x" + std::to_string(_h));
+    }
+
+    // Calculate the offset of each mip level, accurate for non-power of two textures
+    const size_t block_size = (_format == dds::DXT1) ? 8 : 16;
+    uint32_t width = _w;
+    uint32_t height = _h;
+    _offset.resize(static_cast<size_t>(_mips) + 1, 0);
+    for (uint32_t i = 0; i < _mips; i++)
+    {
+        _offset[i + 1] = _offset[i] + ((static_cast<size_t>(width) + 3) / 4) * ((static_cast<size_t>(height) + 3) / 4) * block_size;
+        width = std::max((uint32_t)1, width / 2);
+        height = std::max((uint32_t)1, height / 2);
+    }
+
+    // Verify dds has correct size
+    if (linear != _offset[_mips])
+    {
+        throw std::runtime_error("dds_stream: Expected image size '" + std::to_string(_offset[_mips]) + "' got '" + std::to_string(linear) + "'");
+    }
+}
+
+void min::dds_stream::read(const size_t offset, const size_t size, uint8_t *const dest)
+{
+    // Pixel data starts after the header
+    const size_t start = DDS_HEADER_SIZE + offset;
+    if (_mem)
+    {
+        std::memcpy(dest, _mem + start, size);
+    }
+    else
+    {
+        _file.seekg(start, std::ios::beg);
+        _file.read(reinterpret_cast<char *>(dest), size);
+        if (!_file)
+        {
+            throw std::runtime_error("dds_stream: File image size is corrupted, possibly missing data");
+        }
+    }
+}
+
+min::dds_stream::dds_stream(const std::string &file)
+    : _file(file, std::ios::in | std::ios::binary | std::ios::ate), _mem(nullptr), _mem_size(0)
+{
+    if (!_file.is_open())
+    {
+        throw std::runtime_error("dds_stream: Could not load file '" + file + "'");
+    }
+
+    // Get the size of the file
+    const size_t size = _file.tellg();
+
+    // Read only the header
+    uint8_t header[DDS_HEADER_SIZE];
+    _file.seekg(0, std::ios::beg);
+    _file.read(reinterpret_cast<char *>(header), std::min(size, (size_t)DDS_HEADER_SIZE));
+    load_header(header, size);
+
+    // Check the file size against image size
+    if (size < DDS_HEADER_SIZE + _offset[_mips])
+    {
+        throw std::runtime_error("dds_stream: File image size is corrupted, possibly missing data");
+    }
+}
+
+min::dds_stream::dds_stream(const mem_file &mem) : _mem(mem.data()), _mem_size(mem.size())
+{
+    load_header(_mem, _mem_size);
+
+    // Check the file size against image size
+    if (_mem_size < DDS_HEADER_SIZE + _offset[_mips])
+    {
+        throw std::runtime_error("dds_stream: File image size is corrupted, possibly missing data");
+    }
+}
+
+uint32_t min::dds_stream::get_format() const
+{
+    return _format;
+}
+
+uint32_t min::dds_stream::get_mips() const
+{
+    return _mips;
+}
+
+uint32_t min::dds_stream::get_width() const
+{
+    return _w;
+}
+
+uint32_t min::dds_stream::get_height() const
+{
+    return _h;
+}
+
+size_t min::dds_stream::get_size() const
+{
+    return _offset[_mips];
+}
+
+uint32_t min::dds_stream::get_level_width(const uint32_t level) const
+{
+    return std::max((uint32_t)1, _w >> level);
+}
+
+uint32_t min::dds_stream::get_level_height(const uint32_t level) const
+{
+    return std::max((uint32_t)1, _h >> level);
+}
+
+size_t min::dds_stream::get_level_size(const uint32_t level) const
+{
+    if (level >= _mips)
+    {
+        throw std::runtime_error("dds_stream: mip level '" + std::to_string(level) + "' does not exist");
+    }
+
+    return _offset[level + 1] - _offset[level];
+}
+
+void min::dds_stream::read_level(const uint32_t level, std::vector<uint8_t> &out)
+{
+    // Read only the bytes of this mip level
+    const size_t size = get_level_size(level);
+    out.resize(size);
+    read(_offset[level], size, out.data());
+}
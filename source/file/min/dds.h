@@ -16,6 +16,7 @@ limitations under the License.
 #define DDS
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <fstream>
 #include <string>
@@ -63,5 +64,40 @@ class dds
     const std::vector<uint8_t> &get_pixels() const;
     std::vector<uint8_t> to_file() const;
 };
+
+// Reads the dds header up front and each mip level on demand, so the smallest mips can
+// be drawn before the rest of the file is read, a mem_file source must outlive the stream
+class dds_stream
+{
+  private:
+    static constexpr uint8_t DDS_HEADER_SIZE = 128;
+    std::ifstream _file;
+    const uint8_t *_mem;
+    size_t _mem_size;
+    uint32_t _w;
+    uint32_t _h;
+    uint32_t _mips;
+    uint32_t _format;
+    std::vector<size_t> _offset;
+
+    void load_header(const uint8_t *const, const size_t);
+    void read(const size_t, const size_t, uint8_t *const);
+
+  public:
+    dds_stream(const std::string&);
+    dds_stream(const mem_file&);
+    dds_stream(const dds_stream&) = delete;
+    dds_stream &operator=(const dds_stream&) = delete;
+
+    uint32_t get_format() const;
+    uint32_t get_mips() const;
+    uint32_t get_width() const;
+    uint32_t get_height() const;
+    size_t get_size() const;
+    uint32_t get_level_width(const uint32_t) const;
+    uint32_t get_level_height(const uint32_t) const;
+    size_t get_level_size(const uint32_t) const;
+    void read_level(const uint32_t, std::vector<uint8_t>&);
+};
 }
 #endif
@@ -0,0 +1,712 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "dxt_encoder.h"
+
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+void min::dxt_encoder::load_block(const unsigned width, const unsigned height, const std::vector<uint8_t> &rgba, const unsigned bx, const unsigned by, block &b)
+{
+    // Partial blocks on the right and bottom edges repeat the last row and column
+    for (unsigned j = 0; j < 4; j++)
+    {
+        const size_t y = std::min(by * 4 + j, height - 1);
+        for (unsigned i = 0; i < 4; i++)
+        {
+            const size_t x = std::min(bx * 4 + i, width - 1);
+            const uint8_t *p = &rgba[(y * width + x) * 4];
+            const unsigned k = j * 4 + i;
+            b.r[k] = p[0];
+            b.g[k] = p[1];
+            b.b[k] = p[2];
+            b.a[k] = p[3];
+        }
+    }
+}
+
+float min::dxt_encoder::fit_color_indices(const block &b, const float (&palette)[4][3], uint32_t &indices)
+{
+    float total = 0.0;
+    indices = 0;
+
+#ifdef MGL_SIMD_SSE
+    alignas(16) int32_t index[4];
+    alignas(16) float error[4];
+
+    // Test four pixels against each palette entry at the same time
+    for (unsigned i = 0; i < 16; i += 4)
+    {
+        const __m128 r = _mm_load_ps(&b.r[i]);
+        const __m128 g = _mm_load_ps(&b.g[i]);
+        const __m128 bl = _mm_load_ps(&b.b[i]);
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i best_index = _mm_setzero_si128();
+        for (int j = 0; j < 4; j++)
+        {
+            const __m128 dr = _mm_sub_ps(r, _mm_set1_ps(palette[j][0]));
+            const __m128 dg = _mm_sub_ps(g, _mm_set1_ps(palette[j][1]));
+            const __m128 db = _mm_sub_ps(bl, _mm_set1_ps(palette[j][2]));
+            const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+
+            // Keep the index of the closest palette entry
+            const __m128i less = _mm_castps_si128(_mm_cmplt_ps(d, best));
+            best = _mm_min_ps(best, d);
+            best_index = _mm_or_si128(_mm_andnot_si128(less, best_index), _mm_and_si128(less, _mm_set1_epi32(j)));
+        }
+
+        _mm_store_si128(reinterpret_cast<__m128i *>(index), best_index);
+        _mm_store_ps(error, best);
+        for (unsigned k = 0; k < 4; k++)
+        {
+            indices |= static_cast<uint32_t>(index[k]) << (2 * (i + k));
+            total += error[k];
+        }
+    }
+#else
+    for (unsigned i = 0; i < 16; i++)
+    {
+        float best = std::numeric_limits<float>::max();
+        uint32_t best_index = 0;
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            const float dr = b.r[i] - palette[j][0];
+            const float dg = b.g[i] - palette[j][1];
+            const float db = b.b[i] - palette[j][2];
+            const float d = dr * dr + dg * dg + db * db;
+            if (d < best)
+            {
+                best = d;
+                best_index = j;
+            }
+        }
+
+        indices |= best_index << (2 * i);
+        total += best;
+    }
+#endif
+
+    return total;
+}
+
+void min::dxt_encoder::make_palette(const uint16_t c0, const uint16_t c1, float (&palette)[4][3])
+{
+    // Expand the endpoints and interpolate the same way the decoder does
+    uint8_t e[2][3];
+    unpack_565(c0, e[0][0], e[0][1], e[0][2]);
+    unpack_565(c1, e[1][0], e[1][1], e[1][2]);
+    for (unsigned c = 0; c < 3; c++)
+    {
+        palette[0][c] = e[0][c];
+        palette[1][c] = e[1][c];
+        palette[2][c] = (2 * e[0][c] + e[1][c]) / 3;
+        palette[3][c] = (e[0][c] + 2 * e[1][c]) / 3;
+    }
+}
+
+uint16_t min::dxt_encoder::pack_565(const float r, const float g, const float b)
+{
+    // Round each channel to the nearest 5/6/5 bit value
+    const uint16_t r5 = static_cast<uint16_t>(std::min(std::max(r, 0.0f), 255.0f) * (31.0f / 255.0f) + 0.5f);
+    const uint16_t g6 = static_cast<uint16_t>(std::min(std::max(g, 0.0f), 255.0f) * (63.0f / 255.0f) + 0.5f);
+    const uint16_t b5 = static_cast<uint16_t>(std::min(std::max(b, 0.0f), 255.0f) * (31.0f / 255.0f) + 0.5f);
+
+    return (r5 << 11) | (g6 << 5) | b5;
+}
+
+void min::dxt_encoder::unpack_565(const uint16_t c, uint8_t &r, uint8_t &g, uint8_t &b)
+{
+    // Replicate the high bits into the low bits
+    const uint8_t r5 = (c >> 11) & 0x1F;
+    const uint8_t g6 = (c >> 5) & 0x3F;
+    const uint8_t b5 = c & 0x1F;
+    r = (r5 << 3) | (r5 >> 2);
+    g = (g6 << 2) | (g6 >> 4);
+    b = (b5 << 3) | (b5 >> 2);
+}
+
+void min::dxt_encoder::refine_endpoints(const block &b, const uint32_t indices, float (&e0)[3], float (&e1)[3])
+{
+    // Weight of each endpoint for the four palette indices
+    const float w0[4] = {1.0, 0.0, 2.0 / 3.0, 1.0 / 3.0};
+    const float w1[4] = {0.0, 1.0, 1.0 / 3.0, 2.0 / 3.0};
+
+    // Build the least squares normal equations for both endpoints
+    float aa = 0.0;
+    float ab = 0.0;
+    float bb = 0.0;
+    float ax[3] = {0.0, 0.0, 0.0};
+    float bx[3] = {0.0, 0.0, 0.0};
+    for (unsigned i = 0; i < 16; i++)
+    {
+        const uint32_t index = (indices >> (2 * i)) & 0x3;
+        const float a = w0[index];
+        const float c = w1[index];
+        aa += a * a;
+        ab += a * c;
+        bb += c * c;
+        ax[0] += a * b.r[i];
+        ax[1] += a * b.g[i];
+        ax[2] += a * b.b[i];
+        bx[0] += c * b.r[i];
+        bx[1] += c * b.g[i];
+        bx[2] += c * b.b[i];
+    }
+
+    // If every pixel uses the same index the system is singular
+    const float det = aa * bb - ab * ab;
+    if (std::abs(det) < 1E-6)
+    {
+        return;
+    }
+
+    // Solve the 2x2 system for each channel
+    const float inv_det = 1.0 / det;
+    for (unsigned c = 0; c < 3; c++)
+    {
+        e0[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) * inv_det, 0.0f), 255.0f);
+        e1[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) * inv_det, 0.0f), 255.0f);
+    }
+}
+
+void min::dxt_encoder::encode_color(const block &b, const unsigned quality, uint8_t *out)
+{
+    // Calculate the mean and bounding box of the block colors
+    float mean[3] = {0.0, 0.0, 0.0};
+    float lower[3] = {255.0, 255.0, 255.0};
+    float upper[3] = {0.0, 0.0, 0.0};
+    for (unsigned i = 0; i < 16; i++)
+    {
+        const float p[3] = {b.r[i], b.g[i], b.b[i]};
+        for (unsigned c = 0; c < 3; c++)
+        {
+            mean[c] += p[c];
+            lower[c] = std::min(lower[c], p[c]);
+            upper[c] = std::max(upper[c], p[c]);
+        }
+    }
+    for (unsigned c = 0; c < 3; c++)
+    {
+        mean[c] /= 16.0;
+    }
+
+    // Calculate the covariance matrix of the block colors
+    float cov[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (unsigned i = 0; i < 16; i++)
+    {
+        const float r = b.r[i] - mean[0];
+        const float g = b.g[i] - mean[1];
+        const float bl = b.b[i] - mean[2];
+        cov[0] += r * r;
+        cov[1] += r * g;
+        cov[2] += r * bl;
+        cov[3] += g * g;
+        cov[4] += g * bl;
+        cov[5] += bl * bl;
+    }
+
+    float e0[3];
+    float e1[3];
+    if (quality == FAST)
+    {
+        // Inset the bounding box to reduce the error of the interpolated colors
+        for (unsigned c = 0; c < 3; c++)
+        {
+            const float inset = (upper[c] - lower[c]) / 16.0;
+            e0[c] = upper[c] - inset;
+            e1[c] = lower[c] + inset;
+        }
+
+        // Pick the bounding box diagonal that follows the color correlation
+        if (cov[1] < 0.0)
+        {
+            std::swap(e0[0], e1[0]);
+        }
+        if (cov[4] < 0.0)
+        {
+            std::swap(e0[2], e1[2]);
+        }
+    }
+    else
+    {
+        // Find the principal axis with power iteration starting from the bounding box diagonal
+        float axis[3] = {upper[0] - lower[0], upper[1] - lower[1], upper[2] - lower[2]};
+        for (unsigned k = 0; k < 8; k++)
+        {
+            const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            const float len = std::max(std::max(std::abs(x), std::abs(y)), std::abs(z));
+            if (len < 1E-6)
+            {
+                break;
+            }
+            axis[0] = x / len;
+            axis[1] = y / len;
+            axis[2] = z / len;
+        }
+
+        // Normalize the axis, a solid color block has no axis
+        const float len2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        if (len2 > 1E-6)
+        {
+            const float inv_len = 1.0 / std::sqrt(len2);
+            axis[0] *= inv_len;
+            axis[1] *= inv_len;
+            axis[2] *= inv_len;
+        }
+
+        // Project the colors onto the axis to find the endpoints
+        float t_min = 0.0;
+        float t_max = 0.0;
+        for (unsigned i = 0; i < 16; i++)
+        {
+            const float t = (b.r[i] - mean[0]) * axis[0] + (b.g[i] - mean[1]) * axis[1] + (b.b[i] - mean[2]) * axis[2];
+            t_min = std::min(t_min, t);
+            t_max = std::max(t_max, t);
+        }
+
+        // Inset the endpoints to reduce the error of the interpolated colors
+        const float inset = (t_max - t_min) / 16.0;
+        t_max -= inset;
+        t_min += inset;
+        for (unsigned c = 0; c < 3; c++)
+        {
+            e0[c] = std::min(std::max(mean[c] + axis[c] * t_max, 0.0f), 255.0f);
+            e1[c] = std::min(std::max(mean[c] + axis[c] * t_min, 0.0f), 255.0f);
+        }
+    }
+
+    // Quantize the endpoints, color0 > color1 selects the four color mode
+    uint16_t c0 = pack_565(e0[0], e0[1], e0[2]);
+    uint16_t c1 = pack_565(e1[0], e1[1], e1[2]);
+    if (c0 < c1)
+    {
+        std::swap(c0, c1);
+    }
+
+    // Find the closest palette entry for each pixel
+    float palette[4][3];
+    make_palette(c0, c1, palette);
+    uint32_t indices;
+    float error = fit_color_indices(b, palette, indices);
+
+    // Refine the endpoints with least squares on the chosen indices
+    if (quality == HIGH && c0 != c1)
+    {
+        for (unsigned k = 0; k < 2; k++)
+        {
+            refine_endpoints(b, indices, e0, e1);
+            uint16_t r0 = pack_565(e0[0], e0[1], e0[2]);
+            uint16_t r1 = pack_565(e1[0], e1[1], e1[2]);
+            if (r0 < r1)
+            {
+                std::swap(r0, r1);
+            }
+            else if (r0 == r1)
+            {
+                break;
+            }
+
+            // Keep the refined endpoints only if they reduce the error
+            uint32_t r_indices;
+            make_palette(r0, r1, palette);
+            const float r_error = fit_color_indices(b, palette, r_indices);
+            if (r_error >= error)
+            {
+                break;
+            }
+            c0 = r0;
+            c1 = r1;
+            indices = r_indices;
+            error = r_error;
+        }
+    }
+
+    // Equal endpoints are a solid block, use index zero everywhere
+    if (c0 == c1)
+    {
+        indices = 0;
+    }
+
+    // Write the block in little endian order
+    out[0] = c0 & 0xFF;
+    out[1] = c0 >> 8;
+    out[2] = c1 & 0xFF;
+    out[3] = c1 >> 8;
+    out[4] = indices & 0xFF;
+    out[5] = (indices >> 8) & 0xFF;
+    out[6] = (indices >> 16) & 0xFF;
+    out[7] = indices >> 24;
+}
+
+void min::dxt_encoder::encode_explicit_alpha(const block &b, uint8_t *out)
+{
+    // Store each alpha value as 4 bits, the first pixel goes in the low nibble
+    std::memset(out, 0, 8);
+    for (unsigned i = 0; i < 16; i++)
+    {
+        const uint8_t a = static_cast<uint8_t>(b.a[i] * (15.0f / 255.0f) + 0.5f);
+        out[i / 2] |= a << (4 * (i % 2));
+    }
+}
+
+void min::dxt_encoder::encode_interpolated_alpha(const block &b, uint8_t *out)
+{
+    // Find the alpha range of the block
+    float lower = 255.0;
+    float upper = 0.0;
+    for (unsigned i = 0; i < 16; i++)
+    {
+        lower = std::min(lower, b.a[i]);
+        upper = std::max(upper, b.a[i]);
+    }
+    const int a0 = static_cast<int>(upper);
+    const int a1 = static_cast<int>(lower);
+    out[0] = a0;
+    out[1] = a1;
+
+    // Equal endpoints are a solid block, use index zero everywhere
+    std::memset(&out[2], 0, 6);
+    if (a0 == a1)
+    {
+        return;
+    }
+
+    // alpha0 > alpha1 selects the eight alpha mode
+    int palette[8];
+    palette[0] = a0;
+    palette[1] = a1;
+    for (int i = 2; i < 8; i++)
+    {
+        palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+    }
+
+    // Pack the 3 bit index of the closest alpha for each pixel
+    uint64_t indices = 0;
+    for (unsigned i = 0; i < 16; i++)
+    {
+        const int a = static_cast<int>(b.a[i]);
+        int best = 256;
+        uint64_t best_index = 0;
+        for (unsigned j = 0; j < 8; j++)
+        {
+            const int d = std::abs(a - palette[j]);
+            if (d < best)
+            {
+                best = d;
+                best_index = j;
+            }
+        }
+
+        indices |= best_index << (3 * i);
+    }
+
+    for (unsigned i = 0; i < 6; i++)
+    {
+        out[2 + i] = (indices >> (8 * i)) & 0xFF;
+    }
+}
+
+void min::dxt_encoder::decode_color(const uint8_t *in, const bool four, uint8_t *out)
+{
+    // Read the endpoints and indices
+    const uint16_t c0 = in[0] | (in[1] << 8);
+    const uint16_t c1 = in[2] | (in[3] << 8);
+    const uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+
+    // Build the palette, DXT1 blocks with color0 <= color1 use three colors and transparent black
+    uint8_t palette[4][4];
+    unpack_565(c0, palette[0][0], palette[0][1], palette[0][2]);
+    unpack_565(c1, palette[1][0], palette[1][1], palette[1][2]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+    if (four || c0 > c1)
+    {
+        for (unsigned c = 0; c < 3; c++)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+    }
+    else
+    {
+        for (unsigned c = 0; c < 3; c++)
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+        palette[3][3] = 0;
+    }
+
+    for (unsigned i = 0; i < 16; i++)
+    {
+        std::memcpy(&out[i * 4], palette[(indices >> (2 * i)) & 0x3], 4);
+    }
+}
+
+void min::dxt_encoder::decode_explicit_alpha(const uint8_t *in, uint8_t *out)
+{
+    for (unsigned i = 0; i < 16; i++)
+    {
+        const uint8_t a = (in[i / 2] >> (4 * (i % 2))) & 0xF;
+        out[i * 4 + 3] = (a << 4) | a;
+    }
+}
+
+void min::dxt_encoder::decode_interpolated_alpha(const uint8_t *in, uint8_t *out)
+{
+    // Build the palette, alpha0 <= alpha1 uses six alphas plus zero and one
+    const int a0 = in[0];
+    const int a1 = in[1];
+    int palette[8];
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1)
+    {
+        for (int i = 2; i < 8; i++)
+        {
+            palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+        }
+    }
+    else
+    {
+        for (int i = 2; i < 6; i++)
+        {
+            palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    for (unsigned i = 0; i < 6; i++)
+    {
+        indices |= static_cast<uint64_t>(in[2 + i]) << (8 * i);
+    }
+    for (unsigned i = 0; i < 16; i++)
+    {
+        out[i * 4 + 3] = palette[(indices >> (3 * i)) & 0x7];
+    }
+}
+
+void min::dxt_encoder::encode_level(const unsigned width, const unsigned height, const uint32_t format, const std::vector<uint8_t> &rgba, uint8_t *out) const
+{
+    const unsigned block_size = (format == dds::DXT1) ? 8 : 16;
+    const unsigned bw = (width + 3) / 4;
+    const unsigned bh = (height + 3) / 4;
+    const unsigned quality = _quality;
+
+    // Compress one row of blocks
+    const auto work = [width, height, format, block_size, bw, quality, &rgba, out](const size_t by) {
+        block b;
+        uint8_t *row = out + by * bw * block_size;
+        for (unsigned bx = 0; bx < bw; bx++)
+        {
+            load_block(width, height, rgba, bx, by, b);
+            uint8_t *dst = row + bx * block_size;
+            if (format == dds::DXT1)
+            {
+                encode_color(b, quality, dst);
+            }
+            else if (format == dds::DXT3)
+            {
+                encode_explicit_alpha(b, dst);
+                encode_color(b, quality, dst + 8);
+            }
+            else
+            {
+                encode_interpolated_alpha(b, dst);
+                encode_color(b, quality, dst + 8);
+            }
+        }
+    };
+
+    // Block rows are independent so they can be compressed in parallel
+    if (_pool)
+    {
+        _pool->run(work, 0, bh);
+    }
+    else
+    {
+        for (size_t by = 0; by < bh; by++)
+        {
+            work(by);
+        }
+    }
+}
+
+min::dds min::dxt_encoder::compress(const bmp &b, const uint32_t format) const
+{
+    const image top(b);
+    if (top.get_width() == 0 || top.get_height() == 0)
+    {
+        throw std::runtime_error("dxt_encoder: image has zero dimension");
+    }
+
+    // Filter the mip chain on the CPU
+    const std::vector<image> levels = (_mips) ? top.mip_chain(_filter, _srgb, _pool) : std::vector<image>(1, top);
+    const unsigned mips = levels.size();
+
+    // Calculate the offset of each mip level
+    const unsigned block_size = (format == dds::DXT1) ? 8 : 16;
+    std::vector<size_t> offset(mips + 1, 0);
+    for (unsigned i = 0; i < mips; i++)
+    {
+        offset[i + 1] = offset[i] + ((levels[i].get_width() + 3) / 4) * ((levels[i].get_height() + 3) / 4) * block_size;
+    }
+
+    // Compress each level
+    std::vector<uint8_t> pixel(offset[mips]);
+    for (unsigned i = 0; i < mips; i++)
+    {
+        encode_level(levels[i].get_width(), levels[i].get_height(), format, to_rgba(levels[i]), &pixel[offset[i]]);
+    }
+
+    return dds(top.get_width(), top.get_height(), mips, format, pixel);
+}
+
+min::dxt_encoder::dxt_encoder(const unsigned quality) : _pool(nullptr), _quality(quality), _filter(image::BOX), _mips(true), _srgb(false) {}
+
+min::dxt_encoder::dxt_encoder(thread_pool &pool, const unsigned quality) : _pool(&pool), _quality(quality), _filter(image::BOX), _mips(true), _srgb(false) {}
+
+std::vector<uint8_t> min::dxt_encoder::decompress(const dds &d, const uint32_t level)
+{
+    if (level >= d.get_mips())
+    {
+        throw std::runtime_error("dxt_encoder: mip level '" + std::to_string(level) + "' does not exist");
+    }
+
+    // Find the dimensions and offset of the mip level
+    const uint32_t format = d.get_format();
+    const unsigned block_size = (format == dds::DXT1) ? 8 : 16;
+    unsigned width = d.get_width();
+    unsigned height = d.get_height();
+    size_t offset = 0;
+    for (unsigned i = 0; i < level; i++)
+    {
+        offset += ((width + 3) / 4) * ((height + 3) / 4) * block_size;
+        width = std::max((unsigned)1, width / 2);
+        height = std::max((unsigned)1, height / 2);
+    }
+
+    // Decode each block and copy the pixels that lie inside the image
+    const std::vector<uint8_t> &pixel = d.get_pixels();
+    const unsigned bw = (width + 3) / 4;
+    const unsigned bh = (height + 3) / 4;
+    std::vector<uint8_t> out(width * height * 4);
+    uint8_t rgba[64];
+    for (unsigned by = 0; by < bh; by++)
+    {
+        for (unsigned bx = 0; bx < bw; bx++)
+        {
+            const uint8_t *in = &pixel[offset + (by * bw + bx) * block_size];
+            if (format == dds::DXT1)
+            {
+                decode_color(in, false, rgba);
+            }
+            else if (format == dds::DXT3)
+            {
+                decode_color(in + 8, true, rgba);
+                decode_explicit_alpha(in, rgba);
+            }
+            else
+            {
+                decode_color(in + 8, true, rgba);
+                decode_interpolated_alpha(in, rgba);
+            }
+
+            for (unsigned j = 0; j < 4 && by * 4 + j < height; j++)
+            {
+                for (unsigned i = 0; i < 4 && bx * 4 + i < width; i++)
+                {
+                    const size_t index = ((by * 4 + j) * width + bx * 4 + i) * 4;
+                    std::memcpy(&out[index], &rgba[(j * 4 + i) * 4], 4);
+                }
+            }
+        }
+    }
+
+    return out;
+}
+
+std::vector<uint8_t> min::dxt_encoder::to_rgba(const image &img)
+{
+    const unsigned w = img.get_width();
+    const unsigned h = img.get_height();
+    const unsigned pixel_size = img.get_pixel_size();
+    const std::vector<uint8_t> &pixel = img.get_pixels();
+
+    // Bitmaps are stored bottom up, textures top down, so vertical flip and swizzle to RGBA
+    std::vector<uint8_t> out(w * h * 4);
+    for (unsigned y = 0; y < h; y++)
+    {
+        const uint8_t *in = &pixel[pixel_size * w * ((h - 1) - y)];
+        uint8_t *dst = &out[y * w * 4];
+        for (unsigned x = 0; x < w; x++)
+        {
+            if (pixel_size == 3)
+            {
+                // BGR
+                dst[0] = in[2];
+                dst[1] = in[1];
+                dst[2] = in[0];
+                dst[3] = 255;
+            }
+            else
+            {
+                // ABGR
+                dst[0] = in[3];
+                dst[1] = in[2];
+                dst[2] = in[1];
+                dst[3] = in[0];
+            }
+            in += pixel_size;
+            dst += 4;
+        }
+    }
+
+    return out;
+}
+
+min::dds min::dxt_encoder::compress_bmp_dds_dxt1(const bmp &b) const
+{
+    return compress(b, dds::DXT1);
+}
+
+min::dds min::dxt_encoder::compress_bmp_dds_dxt3(const bmp &b) const
+{
+    return compress(b, dds::DXT3);
+}
+
+min::dds min::dxt_encoder::compress_bmp_dds_dxt5(const bmp &b) const
+{
+    return compress(b, dds::DXT5);
+}
+
+void min::dxt_encoder::disable_mip_maps()
+{
+    _mips = false;
+}
+
+void min::dxt_encoder::set_mip_filter(const unsigned filter, const bool srgb)
+{
+    _filter = filter;
+    _srgb = srgb;
+}
+
+void min::dxt_encoder::set_quality(const unsigned quality)
+{
+    _quality = quality;
+}
@@ -0,0 +1,98 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef DXTENCODER
+#define DXTENCODER
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "math/min/utility.h"
+#include "platform/min/thread_pool.h"
+
+#include "bmp.h"
+#include "dds.h"
+#include "image.h"
+
+// CPU encoder for DXT1/DXT3/DXT5 (BC1/BC2/BC3) textures that does not need a GL context
+// Mip levels are filtered by image, each 4x4 block is compressed independently, so block
+// rows of every mip level are split across the thread pool if one is provided
+
+namespace min
+{
+
+class dxt_encoder
+{
+  public:
+    // Bounding box endpoints
+    static constexpr unsigned FAST = 0;
+    // Principal axis endpoints
+    static constexpr unsigned NORMAL = 1;
+    // Principal axis endpoints with least squares refinement
+    static constexpr unsigned HIGH = 2;
+
+  private:
+    // A 4x4 block of pixels stored as separate channels for the SIMD index search
+    struct block
+    {
+        alignas(16) float r[16];
+        alignas(16) float g[16];
+        alignas(16) float b[16];
+        alignas(16) float a[16];
+    };
+
+    thread_pool *_pool;
+    unsigned _quality;
+    unsigned _filter;
+    bool _mips;
+    bool _srgb;
+
+    static void load_block(const unsigned, const unsigned, const std::vector<uint8_t>&, const unsigned, const unsigned, block&);
+    static float fit_color_indices(const block&, const float (&)[4][3], uint32_t&);
+    static void make_palette(const uint16_t, const uint16_t, float (&)[4][3]);
+    static uint16_t pack_565(const float, const float, const float);
+    static void unpack_565(const uint16_t, uint8_t&, uint8_t&, uint8_t&);
+    static void refine_endpoints(const block&, const uint32_t, float (&)[3], float (&)[3]);
+    static void encode_color(const block&, const unsigned, uint8_t*);
+    static void encode_explicit_alpha(const block&, uint8_t*);
+    static void encode_interpolated_alpha(const block&, uint8_t*);
+    static void decode_color(const uint8_t*, const bool, uint8_t*);
+    static void decode_explicit_alpha(const uint8_t*, uint8_t*);
+    static void decode_interpolated_alpha(const uint8_t*, uint8_t*);
+    void encode_level(const unsigned, const unsigned, const uint32_t, const std::vector<uint8_t>&, uint8_t*) const;
+    dds compress(const bmp&, const uint32_t) const;
+
+  public:
+    dxt_encoder(const unsigned = NORMAL);
+    dxt_encoder(thread_pool&, const unsigned = NORMAL);
+
+    static std::vector<uint8_t> decompress(const dds&, const uint32_t);
+    static std::vector<uint8_t> to_rgba(const image&);
+    dds compress_bmp_dds_dxt1(const bmp&) const;
+    dds compress_bmp_dds_dxt3(const bmp&) const;
+    dds compress_bmp_dds_dxt5(const bmp&) const;
+    void disable_mip_maps();
+    void set_mip_filter(const unsigned, const bool);
+    void set_quality(const unsigned);
+};
+}
+
+#endif
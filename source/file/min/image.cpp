@@ -0,0 +1,475 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "image.h"
+
+#ifdef MGL_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+const std::array<float, 256> &min::image::srgb_to_linear()
+{
+    // Decode table for every 8 bit sRGB value
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> out;
+        for (size_t i = 0; i < 256; i++)
+        {
+            const float c = i / 255.0f;
+            out[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+
+        return out;
+    }();
+
+    return table;
+}
+
+const std::array<float, 256> &min::image::byte_to_float()
+{
+    // Decode table for every 8 bit linear value
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> out;
+        for (size_t i = 0; i < 256; i++)
+        {
+            out[i] = i / 255.0f;
+        }
+
+        return out;
+    }();
+
+    return table;
+}
+
+const std::array<uint8_t, 4096> &min::image::linear_to_srgb()
+{
+    // Encode table for linear values quantized to 12 bits
+    static const std::array<uint8_t, 4096> table = []() {
+        std::array<uint8_t, 4096> out;
+        for (size_t i = 0; i < 4096; i++)
+        {
+            const float c = i / 4095.0f;
+            const float s = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            out[i] = static_cast<uint8_t>(s * 255.0f + 0.5f);
+        }
+
+        return out;
+    }();
+
+    return table;
+}
+
+float min::image::filter_value(const unsigned filter, const float x)
+{
+    if (filter == BOX)
+    {
+        // Half open so each source pixel belongs to exactly one destination pixel
+        return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+    }
+
+    // Kaiser window with a radius of 3 pixels and alpha of 4
+    const float radius = 3.0f;
+    const float alpha = 4.0f;
+    const float t = x / radius;
+    if (std::abs(t) >= 1.0f)
+    {
+        return 0.0f;
+    }
+
+    // Zeroth order modified Bessel function of the first kind
+    const auto bessel = [](const float v) {
+        float sum = 1.0f;
+        float term = 1.0f;
+        for (int k = 1; k < 16; k++)
+        {
+            const float f = v / (2.0f * k);
+            term *= f * f;
+            sum += term;
+        }
+
+        return sum;
+    };
+
+    // Windowed sinc
+    const float pi_x = var<float>::PI * x;
+    const float sinc = (std::abs(x) < 1E-6) ? 1.0f : std::sin(pi_x) / pi_x;
+    return sinc * bessel(alpha * std::sqrt(1.0f - t * t)) / bessel(alpha);
+}
+
+min::image::filter_weights min::image::make_weights(const uint32_t in, const uint32_t out, const unsigned filter)
+{
+    // Widen the filter when downsampling so every source pixel contributes
+    const float scale = static_cast<float>(in) / out;
+    const float stretch = std::max(scale, 1.0f);
+    const float radius = (filter == BOX) ? 0.5f : 3.0f;
+    const float support = radius * stretch;
+
+    // Every destination pixel uses the same number of taps
+    filter_weights w;
+    w.taps = static_cast<size_t>(std::ceil(support * 2.0f)) + 1;
+    w.index.resize(out * w.taps);
+    w.weight.resize(out * w.taps);
+    for (uint32_t i = 0; i < out; i++)
+    {
+        // Center of the destination pixel in source pixel coordinates
+        const float center = (i + 0.5f) * scale - 0.5f;
+        const int start = static_cast<int>(std::floor(center - support));
+        const size_t offset = i * w.taps;
+
+        // Calculate the weights and clamp the taps to the image edges
+        float sum = 0.0f;
+        for (size_t k = 0; k < w.taps; k++)
+        {
+            const int j = start + static_cast<int>(k);
+            const float value = filter_value(filter, (j - center) / stretch);
+            w.index[offset + k] = std::min(std::max(j, 0), static_cast<int>(in) - 1);
+            w.weight[offset + k] = value;
+            sum += value;
+        }
+
+        // Normalize the weights, falling back to the nearest pixel
+        if (std::abs(sum) < 1E-6)
+        {
+            std::fill(&w.weight[offset], &w.weight[offset] + w.taps, 0.0f);
+            w.index[offset] = std::min(static_cast<uint32_t>(std::max(center + 0.5f, 0.0f)), in - 1);
+            w.weight[offset] = 1.0f;
+        }
+        else
+        {
+            const float inv_sum = 1.0f / sum;
+            for (size_t k = 0; k < w.taps; k++)
+            {
+                w.weight[offset + k] *= inv_sum;
+            }
+        }
+    }
+
+    // Drop taps that are zero for every destination pixel, a 2:1 box filter only needs two
+    size_t span = 1;
+    std::vector<size_t> first(out, 0);
+    for (uint32_t i = 0; i < out; i++)
+    {
+        const float *weight = &w.weight[i * w.taps];
+        size_t begin = 0;
+        size_t end = w.taps;
+        while (begin < end - 1 && weight[begin] == 0.0f)
+        {
+            begin++;
+        }
+        while (end > begin + 1 && weight[end - 1] == 0.0f)
+        {
+            end--;
+        }
+        first[i] = begin;
+        span = std::max(span, end - begin);
+    }
+
+    // Compact the taps, they stay in range since the span fits in the original taps
+    if (span < w.taps)
+    {
+        filter_weights compact;
+        compact.taps = span;
+        compact.index.resize(out * span);
+        compact.weight.resize(out * span);
+        for (uint32_t i = 0; i < out; i++)
+        {
+            const size_t begin = std::min(first[i], w.taps - span);
+            std::copy(&w.index[i * w.taps + begin], &w.index[i * w.taps + begin] + span, &compact.index[i * span]);
+            std::copy(&w.weight[i * w.taps + begin], &w.weight[i * w.taps + begin] + span, &compact.weight[i * span]);
+        }
+
+        return compact;
+    }
+
+    return w;
+}
+
+void min::image::run(const std::function<void(const size_t)> &work, const size_t size, thread_pool *const pool)
+{
+    // Rows are independent so they can be filtered in parallel
+    if (pool)
+    {
+        pool->run(work, 0, size);
+    }
+    else
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            work(i);
+        }
+    }
+}
+
+void min::image::filter_rows(const std::vector<float> &src, std::vector<float> &dst, const filter_weights &w, const uint32_t width, const uint32_t height, thread_pool *const pool)
+{
+    // Filter each row horizontally, all pixels have four float channels
+    const size_t out_width = w.index.size() / w.taps;
+    dst.resize(out_width * height * 4);
+    const auto work = [&src, &dst, &w, width, out_width](const size_t y) {
+        const float *in = &src[y * width * 4];
+        float *out = &dst[y * out_width * 4];
+        for (size_t x = 0; x < out_width; x++)
+        {
+            const uint32_t *index = &w.index[x * w.taps];
+            const float *weight = &w.weight[x * w.taps];
+#ifdef MGL_SIMD_SSE
+            __m128 sum = _mm_setzero_ps();
+            for (size_t k = 0; k < w.taps; k++)
+            {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weight[k]), _mm_loadu_ps(&in[index[k] * 4])));
+            }
+            _mm_storeu_ps(&out[x * 4], sum);
+#else
+            float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (size_t k = 0; k < w.taps; k++)
+            {
+                for (size_t c = 0; c < 4; c++)
+                {
+                    sum[c] += weight[k] * in[index[k] * 4 + c];
+                }
+            }
+            std::copy(sum, sum + 4, &out[x * 4]);
+#endif
+        }
+    };
+
+    run(work, height, pool);
+}
+
+void min::image::filter_columns(const std::vector<float> &src, std::vector<float> &dst, const filter_weights &w, const uint32_t width, thread_pool *const pool)
+{
+    // Filter vertically by blending whole source rows into each destination row
+    const size_t out_height = w.index.size() / w.taps;
+    const size_t row = width * 4;
+    dst.resize(row * out_height);
+    const auto work = [&src, &dst, &w, row](const size_t y) {
+        float *out = &dst[y * row];
+        std::fill(out, out + row, 0.0f);
+        for (size_t k = 0; k < w.taps; k++)
+        {
+            const float weight = w.weight[y * w.taps + k];
+            if (weight == 0.0f)
+            {
+                continue;
+            }
+            const float *in = &src[w.index[y * w.taps + k] * row];
+#ifdef MGL_SIMD_SSE
+            const __m128 wv = _mm_set1_ps(weight);
+            for (size_t i = 0; i < row; i += 4)
+            {
+                _mm_storeu_ps(&out[i], _mm_add_ps(_mm_loadu_ps(&out[i]), _mm_mul_ps(wv, _mm_loadu_ps(&in[i]))));
+            }
+#else
+            for (size_t i = 0; i < row; i++)
+            {
+                out[i] += weight * in[i];
+            }
+#endif
+        }
+    };
+
+    run(work, out_height, pool);
+}
+
+std::vector<float> min::image::to_float(const bool srgb) const
+{
+    // Pick the decode table for each channel, the alpha channel is always linear
+    const std::array<float, 256> &linear = byte_to_float();
+    const std::array<float, 256> &color = (srgb) ? srgb_to_linear() : linear;
+    const std::array<float, 256> *table[4] = {&color, &color, &color, &color};
+    if (_bpp == 4)
+    {
+        table[0] = &linear;
+    }
+
+    // Expand every pixel to four channels
+    const size_t pixels = static_cast<size_t>(_w) * _h;
+    std::vector<float> out(pixels * 4, 1.0f);
+    const uint8_t *in = _pixel.data();
+    float *dst = out.data();
+    for (size_t i = 0; i < pixels; i++)
+    {
+        for (size_t c = 0; c < _bpp; c++)
+        {
+            dst[c] = (*table[c])[in[c]];
+        }
+        in += _bpp;
+        dst += 4;
+    }
+
+    return out;
+}
+
+void min::image::from_float(const std::vector<float> &data, const bool srgb)
+{
+    // Clamp and quantize each channel back to 8 bits, the alpha channel is always linear
+    const std::array<uint8_t, 4096> &encode = linear_to_srgb();
+    const size_t pixels = static_cast<size_t>(_w) * _h;
+    const size_t first = (_bpp == 4) ? 1 : 0;
+    _pixel.resize(pixels * _bpp);
+    const float *in = data.data();
+    uint8_t *dst = _pixel.data();
+    for (size_t i = 0; i < pixels; i++)
+    {
+        for (size_t c = 0; c < _bpp; c++)
+        {
+            const float v = std::min(std::max(in[c], 0.0f), 1.0f);
+            dst[c] = (srgb && c >= first) ? encode[static_cast<size_t>(v * 4095.0f + 0.5f)] : static_cast<uint8_t>(v * 255.0f + 0.5f);
+        }
+        in += 4;
+        dst += _bpp;
+    }
+}
+
+min::image::image(const bmp &b) : _w(b.get_width()), _h(b.get_height()), _bpp(b.get_pixel_size())
+{
+    if (_bpp != 3 && _bpp != 4)
+    {
+        throw std::runtime_error("image: unsupported bmp pixel size of " + std::to_string(_bpp));
+    }
+
+    // Bitmap rows are padded to four bytes if the data includes padding
+    const std::vector<uint8_t> &pixel = b.get_pixels();
+    const size_t pixel_width = _bpp * _w;
+    const size_t padded_width = (pixel_width + 3) & ~static_cast<size_t>(3);
+    const size_t row = (pixel.size() >= padded_width * _h) ? padded_width : pixel_width;
+    if (pixel.size() < row * _h)
+    {
+        throw std::runtime_error("image: bmp pixel data is smaller than image dimensions");
+    }
+
+    // Copy the rows without padding
+    _pixel.resize(pixel_width * _h);
+    for (size_t y = 0; y < _h; y++)
+    {
+        std::copy(&pixel[y * row], &pixel[y * row] + pixel_width, &_pixel[y * pixel_width]);
+    }
+}
+
+min::image::image(const uint32_t width, const uint32_t height, const uint32_t pixel_size, const std::vector<uint8_t> &pixel)
+    : _w(width), _h(height), _bpp(pixel_size), _pixel(pixel)
+{
+    if (_bpp != 3 && _bpp != 4)
+    {
+        throw std::runtime_error("image: unsupported pixel size of " + std::to_string(_bpp));
+    }
+    else if (_pixel.size() != static_cast<size_t>(_w) * _h * _bpp)
+    {
+        throw std::runtime_error("image: expected pixel data of size " + std::to_string(_w * _h * _bpp) + " got " + std::to_string(_pixel.size()));
+    }
+}
+
+min::image min::image::halve(thread_pool *const pool) const
+{
+    const uint32_t w = _w / 2;
+    const uint32_t h = _h / 2;
+    image out(w, h, _bpp, std::vector<uint8_t>(static_cast<size_t>(w) * h * _bpp));
+
+    // Average each 2x2 quad of the input
+    const size_t in_row = static_cast<size_t>(_w) * _bpp;
+    const size_t out_row = static_cast<size_t>(w) * _bpp;
+    const size_t bpp = _bpp;
+    const uint8_t *in = _pixel.data();
+    uint8_t *dst = out._pixel.data();
+    const auto work = [in, dst, in_row, out_row, bpp](const size_t y) {
+        const uint8_t *r0 = in + 2 * y * in_row;
+        const uint8_t *r1 = r0 + in_row;
+        uint8_t *o = dst + y * out_row;
+        for (size_t i = 0; i < out_row; i += bpp)
+        {
+            for (size_t c = 0; c < bpp; c++)
+            {
+                const size_t j = 2 * i + c;
+                o[i + c] = (r0[j] + r0[j + bpp] + r1[j] + r1[j + bpp] + 2) >> 2;
+            }
+        }
+    };
+
+    run(work, h, pool);
+
+    return out;
+}
+
+uint32_t min::image::get_width() const
+{
+    return _w;
+}
+
+uint32_t min::image::get_height() const
+{
+    return _h;
+}
+
+uint32_t min::image::get_pixel_size() const
+{
+    return _bpp;
+}
+
+const std::vector<uint8_t> &min::image::get_pixels() const
+{
+    return _pixel;
+}
+
+std::vector<min::image> min::image::mip_chain(const unsigned filter, const bool srgb, thread_pool *const pool) const
+{
+    // Calculate mip map levels, valid for power of two and non-power of two textures
+    const unsigned mips = 1 + (unsigned)std::floor(std::log2(std::max(_w, _h)));
+
+    // Each level is filtered from the previous one
+    std::vector<image> out;
+    out.reserve(mips);
+    out.push_back(*this);
+    for (unsigned i = 1; i < mips; i++)
+    {
+        const image &prev = out.back();
+        const uint32_t w = std::max((uint32_t)1, prev._w / 2);
+        const uint32_t h = std::max((uint32_t)1, prev._h / 2);
+        out.push_back(prev.resize(w, h, filter, srgb, pool));
+    }
+
+    return out;
+}
+
+min::image min::image::resize(const uint32_t width, const uint32_t height, const unsigned filter, const bool srgb, thread_pool *const pool) const
+{
+    if (width == 0 || height == 0)
+    {
+        throw std::runtime_error("image: can not resize to zero dimension");
+    }
+
+    // Exact halving with a box filter is a 2x2 average of the encoded values
+    if (filter == BOX && !srgb && width * 2 == _w && height * 2 == _h)
+    {
+        return halve(pool);
+    }
+
+    // Filter in linear space, then horizontally and vertically
+    std::vector<float> data = to_float(srgb);
+    std::vector<float> temp;
+    if (width != _w)
+    {
+        filter_rows(data, temp, make_weights(_w, width, filter), _w, _h, pool);
+        data.swap(temp);
+    }
+    if (height != _h)
+    {
+        filter_columns(data, temp, make_weights(_h, height, filter), width, pool);
+        data.swap(temp);
+    }
+
+    // Convert back to 8 bit pixels
+    image out(width, height, _bpp, std::vector<uint8_t>(static_cast<size_t>(width) * height * _bpp));
+    out.from_float(data, srgb);
+
+    return out;
+}
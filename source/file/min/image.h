@@ -0,0 +1,85 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef IMAGE
+#define IMAGE
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "math/min/utility.h"
+#include "platform/min/thread_pool.h"
+
+#include "bmp.h"
+
+// Uncompressed 24 or 32 bit image that can be resampled on the CPU
+// Pixels keep the bmp layout, rows are stored bottom up as BGR or ABGR and are not padded
+// Resampling is separable, each pass splits its rows across the thread pool if one is provided
+
+namespace min
+{
+
+class image
+{
+  public:
+    // Averages the source pixels covered by each destination pixel
+    static constexpr unsigned BOX = 0;
+    // Kaiser windowed sinc, sharper than the box filter
+    static constexpr unsigned KAISER = 1;
+
+  private:
+    // Filter taps for each destination pixel along one axis
+    struct filter_weights
+    {
+        size_t taps;
+        std::vector<uint32_t> index;
+        std::vector<float> weight;
+    };
+
+    uint32_t _w;
+    uint32_t _h;
+    uint32_t _bpp;
+    std::vector<uint8_t> _pixel;
+
+    static const std::array<float, 256> &byte_to_float();
+    static const std::array<float, 256> &srgb_to_linear();
+    static const std::array<uint8_t, 4096> &linear_to_srgb();
+    static float filter_value(const unsigned, const float);
+    static filter_weights make_weights(const uint32_t, const uint32_t, const unsigned);
+    static void run(const std::function<void(const size_t)>&, const size_t, thread_pool *const);
+    static void filter_rows(const std::vector<float>&, std::vector<float>&, const filter_weights&, const uint32_t, const uint32_t, thread_pool *const);
+    static void filter_columns(const std::vector<float>&, std::vector<float>&, const filter_weights&, const uint32_t, thread_pool *const);
+    std::vector<float> to_float(const bool) const;
+    void from_float(const std::vector<float>&, const bool);
+    image halve(thread_pool *const) const;
+
+  public:
+    image(const bmp&);
+    image(const uint32_t, const uint32_t, const uint32_t, const std::vector<uint8_t>&);
+    uint32_t get_width() const;
+    uint32_t get_height() const;
+    uint32_t get_pixel_size() const;
+    const std::vector<uint8_t> &get_pixels() const;
+    std::vector<image> mip_chain(const unsigned = BOX, const bool = false, thread_pool *const = nullptr) const;
+    image resize(const uint32_t, const uint32_t, const unsigned = BOX, const bool = false, thread_pool *const = nullptr) const;
+};
+}
+
+#endif
@@ -0,0 +1,227 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lz.h"
+
+uint32_t min::lz::read32(const uint8_t *const p)
+{
+    uint32_t out;
+    std::memcpy(&out, p, sizeof(uint32_t));
+    return out;
+}
+
+uint32_t min::lz::hash(const uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - hash_bits);
+}
+
+void min::lz::write_length(std::vector<uint8_t> &out, size_t length)
+{
+    // Lengths over fifteen spill into a run of bytes, 255 means keep reading
+    while (length >= 255)
+    {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+size_t min::lz::read_length(const uint8_t *&in, const uint8_t *const end)
+{
+    size_t out = 0;
+    uint8_t b;
+    do
+    {
+        if (in == end)
+        {
+            throw std::runtime_error("lz: corrupt block, torn length");
+        }
+        b = *in++;
+        out += b;
+    } while (b == 255);
+
+    return out;
+}
+
+void min::lz::write_sequence(std::vector<uint8_t> &out, const uint8_t *const literals, const size_t size, const size_t offset, const size_t length)
+{
+    // Pack the literal and match lengths into the token
+    const size_t match = length - min_match;
+    const uint8_t lit_token = (size < 15) ? size : 15;
+    const uint8_t match_token = (match < 15) ? match : 15;
+    out.push_back((lit_token << 4) | match_token);
+
+    // Write the literals
+    if (size >= 15)
+    {
+        write_length(out, size - 15);
+    }
+    out.insert(out.end(), literals, literals + size);
+
+    // Write the match
+    out.push_back(offset & 0xFF);
+    out.push_back(offset >> 8);
+    if (match >= 15)
+    {
+        write_length(out, match - 15);
+    }
+}
+
+void min::lz::compress(const uint8_t *const in, const size_t size, std::vector<uint8_t> &out)
+{
+    // Start of the pending literals
+    size_t anchor = 0;
+
+    // Blocks too small for a match are all literals
+    if (size > match_limit)
+    {
+        // Last position seen for each hashed four byte sequence
+        std::vector<uint32_t> table(1 << hash_bits, 0);
+
+        // Greedy parse, taking the first match found at each position
+        const size_t limit = size - match_limit;
+        size_t i = 0;
+        while (i < limit)
+        {
+            const uint32_t sequence = read32(in + i);
+            uint32_t &slot = table[hash(sequence)];
+            const size_t ref = slot;
+            slot = static_cast<uint32_t>(i);
+
+            // Check the candidate really matches, the table only stores hashes
+            if (ref < i && i - ref <= max_offset && read32(in + ref) == sequence)
+            {
+                // Extend the match up to the trailing literals
+                const size_t max = size - last_literals - i;
+                size_t length = min_match;
+                while (length < max && in[ref + length] == in[i + length])
+                {
+                    length++;
+                }
+
+                // Emit the sequence and skip over the match
+                write_sequence(out, in + anchor, i - anchor, i - ref, length);
+                i += length;
+                anchor = i;
+            }
+            else
+            {
+                // Skip faster through data that does not compress
+                i += 1 + ((i - anchor) >> 6);
+            }
+        }
+    }
+
+    // Write the trailing literals
+    const size_t literals = size - anchor;
+    out.push_back(((literals < 15) ? literals : 15) << 4);
+    if (literals >= 15)
+    {
+        write_length(out, literals - 15);
+    }
+    out.insert(out.end(), in + anchor, in + size);
+}
+
+void min::lz::decompress(const uint8_t *const in, const size_t size, uint8_t *const out, const size_t out_size)
+{
+    const uint8_t *ip = in;
+    const uint8_t *const in_end = in + size;
+    uint8_t *op = out;
+    uint8_t *const out_end = out + out_size;
+
+    // Decode sequences until the input is consumed
+    while (ip != in_end)
+    {
+        const uint8_t token = *ip++;
+
+        // Copy the literals
+        size_t literals = token >> 4;
+        if (literals == 15)
+        {
+            literals += read_length(ip, in_end);
+        }
+        if (literals > static_cast<size_t>(in_end - ip) || literals > static_cast<size_t>(out_end - op))
+        {
+            throw std::runtime_error("lz: corrupt block, literals out of range");
+        }
+
+        // Short literals use a fixed size copy when there is room to spill over
+        if (literals <= 16 && in_end - ip >= 16 && out_end - op >= 16)
+        {
+            std::memcpy(op, ip, 16);
+        }
+        else if (literals > 0)
+        {
+            std::memcpy(op, ip, literals);
+        }
+        ip += literals;
+        op += literals;
+
+        // The last sequence has no match
+        if (ip == in_end)
+        {
+            break;
+        }
+
+        // Read the match offset
+        if (in_end - ip < 2)
+        {
+            throw std::runtime_error("lz: corrupt block, torn match offset");
+        }
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - out))
+        {
+            throw std::runtime_error("lz: corrupt block, match offset out of range");
+        }
+
+        // Read the match length
+        size_t length = token & 15;
+        if (length == 15)
+        {
+            length += read_length(ip, in_end);
+        }
+        length += min_match;
+        if (length > static_cast<size_t>(out_end - op))
+        {
+            throw std::runtime_error("lz: corrupt block, match out of range");
+        }
+
+        // Copy in eight byte steps if each step reads behind what it writes and there is room to spill over
+        // Overlapping matches closer than eight bytes repeat the pattern so copy byte by byte
+        const uint8_t *match = op - offset;
+        if (offset >= 8 && static_cast<size_t>(out_end - op) >= length + 8)
+        {
+            for (size_t i = 0; i < length; i += 8)
+            {
+                std::memcpy(op + i, match + i, 8);
+            }
+            op += length;
+        }
+        else
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    // Check we filled the output
+    if (op != out_end)
+    {
+        throw std::runtime_error("lz: corrupt block, wrong decompressed size");
+    }
+}
@@ -0,0 +1,58 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __LZ_COMPRESSION__
+#define __LZ_COMPRESSION__
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// Fast LZ77 block codec using the LZ4 block layout
+// Each sequence is a token, literal length, literals, 16 bit match offset and match length
+// Matches are at least four bytes and the last five bytes of a block are always literals
+
+namespace min
+{
+
+class lz
+{
+  private:
+    // Number of bits in the hash table index
+    static constexpr uint32_t hash_bits = 14;
+
+    // Shortest possible match
+    static constexpr size_t min_match = 4;
+
+    // The last five bytes are always literals, so the last match must start twelve bytes before the end
+    static constexpr size_t last_literals = 5;
+    static constexpr size_t match_limit = 12;
+
+    // Largest match offset
+    static constexpr size_t max_offset = 65535;
+
+    static inline uint32_t read32(const uint8_t *const);
+    static inline uint32_t hash(const uint32_t);
+    static inline void write_length(std::vector<uint8_t>&, size_t);
+    static inline size_t read_length(const uint8_t *&, const uint8_t *const);
+    static inline void write_sequence(std::vector<uint8_t>&, const uint8_t *const, const size_t, const size_t, const size_t);
+
+  public:
+    static void compress(const uint8_t *const, const size_t, std::vector<uint8_t>&);
+    static void decompress(const uint8_t *const, const size_t, uint8_t *const, const size_t);
+};
+
+}
+#endif
@@ -13,6 +13,10 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 #include "md5_anim.h"
+
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
 //// md5_node ////
 
 const std::string &min::md5_node::get_name() const
@@ -94,6 +98,12 @@ const std::vector<T> &min::md5_frame_data<T>::get_data() const
     return _data;
 }
 
+template <class T>
+unsigned min::md5_frame_data<T>::get_id() const
+{
+    return _id;
+}
+
 template <class T>
 void min::md5_frame_data<T>::reserve(size_t n)
 {
@@ -104,10 +114,21 @@ void min::md5_frame_data<T>::reserve(size_t n)
 //// md5_frame ////
 template class min::md5_frame<float>;
 template <class T>
-void min::md5_frame<T>::add_node(const min::md5_animated_node<T> &node, const min::mat4<T> &bone)
+void min::md5_frame<T>::add_node(const min::md5_animated_node<T> &node, const min::mat3x4<T> &bone)
 {
     _nodes.push_back(node);
     _bones.push_back(bone);
+
+    // Store the joint SoA
+    const vec3<T> &p = node.get_position();
+    const quat<T> &q = node.get_rotation();
+    _px.push_back(p.x);
+    _py.push_back(p.y);
+    _pz.push_back(p.z);
+    _qw.push_back(q.w());
+    _qx.push_back(q.x());
+    _qy.push_back(q.y());
+    _qz.push_back(q.z());
 }
 
 template <class T>
@@ -117,22 +138,226 @@ const min::md5_animated_node<T> &min::md5_frame<T>::get_node(const int parent_id
 }
 
 template <class T>
-const std::vector<min::mat4<T>> &min::md5_frame<T>::get_bones() const
+const std::vector<min::mat3x4<T>> &min::md5_frame<T>::get_bones() const
 {
     return _bones;
 }
 
+template <class T>
+void min::md5_frame<T>::nlerp(const min::md5_frame<T> &f, const T t, std::vector<min::mat3x4<T>> &out, const std::vector<size_t> &map) const
+{
+    // This is quat<T>::nlerp written over the joint SoA, one joint per iteration, the float SSE version does four at a time
+    const size_t size = _px.size();
+    for (size_t i = 0; i < size; i++)
+    {
+        // Skip joints pruned by the lod map, see md5_model::update_lod_map
+        if (map.size() > 0 && map[i] != i)
+        {
+            continue;
+        }
+
+        // lerp interpolation for position
+        const T px = _px[i] + (f._px[i] - _px[i]) * t;
+        const T py = _py[i] + (f._py[i] - _py[i]) * t;
+        const T pz = _pz[i] + (f._pz[i] - _pz[i]) * t;
+
+        // Corrected nlerp interpolation for rotation
+        const T cos_theta = _qw[i] * f._qw[i] + _qx[i] * f._qx[i] + _qy[i] * f._qy[i] + _qz[i] * f._qz[i];
+        const T d = std::abs(cos_theta);
+        const T A = 1.0904 + d * (-3.2452 + d * (3.55645 - d * 1.43519));
+        const T B = 0.848013 + d * (-1.06021 + d * 0.215638);
+        const T h = t - 0.5;
+        const T ct = t + t * h * (t - 1.0) * (A * h * h + B);
+        const T t0 = 1.0 - ct;
+        const T t1 = std::copysign(ct, cos_theta);
+        T w = _qw[i] * t0 + f._qw[i] * t1;
+        T x = _qx[i] * t0 + f._qx[i] * t1;
+        T y = _qy[i] * t0 + f._qy[i] * t1;
+        T z = _qz[i] * t0 + f._qz[i] * t1;
+        const T inv = 1.0 / std::sqrt(w * w + x * x + y * y + z * z);
+        w *= inv;
+        x *= inv;
+        y *= inv;
+        z *= inv;
+
+        // Same as mat3x4<T>(position, rotation)
+        const T xx = x * x;
+        const T yy = y * y;
+        const T zz = z * z;
+        const T xw = x * w;
+        const T yw = y * w;
+        const T zw = z * w;
+        const T xy = x * y;
+        const T xz = x * z;
+        const T yz = y * z;
+        out[i] = mat3x4<T>(
+            1.0 - 2.0 * (yy + zz), 2.0 * (xy - zw), 2.0 * (xz + yw), px,
+            2.0 * (xy + zw), 1.0 - 2.0 * (xx + zz), 2.0 * (yz - xw), py,
+            2.0 * (xz - yw), 2.0 * (yz + xw), 1.0 - 2.0 * (xx + yy), pz);
+    }
+}
+
 template <class T>
 void min::md5_frame<T>::reserve(size_t n)
 {
     _bones.reserve(n);
     _nodes.reserve(n);
+    _px.reserve(n);
+    _py.reserve(n);
+    _pz.reserve(n);
+    _qw.reserve(n);
+    _qx.reserve(n);
+    _qy.reserve(n);
+    _qz.reserve(n);
 }
 
 
 
 //// md5_anim ////
 template class min::md5_anim<float>;
+template <typename T>
+bool min::md5_anim<T>::is_baked(const mem_file &mem)
+{
+    // Text md5 files start with 'MD5Version' so they never match the magic number
+    if (mem.size() < sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    size_t next = 0;
+    return read_le<uint32_t>(mem, next) == MAGIC;
+}
+
+template <typename T>
+void min::md5_anim<T>::deserialize(const mem_file &stream)
+{
+    size_t next = 0;
+
+    // Throw if fewer than n bytes are left, read_le does not check the stream size
+    const size_t size = stream.size();
+    const auto check = [&next, size](const size_t n) {
+        if (next > size || n > size - next)
+        {
+            throw std::runtime_error("md5_anim: baked file is truncated");
+        }
+    };
+
+    // Check the header
+    check(16);
+    const uint32_t magic = read_le<uint32_t>(stream, next);
+    const uint32_t version = read_le<uint32_t>(stream, next);
+    if (magic != MAGIC || version != VERSION)
+    {
+        throw std::runtime_error("md5_anim: unsupported baked file version '" + std::to_string(version) + "'");
+    }
+
+    // Read in the frame rate
+    _frame_rate = read_le<uint32_t>(stream, next);
+
+    // Read in the hierarchy, each name has at least a size
+    const uint32_t nodes = read_le<uint32_t>(stream, next);
+    check(static_cast<size_t>(nodes) * 4);
+    std::vector<std::string> names;
+    names.reserve(nodes);
+    for (uint32_t i = 0; i < nodes; i++)
+    {
+        check(4);
+        names.push_back(read_le_string(stream, next));
+    }
+    const std::vector<int> parent = read_le_vector<int>(stream, next);
+    const std::vector<int> flag = read_le_vector<int>(stream, next);
+    const std::vector<unsigned> start = read_le_vector<unsigned>(stream, next);
+    if (parent.size() != nodes || flag.size() != nodes || start.size() != nodes)
+    {
+        throw std::runtime_error("md5_anim: baked node count mismatch");
+    }
+
+    _nodes.reserve(nodes);
+    for (uint32_t i = 0; i < nodes; i++)
+    {
+        if (parent[i] >= (int)nodes)
+        {
+            throw std::runtime_error("md5_anim: parent overflow '" + std::to_string(parent[i]) + " is greater than '" + std::to_string(nodes) + "'");
+        }
+        _nodes.emplace_back(names[i], parent[i], flag[i], start[i]);
+    }
+
+    // Read in the bounds
+    const std::vector<vec3<T>> box_min = read_le_vector_vec3<T>(stream, next);
+    const std::vector<vec3<T>> box_max = read_le_vector_vec3<T>(stream, next);
+    if (box_min.size() != box_max.size())
+    {
+        throw std::runtime_error("md5_anim: baked bounds mismatch");
+    }
+
+    const size_t bounds = box_min.size();
+    _bounds.reserve(bounds);
+    for (size_t i = 0; i < bounds; i++)
+    {
+        _bounds.emplace_back(box_min[i], box_max[i]);
+    }
+
+    // Read in the base frame
+    const std::vector<vec3<T>> position = read_le_vector_vec3<T>(stream, next);
+    const std::vector<vec4<T>> rotation = read_le_vector_vec4<T>(stream, next);
+    if (position.size() != nodes || rotation.size() != nodes)
+    {
+        throw std::runtime_error("md5_anim: node-transform mismatch");
+    }
+
+    _transforms.reserve(nodes);
+    for (uint32_t i = 0; i < nodes; i++)
+    {
+        const vec4<T> &r = rotation[i];
+        _transforms.emplace_back(position[i], quat<T>(r.w(), r.x(), r.y(), r.z()));
+    }
+
+    // Read in the raw frame data, each frame has at least an id and a size
+    check(4);
+    const uint32_t frames = read_le<uint32_t>(stream, next);
+    check(static_cast<size_t>(frames) * 8);
+    _frame_data.reserve(frames);
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        check(4);
+        const uint32_t id = read_le<uint32_t>(stream, next);
+        const std::vector<T> data = read_le_vector<T>(stream, next);
+
+        _frame_data.emplace_back(id);
+        md5_frame_data<T> &frame_data = _frame_data.back();
+        frame_data.reserve(data.size());
+        for (const T d : data)
+        {
+            frame_data.add(d);
+        }
+    }
+
+    // Read in the precomputed frames, each stores the joint positions and rotations in the model space
+    check(4);
+    const uint32_t count = read_le<uint32_t>(stream, next);
+    check(static_cast<size_t>(count) * 4);
+    _frames.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const std::vector<T> data = read_le_vector<T>(stream, next);
+        if (data.size() != nodes * 7)
+        {
+            throw std::runtime_error("md5_anim: baked frame size mismatch");
+        }
+
+        // Rebuild the frame nodes and the bone matrices
+        md5_frame<T> &frame = _frames[i];
+        frame.reserve(nodes);
+        for (uint32_t j = 0; j < nodes; j++)
+        {
+            const T *const d = &data[j * 7];
+            const vec3<T> p(d[0], d[1], d[2]);
+            const quat<T> q(d[3], d[4], d[5], d[6]);
+            frame.add_node(md5_animated_node<T>(md5_transform<T>(p, q), parent[j]), mat3x4<T>(p, q));
+        }
+    }
+}
+
 template <typename T>
 void min::md5_anim<T>::load_file(const std::string _file)
 {
@@ -154,8 +379,16 @@ void min::md5_anim<T>::load_file(const std::string _file)
         // Close the file
         file.close();
 
-        // Process the DDS file
-        load(data);
+        // Process the baked or text file
+        const mem_file mem(reinterpret_cast<uint8_t *>(&data[0]), 0, data.size());
+        if (is_baked(mem))
+        {
+            deserialize(mem);
+        }
+        else
+        {
+            load(data);
+        }
     }
     else
     {
@@ -276,11 +509,24 @@ void min::md5_anim<T>::load(const std::string &data)
 }
 
 template <typename T>
-void min::md5_anim<T>::interpolate_current_frame(const min::md5_frame<T> &frame0, const min::md5_frame<T> &frame1, T ratio) const
+void min::md5_anim<T>::interpolate_frame(const min::md5_frame<T> &frame0, const min::md5_frame<T> &frame1, T ratio, std::vector<min::mat3x4<T>> &out, const std::vector<size_t> &map) const
 {
+    // Fast path interpolates all joints at once
+    if (_nlerp)
+    {
+        frame0.nlerp(frame1, ratio, out, map);
+        return;
+    }
+
     const size_t size = _nodes.size();
     for (size_t i = 0; i < size; i++)
     {
+        // Skip joints pruned by the lod map
+        if (map.size() > 0 && map[i] != i)
+        {
+            continue;
+        }
+
         // lerp interpolation for position
         const vec3<T> &from_position = frame0.get_node(i).get_position();
         const vec3<T> &to_position = frame1.get_node(i).get_position();
@@ -292,7 +538,7 @@ void min::md5_anim<T>::interpolate_current_frame(const min::md5_frame<T> &frame0
         const quat<T> rotation = quat<T>::slerp(from_rotation, to_rotation, ratio);
 
         // Set the interpolate position and rotation
-        _current_frame[i] = mat4<T>(position, rotation);
+        out[i] = mat3x4<T>(position, rotation);
     }
 }
 
@@ -572,7 +818,7 @@ void min::md5_anim<T>::process_frame(const min::md5_frame_data<T> &frame_data)
         }
 
         // Create matrix bone for this node
-        const mat4<T> bone(position, rotation);
+        const mat3x4<T> bone(position, rotation);
 
         // Add this node to the frame
         frame.add_node(child, bone);
@@ -583,7 +829,7 @@ void min::md5_anim<T>::process_frame(const min::md5_frame_data<T> &frame_data)
 }
 
 template <typename T>
-min::md5_anim<T>::md5_anim(const std::string &file) : _frame_rate(0), _loops(0), _time(0.0)
+min::md5_anim<T>::md5_anim(const std::string &file) : _frame_rate(0), _loops(0), _time(0.0), _nlerp(false)
 {
     load_file(file);
 
@@ -600,9 +846,16 @@ min::md5_anim<T>::md5_anim(const std::string &file) : _frame_rate(0), _loops(0),
 }
 
 template <typename T>
-min::md5_anim<T>::md5_anim(const min::mem_file &mem) : _frame_rate(0), _loops(0), _time(0.0)
+min::md5_anim<T>::md5_anim(const min::mem_file &mem) : _frame_rate(0), _loops(0), _time(0.0), _nlerp(false)
 {
-    load(mem.to_string());
+    if (is_baked(mem))
+    {
+        deserialize(mem);
+    }
+    else
+    {
+        load(mem.to_string());
+    }
 
     // Set the length of the animation
     _animation_length = static_cast<T>(_frames.size()) / _frame_rate;
@@ -616,6 +869,35 @@ min::md5_anim<T>::md5_anim(const min::mem_file &mem) : _frame_rate(0), _loops(0)
     _current_frame = _frames[0].get_bones();
 }
 
+template <typename T>
+void min::md5_anim<T>::evaluate(const T time, std::vector<min::mat3x4<T>> &out) const
+{
+    // Evaluate every joint
+    evaluate(time, out, std::vector<size_t>());
+}
+
+template <typename T>
+void min::md5_anim<T>::evaluate(const T time, std::vector<min::mat3x4<T>> &out, const std::vector<size_t> &map) const
+{
+    // Evaluates the pose at time without changing the animation state, joints with map[i] != i are left untouched
+    out.resize(_nodes.size());
+
+    // Calculate the two frames to interpolate between
+    const T frame_time = time * _frame_rate;
+    const unsigned frame_low = std::floor(frame_time);
+    const unsigned frame_high = frame_low + 1;
+
+    // Calculate position between the two frames for interpolation
+    const T ratio = frame_time - frame_low;
+
+    const size_t frames = _frames.size();
+    const unsigned frame0 = frame_low % frames;
+    const unsigned frame1 = frame_high % frames;
+
+    // Interpolate between the two frames
+    interpolate_frame(_frames[frame0], _frames[frame1], ratio, out, map);
+}
+
 template <typename T>
 const std::vector<min::aabbox<T, min::vec3>> &min::md5_anim<T>::get_bounds() const
 {
@@ -623,7 +905,7 @@ const std::vector<min::aabbox<T, min::vec3>> &min::md5_anim<T>::get_bounds() con
 }
 
 template <typename T>
-const std::vector<min::mat4<T>> &min::md5_anim<T>::get_current_frame() const
+const std::vector<min::mat3x4<T>> &min::md5_anim<T>::get_current_frame() const
 {
     return _current_frame;
 }
@@ -658,12 +940,113 @@ const std::vector<min::md5_transform<T>> &min::md5_anim<T>::get_transforms() con
     return _transforms;
 }
 
+template <typename T>
+T min::md5_anim<T>::get_length() const
+{
+    return _animation_length;
+}
+
 template <typename T>
 unsigned min::md5_anim<T>::get_loop_count() const
 {
     return _loops;
 }
 
+template <typename T>
+bool min::md5_anim<T>::get_nlerp() const
+{
+    return _nlerp;
+}
+
+template <typename T>
+void min::md5_anim<T>::serialize(std::vector<uint8_t> &stream) const
+{
+    // Write out the header
+    write_le<uint32_t>(stream, MAGIC);
+    write_le<uint32_t>(stream, VERSION);
+
+    // Write out the frame rate
+    write_le<uint32_t>(stream, _frame_rate);
+
+    // Write out the hierarchy
+    const size_t nodes = _nodes.size();
+    std::vector<int> parent;
+    std::vector<int> flag;
+    std::vector<unsigned> start;
+    parent.reserve(nodes);
+    flag.reserve(nodes);
+    start.reserve(nodes);
+
+    write_le<uint32_t>(stream, nodes);
+    for (const auto &n : _nodes)
+    {
+        write_le_string(stream, n.get_name());
+        parent.push_back(n.get_parent());
+        flag.push_back(n.get_flag());
+        start.push_back(n.get_start());
+    }
+    write_le_vector<int>(stream, parent);
+    write_le_vector<int>(stream, flag);
+    write_le_vector<unsigned>(stream, start);
+
+    // Write out the bounds
+    std::vector<vec3<T>> box_min;
+    std::vector<vec3<T>> box_max;
+    box_min.reserve(_bounds.size());
+    box_max.reserve(_bounds.size());
+    for (const auto &b : _bounds)
+    {
+        box_min.push_back(b.get_min());
+        box_max.push_back(b.get_max());
+    }
+    write_le_vector_vec3<T>(stream, box_min);
+    write_le_vector_vec3<T>(stream, box_max);
+
+    // Write out the base frame
+    std::vector<vec3<T>> position;
+    std::vector<vec4<T>> rotation;
+    position.reserve(_transforms.size());
+    rotation.reserve(_transforms.size());
+    for (const auto &t : _transforms)
+    {
+        const quat<T> &r = t.get_rotation();
+        position.push_back(t.get_position());
+        rotation.emplace_back(r.x(), r.y(), r.z(), r.w());
+    }
+    write_le_vector_vec3<T>(stream, position);
+    write_le_vector_vec4<T>(stream, rotation);
+
+    // Write out the raw frame data
+    write_le<uint32_t>(stream, _frame_data.size());
+    for (const auto &fd : _frame_data)
+    {
+        write_le<uint32_t>(stream, fd.get_id());
+        write_le_vector<T>(stream, fd.get_data());
+    }
+
+    // Write out the precomputed frames
+    std::vector<T> data(nodes * 7);
+    write_le<uint32_t>(stream, _frames.size());
+    for (const auto &f : _frames)
+    {
+        for (size_t i = 0; i < nodes; i++)
+        {
+            const md5_animated_node<T> &n = f.get_node(i);
+            const vec3<T> &p = n.get_position();
+            const quat<T> &q = n.get_rotation();
+            T *const d = &data[i * 7];
+            d[0] = p.x;
+            d[1] = p.y;
+            d[2] = p.z;
+            d[3] = q.w();
+            d[4] = q.x();
+            d[5] = q.y();
+            d[6] = q.z();
+        }
+        write_le_vector<T>(stream, data);
+    }
+}
+
 template <typename T>
 void min::md5_anim<T>::set_loop_count(const unsigned count) const
 {
@@ -671,6 +1054,13 @@ void min::md5_anim<T>::set_loop_count(const unsigned count) const
     _loops = count;
 }
 
+template <typename T>
+void min::md5_anim<T>::set_nlerp(const bool nlerp) const
+{
+    // Switch between slerp and the faster corrected nlerp
+    _nlerp = nlerp;
+}
+
 template <typename T>
 void min::md5_anim<T>::set_time(const T time) const
 {
@@ -680,6 +1070,13 @@ void min::md5_anim<T>::set_time(const T time) const
 
 template <typename T>
 void min::md5_anim<T>::step(const T step) const
+{
+    // Step every joint
+    this->step(step, std::vector<size_t>());
+}
+
+template <typename T>
+void min::md5_anim<T>::step(const T step, const std::vector<size_t> &map) const
 {
     // Accumulate the time
     _time += step;
@@ -700,18 +1097,149 @@ void min::md5_anim<T>::step(const T step) const
         return;
     }
 
-    // Calculate the two frames to interpolate between
-    const T frame_time = _time * _frame_rate;
-    const unsigned frame_low = std::floor(frame_time);
-    const unsigned frame_high = frame_low + 1;
+    // Interpolate the current frame
+    evaluate(_time, _current_frame, map);
+}
 
-    // Calculate position between the two frames for interpolation
-    const T ratio = frame_time - frame_low;
+template <typename T>
+void min::md5_anim<T>::to_file(const std::string &file_name) const
+{
+    std::vector<uint8_t> stream;
 
-    const size_t frames = _frames.size();
-    const unsigned frame0 = frame_low % frames;
-    const unsigned frame1 = frame_high % frames;
+    // Serialize this object into bytes
+    serialize(stream);
 
-    // Interpolate between the two frames
-    interpolate_current_frame(_frames[frame0], _frames[frame1], ratio);
+    // Save bytes to file
+    std::ofstream file(file_name, std::ios::out | std::ios::binary);
+    if (file.is_open())
+    {
+        file.write(reinterpret_cast<char *>(&stream[0]), stream.size());
+        file.close();
+    }
+    else
+    {
+        throw std::runtime_error("md5_anim: could not open file '" + file_name + "'");
+    }
+}
+
+#ifdef MGL_SIMD_SSE
+// The float kernel writes mat3x4 as packed rows of floats
+static_assert(sizeof(min::mat3x4<float>) == 12 * sizeof(float), "mat3x4<float> must be packed");
+
+template <>
+void min::md5_frame<float>::nlerp(const min::md5_frame<float> &f, const float t, std::vector<min::mat3x4<float>> &out, const std::vector<size_t> &map) const
+{
+    const size_t size = _px.size();
+    const size_t end = size - (size % 4);
+
+    // Constants, each lane is one joint
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 vt = _mm_set1_ps(t);
+
+    // The correction terms that only depend on t
+    const float h = t - 0.5f;
+    const __m128 hh = _mm_set1_ps(h * h);
+    const __m128 th = _mm_set1_ps(t * h * (t - 1.0f));
+
+    // Polynomial in d, c0 + d * (c1 + d * (c2 + d * c3))
+    const auto poly = [](const __m128 d, const float c0, const float c1, const float c2, const float c3) {
+        __m128 out = _mm_add_ps(_mm_set1_ps(c2), _mm_mul_ps(d, _mm_set1_ps(c3)));
+        out = _mm_add_ps(_mm_set1_ps(c1), _mm_mul_ps(d, out));
+        return _mm_add_ps(_mm_set1_ps(c0), _mm_mul_ps(d, out));
+    };
+
+    // Lerp between this frame and f
+    const auto lerp = [&vt](const float *a, const float *b) {
+        const __m128 va = _mm_loadu_ps(a);
+        return _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b), va), vt));
+    };
+
+    // Only skip a group of four when the lod map prunes all of them
+    const bool prune = map.size() > 0;
+    for (size_t i = 0; i < end; i += 4)
+    {
+        if (prune && map[i] != i && map[i + 1] != i + 1 && map[i + 2] != i + 2 && map[i + 3] != i + 3)
+        {
+            continue;
+        }
+
+        // lerp interpolation for position
+        const __m128 px = lerp(&_px[i], &f._px[i]);
+        const __m128 py = lerp(&_py[i], &f._py[i]);
+        const __m128 pz = lerp(&_pz[i], &f._pz[i]);
+
+        // Corrected nlerp interpolation for rotation
+        const __m128 w0 = _mm_loadu_ps(&_qw[i]);
+        const __m128 x0 = _mm_loadu_ps(&_qx[i]);
+        const __m128 y0 = _mm_loadu_ps(&_qy[i]);
+        const __m128 z0 = _mm_loadu_ps(&_qz[i]);
+        const __m128 w1 = _mm_loadu_ps(&f._qw[i]);
+        const __m128 x1 = _mm_loadu_ps(&f._qx[i]);
+        const __m128 y1 = _mm_loadu_ps(&f._qy[i]);
+        const __m128 z1 = _mm_loadu_ps(&f._qz[i]);
+        const __m128 cos_theta = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, w1), _mm_mul_ps(x0, x1)), _mm_add_ps(_mm_mul_ps(y0, y1), _mm_mul_ps(z0, z1)));
+        const __m128 d = _mm_andnot_ps(sign, cos_theta);
+        const __m128 A = poly(d, 1.0904f, -3.2452f, 3.55645f, -1.43519f);
+        const __m128 B = poly(d, 0.848013f, -1.06021f, 0.215638f, 0.0f);
+        const __m128 ct = _mm_add_ps(vt, _mm_mul_ps(th, _mm_add_ps(_mm_mul_ps(A, hh), B)));
+        const __m128 t0 = _mm_sub_ps(one, ct);
+        const __m128 t1 = _mm_xor_ps(ct, _mm_and_ps(sign, cos_theta));
+        __m128 w = _mm_add_ps(_mm_mul_ps(w0, t0), _mm_mul_ps(w1, t1));
+        __m128 x = _mm_add_ps(_mm_mul_ps(x0, t0), _mm_mul_ps(x1, t1));
+        __m128 y = _mm_add_ps(_mm_mul_ps(y0, t0), _mm_mul_ps(y1, t1));
+        __m128 z = _mm_add_ps(_mm_mul_ps(z0, t0), _mm_mul_ps(z1, t1));
+        const __m128 mag = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)), _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z)));
+        const __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(mag));
+        w = _mm_mul_ps(w, inv);
+        x = _mm_mul_ps(x, inv);
+        y = _mm_mul_ps(y, inv);
+        z = _mm_mul_ps(z, inv);
+
+        // Same as mat3x4<T>(position, rotation)
+        const __m128 x2 = _mm_mul_ps(two, x);
+        const __m128 y2 = _mm_mul_ps(two, y);
+        const __m128 z2 = _mm_mul_ps(two, z);
+        const __m128 xx = _mm_mul_ps(x, x2);
+        const __m128 yy = _mm_mul_ps(y, y2);
+        const __m128 zz = _mm_mul_ps(z, z2);
+        const __m128 xw = _mm_mul_ps(w, x2);
+        const __m128 yw = _mm_mul_ps(w, y2);
+        const __m128 zw = _mm_mul_ps(w, z2);
+        const __m128 xy = _mm_mul_ps(x, y2);
+        const __m128 xz = _mm_mul_ps(x, z2);
+        const __m128 yz = _mm_mul_ps(y, z2);
+        __m128 r0[4] = {_mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_sub_ps(xy, zw), _mm_add_ps(xz, yw), px};
+        __m128 r1[4] = {_mm_add_ps(xy, zw), _mm_sub_ps(one, _mm_add_ps(xx, zz)), _mm_sub_ps(yz, xw), py};
+        __m128 r2[4] = {_mm_sub_ps(xz, yw), _mm_add_ps(yz, xw), _mm_sub_ps(one, _mm_add_ps(xx, yy)), pz};
+
+        // Transpose from one component per register to one row per register
+        _MM_TRANSPOSE4_PS(r0[0], r0[1], r0[2], r0[3]);
+        _MM_TRANSPOSE4_PS(r1[0], r1[1], r1[2], r1[3]);
+        _MM_TRANSPOSE4_PS(r2[0], r2[1], r2[2], r2[3]);
+        for (size_t j = 0; j < 4; j++)
+        {
+            float *const m = reinterpret_cast<float *>(&out[i + j]);
+            _mm_storeu_ps(m, r0[j]);
+            _mm_storeu_ps(m + 4, r1[j]);
+            _mm_storeu_ps(m + 8, r2[j]);
+        }
+    }
+
+    // Interpolate the remaining joints
+    for (size_t i = end; i < size; i++)
+    {
+        if (prune && map[i] != i)
+        {
+            continue;
+        }
+
+        const vec3<float> p0(_px[i], _py[i], _pz[i]);
+        const vec3<float> p1(f._px[i], f._py[i], f._pz[i]);
+        const quat<float> q0(_qw[i], _qx[i], _qy[i], _qz[i]);
+        const quat<float> q1(f._qw[i], f._qx[i], f._qy[i], f._qz[i]);
+        out[i] = mat3x4<float>(vec3<float>::lerp(p0, p1, t), quat<float>::nlerp(q0, q1, t));
+    }
 }
+#endif
@@ -23,7 +23,7 @@ limitations under the License.
 #include <vector>
 
 #include "geom/min/aabbox.h"
-#include "math/min/mat4.h"
+#include "math/min/mat3x4.h"
 #include "mem_chunk.h"
 #include "math/min/quat.h"
 #include "strtoken.h"
@@ -94,6 +94,7 @@ class md5_frame_data
     md5_frame_data(unsigned id) : _id(id) {}
     void add(const T);
     const std::vector<T> &get_data() const;
+    unsigned get_id() const;
     void reserve(size_t);
 };
 
@@ -101,13 +102,23 @@ template <class T>
 class md5_frame
 {
   private:
-    std::vector<mat4<T>> _bones;
+    std::vector<mat3x4<T>> _bones;
     std::vector<md5_animated_node<T>> _nodes;
 
+    // Joint positions and rotations stored SoA for interpolation across joints
+    std::vector<T> _px;
+    std::vector<T> _py;
+    std::vector<T> _pz;
+    std::vector<T> _qw;
+    std::vector<T> _qx;
+    std::vector<T> _qy;
+    std::vector<T> _qz;
+
   public:
-    void add_node(const md5_animated_node<T>&, const mat4<T>&);
+    void add_node(const md5_animated_node<T>&, const mat3x4<T>&);
     const md5_animated_node<T> &get_node(const int) const;
-    const std::vector<mat4<T>> &get_bones() const;
+    const std::vector<mat3x4<T>> &get_bones() const;
+    void nlerp(const md5_frame<T>&, const T, std::vector<mat3x4<T>>&, const std::vector<size_t>&) const;
     void reserve(size_t);
 
 };
@@ -124,12 +135,19 @@ class md5_anim
     unsigned _frame_rate;
     T _animation_length;
     mutable unsigned _loops;
-    mutable std::vector<mat4<T>> _current_frame;
+    mutable std::vector<mat3x4<T>> _current_frame;
     mutable T _time;
+    mutable bool _nlerp;
+
+    // Header of the baked binary format, 'MGLA'
+    static constexpr uint32_t MAGIC = 0x414C474D;
+    static constexpr uint32_t VERSION = 1;
 
+    static bool is_baked(const mem_file&);
+    void deserialize(const mem_file&);
     void load_file(const std::string);
     void load(const std::string&);
-    void interpolate_current_frame(const md5_frame<T>&, const md5_frame<T>&, T) const;
+    void interpolate_frame(const md5_frame<T>&, const md5_frame<T>&, T, std::vector<mat3x4<T>>&, const std::vector<size_t>&) const;
     void process_hierarchy(const std::vector<std::string>&);
     void process_bounds(const std::vector<std::string>&);
     void process_baseframe(const std::vector<std::string>&);
@@ -140,18 +158,31 @@ class md5_anim
     md5_anim(const std::string&);
     md5_anim(const mem_file&);
 
+    void evaluate(const T, std::vector<mat3x4<T>>&) const;
+    void evaluate(const T, std::vector<mat3x4<T>>&, const std::vector<size_t>&) const;
     const std::vector<aabbox<T, vec3>> &get_bounds() const;
-    const std::vector<mat4<T>> &get_current_frame() const;
+    const std::vector<mat3x4<T>> &get_current_frame() const;
     unsigned get_frame_rate() const;
     const std::vector<md5_frame_data<T>> &get_frame_data() const;
     const std::vector<md5_frame<T>> &get_frames() const;
     const std::vector<md5_node> &get_nodes() const;
     const std::vector<md5_transform<T>> &get_transforms()const;
+    T get_length() const;
     unsigned get_loop_count() const;
+    bool get_nlerp() const;
+    void serialize(std::vector<uint8_t>&) const;
     void set_loop_count(const unsigned) const;
+    void set_nlerp(const bool) const;
     void set_time(const T) const;
     void step(const T) const;
+    void step(const T, const std::vector<size_t>&) const;
+    void to_file(const std::string&) const;
 };
+
+#ifdef MGL_SIMD_SSE
+template <>
+void md5_frame<float>::nlerp(const md5_frame<float>&, const float, std::vector<mat3x4<float>>&, const std::vector<size_t>&) const;
+#endif
 }
 
 #endif
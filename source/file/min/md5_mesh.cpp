@@ -23,6 +23,11 @@ template<class T> int min::md5_joint<T>::get_id() const
     return _id;
 }
 
+template<class T> const std::string &min::md5_joint<T>::get_name() const
+{
+    return _name;
+}
+
 template<class T> const min::vec3<T> &min::md5_joint<T>::get_position() const
 {
     return _position;
@@ -75,6 +80,76 @@ unsigned min::vertex_weight::get_count() const
 
 //// md5_mesh ////
 template class min::md5_mesh<float, unsigned short>;
+template<typename T, typename K>
+bool min::md5_mesh<T,K>::is_baked(const mem_file &mem)
+{
+    // Text md5 files start with 'MD5Version' so they never match the magic number
+    if (mem.size() < sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    size_t next = 0;
+    return read_le<uint32_t>(mem, next) == MAGIC;
+}
+
+template<typename T, typename K>
+void min::md5_mesh<T,K>::deserialize(const mem_file &stream)
+{
+    size_t next = 0;
+
+    // Check the header
+    const uint32_t magic = read_le<uint32_t>(stream, next);
+    const uint32_t version = read_le<uint32_t>(stream, next);
+    if (magic != MAGIC || version != VERSION)
+    {
+        throw std::runtime_error("md5_mesh: unsupported baked file version '" + std::to_string(version) + "'");
+    }
+
+    // Read in joint names
+    const uint32_t joints = read_le<uint32_t>(stream, next);
+    std::vector<std::string> names;
+    names.reserve(joints);
+    for (uint32_t i = 0; i < joints; i++)
+    {
+        names.push_back(read_le_string(stream, next));
+    }
+
+    // Read in joint ids, positions and rotations
+    const std::vector<int> id = read_le_vector<int>(stream, next);
+    const std::vector<vec3<T>> position = read_le_vector_vec3<T>(stream, next);
+    const std::vector<vec4<T>> rotation = read_le_vector_vec4<T>(stream, next);
+    if (id.size() != joints || position.size() != joints || rotation.size() != joints)
+    {
+        throw std::runtime_error("md5_mesh: baked joint count mismatch");
+    }
+
+    // Create the joints
+    _joints.reserve(joints);
+    for (uint32_t i = 0; i < joints; i++)
+    {
+        const vec4<T> &r = rotation[i];
+        _joints.emplace_back(names[i], id[i], position[i], quat<T>(r.w(), r.x(), r.y(), r.z()));
+    }
+
+    // Read in the bind pose meshes
+    const uint32_t meshes = read_le<uint32_t>(stream, next);
+    _mesh.reserve(meshes);
+    for (uint32_t i = 0; i < meshes; i++)
+    {
+        _mesh.emplace_back(read_le_string(stream, next));
+        mesh<T, K> &m = _mesh.back();
+        m.vertex = read_le_vector_vec4<T>(stream, next);
+        m.uv = read_le_vector_vec2<T>(stream, next);
+        m.normal = read_le_vector_vec3<T>(stream, next);
+        m.tangent = read_le_vector_vec3<T>(stream, next);
+        m.bitangent = read_le_vector_vec3<T>(stream, next);
+        m.index = read_le_vector<K>(stream, next);
+        m.bone_index = read_le_vector_vec4<T>(stream, next);
+        m.bone_weight = read_le_vector_vec4<T>(stream, next);
+    }
+}
+
 template<typename T, typename K>
 void min::md5_mesh<T,K>::load_file(const std::string _file)
 {
@@ -96,8 +171,16 @@ void min::md5_mesh<T,K>::load_file(const std::string _file)
         // Close the file
         file.close();
 
-        // Process the DDS file
-        load(data);
+        // Process the baked or text file
+        const mem_file mem(reinterpret_cast<uint8_t *>(&data[0]), 0, data.size());
+        if (is_baked(mem))
+        {
+            deserialize(mem);
+        }
+        else
+        {
+            load(data);
+        }
     }
     else
     {
@@ -582,7 +665,14 @@ min::md5_mesh<T,K>::md5_mesh(const std::string &file)
 template<typename T, typename K>
 min::md5_mesh<T,K>::md5_mesh(const mem_file &mem)
 {
-    load(mem.to_string());
+    if (is_baked(mem))
+    {
+        deserialize(mem);
+    }
+    else
+    {
+        load(mem.to_string());
+    }
 }
 
 template<typename T, typename K>
@@ -602,3 +692,73 @@ std::vector<min::mesh<T, K>> &min::md5_mesh<T,K>::get_meshes()
 {
     return _mesh;
 }
+
+template<typename T, typename K>
+void min::md5_mesh<T,K>::serialize(std::vector<uint8_t> &stream) const
+{
+    // Write out the header
+    write_le<uint32_t>(stream, MAGIC);
+    write_le<uint32_t>(stream, VERSION);
+
+    // Split the joints into arrays
+    const size_t joints = _joints.size();
+    std::vector<int> id;
+    std::vector<vec3<T>> position;
+    std::vector<vec4<T>> rotation;
+    id.reserve(joints);
+    position.reserve(joints);
+    rotation.reserve(joints);
+
+    // Write out joint names
+    write_le<uint32_t>(stream, joints);
+    for (const auto &j : _joints)
+    {
+        write_le_string(stream, j.get_name());
+
+        const quat<T> &r = j.get_rotation();
+        id.push_back(j.get_id());
+        position.push_back(j.get_position());
+        rotation.emplace_back(r.x(), r.y(), r.z(), r.w());
+    }
+
+    // Write out joint ids, positions and rotations
+    write_le_vector<int>(stream, id);
+    write_le_vector_vec3<T>(stream, position);
+    write_le_vector_vec4<T>(stream, rotation);
+
+    // Write out the bind pose meshes
+    write_le<uint32_t>(stream, _mesh.size());
+    for (const auto &m : _mesh)
+    {
+        write_le_string(stream, m.get_name());
+        write_le_vector_vec4<T>(stream, m.vertex);
+        write_le_vector_vec2<T>(stream, m.uv);
+        write_le_vector_vec3<T>(stream, m.normal);
+        write_le_vector_vec3<T>(stream, m.tangent);
+        write_le_vector_vec3<T>(stream, m.bitangent);
+        write_le_vector<K>(stream, m.index);
+        write_le_vector_vec4<T>(stream, m.bone_index);
+        write_le_vector_vec4<T>(stream, m.bone_weight);
+    }
+}
+
+template<typename T, typename K>
+void min::md5_mesh<T,K>::to_file(const std::string &file_name) const
+{
+    std::vector<uint8_t> stream;
+
+    // Serialize this object into bytes
+    serialize(stream);
+
+    // Save bytes to file
+    std::ofstream file(file_name, std::ios::out | std::ios::binary);
+    if (file.is_open())
+    {
+        file.write(reinterpret_cast<char *>(&stream[0]), stream.size());
+        file.close();
+    }
+    else
+    {
+        throw std::runtime_error("md5_mesh: could not open file '" + file_name + "'");
+    }
+}
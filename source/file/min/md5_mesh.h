@@ -48,6 +48,7 @@ class md5_joint
   public:
     md5_joint(const std::string&, const int, const vec3<T>&, const quat<T>&);
     int get_id() const;
+    const std::string &get_name() const;
     const vec3<T> &get_position() const;
     const quat<T> &get_rotation() const;
 
@@ -89,6 +90,12 @@ class md5_mesh
     std::vector<weight<T>> _weights;
     std::vector<vertex_weight> _vertex_weights;
 
+    // Header of the baked binary format, 'MGLM'
+    static constexpr uint32_t MAGIC = 0x4D4C474D;
+    static constexpr uint32_t VERSION = 1;
+
+    static bool is_baked(const mem_file&);
+    void deserialize(const mem_file&);
     void load_file(const std::string);
     void load(const std::string&);
     void process_joints(const std::vector<std::string>&);
@@ -103,6 +110,8 @@ class md5_mesh
     const std::vector<md5_joint<T>> &get_joints() const;
     const std::vector<mesh<T,K>> &get_meshes() const;
     std::vector<mesh<T, K>> &get_meshes();
+    void serialize(std::vector<uint8_t>&) const;
+    void to_file(const std::string&) const;
 };
 }
 
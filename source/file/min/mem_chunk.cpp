@@ -14,6 +14,19 @@ limitations under the License.
 */
 
 #include "mem_chunk.h"
+#include <cstdio>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 min::mem_file min::mem_chunk::push_back_file(const std::string &file_name)
 {
@@ -45,6 +58,256 @@ min::mem_file min::mem_chunk::push_back_file(const std::string &file_name)
     }
 }
 
+min::mem_file &min::mem_chunk::find_file(const std::string &key) const
+{
+    // Lookups may decompress files so guard them for loading on many threads
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // Lookup key in the map
+    const auto i = _files.find(key);
+    if (i != _files.end())
+    {
+        return i->second;
+    }
+
+    // Lookup key in the compressed files
+    const auto p = _packed.find(key);
+    if (p == _packed.end())
+    {
+        throw std::runtime_error("mem_chunk: file " + key + " is not in the file list");
+    }
+
+    // Read the block table
+    const mem_file &stored = p->second.first;
+    const size_t raw = p->second.second;
+    const size_t stored_size = stored.size();
+    size_t next = 0;
+    if (stored_size < 8)
+    {
+        throw std::runtime_error("mem_chunk: corrupt file " + key + ", torn block table");
+    }
+    const uint32_t block = read_le<uint32_t>(stored, next);
+    const uint32_t blocks = read_le<uint32_t>(stored, next);
+    if (block == 0 || blocks != (raw + block - 1) / block || next + static_cast<size_t>(blocks) * 4 > stored_size)
+    {
+        throw std::runtime_error("mem_chunk: corrupt file " + key + ", torn block table");
+    }
+
+    // Validate every block before allocating, lz sequences expand at most 255 times
+    const size_t table = next;
+    size_t in = next + static_cast<size_t>(blocks) * 4;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const uint32_t size = read_le<uint32_t>(stored, next);
+        const size_t out = i * block;
+        const size_t out_size = (raw - out < block) ? raw - out : block;
+        if (size > out_size || out_size / 255 > size || in + size > stored_size)
+        {
+            throw std::runtime_error("mem_chunk: corrupt file " + key + ", torn block");
+        }
+        in += size;
+    }
+
+    // Allocate a new buffer for the file, so files that are being read never move
+    _unpacked.emplace_back(raw);
+    std::vector<uint8_t> &buffer = _unpacked.back();
+
+    try
+    {
+        // Decompress each block, blocks are independent of each other
+        next = table;
+        in = next + static_cast<size_t>(blocks) * 4;
+        for (size_t i = 0; i < blocks; i++)
+        {
+            const uint32_t size = read_le<uint32_t>(stored, next);
+            const size_t out = i * block;
+            const size_t out_size = (raw - out < block) ? raw - out : block;
+
+            // Blocks that did not compress are stored raw
+            if (size == out_size)
+            {
+                std::memcpy(&buffer[out], &stored[in], size);
+            }
+            else
+            {
+                lz::decompress(&stored[in], size, &buffer[out], out_size);
+            }
+            in += size;
+        }
+    }
+    catch (...)
+    {
+        // Release the buffer
+        _unpacked.pop_back();
+        throw;
+    }
+
+    // Move the file to the decompressed file list
+    mem_file &out = _files.insert({key, mem_file(&buffer, 0, raw)}).first->second;
+    _packed.erase(p);
+
+    return out;
+}
+
+void min::mem_chunk::pack(const mem_file &mem, std::vector<uint8_t> &out) const
+{
+    // Compress each block independently
+    const size_t raw = mem.size();
+    const uint32_t blocks = (raw + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<uint32_t> sizes(blocks);
+    std::vector<uint8_t> data;
+    data.reserve(raw);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const size_t offset = i * BLOCK_SIZE;
+        const size_t size = (raw - offset < BLOCK_SIZE) ? raw - offset : BLOCK_SIZE;
+        const uint8_t *const in = &mem[offset];
+
+        // Store the block raw if it did not compress
+        const size_t start = data.size();
+        lz::compress(in, size, data);
+        if (data.size() - start >= size)
+        {
+            data.resize(start);
+            data.insert(data.end(), in, in + size);
+        }
+        sizes[i] = data.size() - start;
+    }
+
+    // Write the block table followed by the blocks
+    write_le<uint32_t>(out, BLOCK_SIZE);
+    write_le<uint32_t>(out, blocks);
+    for (const uint32_t size : sizes)
+    {
+        write_le<uint32_t>(out, size);
+    }
+    out.insert(out.end(), data.begin(), data.end());
+}
+
+size_t min::mem_chunk::load_header(const mem_file &header, uint8_t *const base)
+{
+    // Get the size of the entire file
+    const size_t data_size = header.size();
+    if (data_size < 8)
+    {
+        throw std::runtime_error("mem_chunk: corrupt header, file is too small");
+    }
+
+    // Read the header from the data
+    size_t next = 0;
+
+    // Version 1 archives start with the file data size instead of the magic number
+    uint32_t version = 1;
+    uint32_t file_data_size = read_le<uint32_t>(header, next);
+    if (file_data_size == MAGIC)
+    {
+        if (data_size < 16)
+        {
+            throw std::runtime_error("mem_chunk: corrupt header, file is too small");
+        }
+
+        // Check the version
+        version = read_le<uint32_t>(header, next);
+        if (version != VERSION)
+        {
+            throw std::runtime_error("mem_chunk: unsupported archive version " + std::to_string(version));
+        }
+
+        // Get the number of files in file data
+        file_data_size = read_le<uint32_t>(header, next);
+    }
+
+    // Get the number of files in file list
+    const uint32_t files = read_le<uint32_t>(header, next);
+
+    // Read each file description
+    std::vector<std::pair<std::string, std::pair<uint32_t, uint32_t>>> list;
+    std::vector<uint32_t> raw_sizes;
+    list.reserve(files);
+    raw_sizes.reserve(files);
+    const size_t description = (version == 1) ? 12 : 16;
+    size_t accum_file = 0;
+    for (uint32_t i = 0; i < files; i++)
+    {
+        // Check the file description is inside the header
+        if (next + description > data_size)
+        {
+            throw std::runtime_error("mem_chunk: corrupt header, torn file description");
+        }
+
+        // Get the offset into data of file
+        const uint32_t offset = read_le<uint32_t>(header, next);
+
+        // Get the stored size of the file
+        const uint32_t file_size = read_le<uint32_t>(header, next);
+
+        // Get the uncompressed size of the file
+        const uint32_t raw_size = (version == 1) ? file_size : read_le<uint32_t>(header, next);
+
+        // Read size of the file name
+        const uint32_t str_size = read_le<uint32_t>(header, next);
+        if (next + str_size > data_size)
+        {
+            throw std::runtime_error("mem_chunk: corrupt header, torn file name");
+        }
+
+        // Read the file name
+        std::string name(str_size, 0);
+        if (str_size > 0)
+        {
+            std::memcpy(&name[0], &header[next], str_size);
+            next += str_size;
+        }
+
+        // Check the file is inside the data section
+        if (static_cast<size_t>(offset) + file_size > file_data_size)
+        {
+            throw std::runtime_error("mem_chunk: corrupt header, file '" + name + "' is outside of data section");
+        }
+
+        // Accumulate the file sizes
+        accum_file += file_size;
+
+        // Add file into the file list
+        list.emplace_back(std::move(name), std::make_pair(offset, file_size));
+        raw_sizes.push_back(raw_size);
+    }
+
+    // Check if the file content description matches the allocated declaration
+    if (accum_file != file_data_size)
+    {
+        throw std::runtime_error("mem_chunk: corrupt header, file description does not match allocated declaration");
+    }
+
+    // Check if we are reading the correct section
+    if (data_size != next + accum_file)
+    {
+        throw std::runtime_error("mem_chunk: corrupt header, torn file data section");
+    }
+
+    // Mapped files view the data section directly, otherwise they index into the file data
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const auto &f = list[i];
+        const mem_file mem = (base) ? mem_file(base + next, f.second.first, f.second.second)
+                                    : mem_file(&_file_data, f.second.first, f.second.second);
+
+        // Files with a different stored size are compressed and kept compressed when saved
+        if (raw_sizes[i] != f.second.second)
+        {
+            _packed.insert({f.first, std::make_pair(mem, raw_sizes[i])});
+            _compress.insert(f.first);
+        }
+        else
+        {
+            _files.insert({f.first, mem});
+        }
+    }
+
+    // Return the size of the header
+    return next;
+}
+
 void min::mem_chunk::load_memory_file(const std::string &file_name)
 {
     // Check that nothing funky is going on with char and uint8_t
@@ -58,86 +321,105 @@ void min::mem_chunk::load_memory_file(const std::string &file_name)
     if (file.is_open())
     {
         // Get the size of the file
-        std::streampos size = file.tellg();
+        const std::streampos size = file.tellg();
 
-        // Reserve space for the data
-        std::vector<uint8_t> data;
-        data.resize(size, 0);
+        // Read the whole file straight into the file data
+        _file_data.resize(size);
 
         // Adjust file pointer to beginning
         file.seekg(0, std::ios::beg);
 
         // Read bytes and close the file
-        char *ptr = reinterpret_cast<char *>(data.data());
+        char *ptr = reinterpret_cast<char *>(_file_data.data());
         file.read(ptr, size);
         file.close();
 
-        // Get the size of the entire file
-        const size_t data_size = data.size();
+        // Parse the header, then shift the data section to the front
+        const size_t header = load_header(mem_file(&_file_data, 0, _file_data.size()), nullptr);
+        _file_data.erase(_file_data.begin(), _file_data.begin() + header);
+    }
+    else
+    {
+        throw std::runtime_error("mem_chunk: could not read file '" + file_name + "'");
+    }
+}
+
+void min::mem_chunk::map_memory_file(const std::string &file_name)
+{
+#if defined(_WIN32)
 
-        // Read the header from the data
-        size_t next = 0;
+    // Open the file for reading
+    HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("mem_chunk: could not read file '" + file_name + "'");
+    }
 
-        // Get the number of files in file data
-        const uint32_t file_data_size = read_le<uint32_t>(data, next);
+    // Get the size of the file
+    LARGE_INTEGER size;
+    const bool sized = GetFileSizeEx(file, &size);
 
-        // Allocate space for the data file list
-        _file_data.resize(file_data_size);
+    // Map a copy on write view of the whole file, the view keeps the handles alive
+    HANDLE mapping = (sized) ? CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr) : nullptr;
+    void *view = (mapping) ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+    if (mapping)
+    {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
 
-        // Get the number of files in file list
-        const uint32_t files = read_le<uint32_t>(data, next);
+    // Check for errors
+    if (!view)
+    {
+        throw std::runtime_error("mem_chunk: could not map file '" + file_name + "'");
+    }
 
-        // Read each file description
-        uint32_t accum_file = 0;
-        for (uint32_t i = 0; i < files; i++)
-        {
-            // Get the offset into data of file
-            const uint32_t offset = read_le<uint32_t>(data, next);
+    _map = static_cast<uint8_t *>(view);
+    _map_size = static_cast<size_t>(size.QuadPart);
 
-            // Get the size of the file
-            const uint32_t file_size = read_le<uint32_t>(data, next);
+#elif __linux__
 
-            // Accumulate the file sizes
-            accum_file += file_size;
+    // Open the file for reading
+    const int file = open(file_name.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        throw std::runtime_error("mem_chunk: could not read file '" + file_name + "'");
+    }
 
-            // Read size of the file name
-            const uint32_t str_size = read_le<uint32_t>(data, next);
+    // Get the size of the file
+    struct stat st;
+    const bool sized = fstat(file, &st) == 0 && st.st_size > 0;
 
-            // Allocate space for file name
-            std::string name(str_size, 0);
+    // Map a copy on write view of the whole file, the mapping keeps the file alive
+    void *view = (sized) ? mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    close(file);
 
-            // Read the file name
-            for (uint32_t j = 0; j < str_size; j++)
-            {
-                name[j] = read_le<char>(data, next);
-            }
+    // Check for errors
+    if (view == MAP_FAILED)
+    {
+        throw std::runtime_error("mem_chunk: could not map file '" + file_name + "'");
+    }
 
-            // Add file into the file list
-            _files.insert({name, mem_file(&_file_data, offset, file_size)});
-        }
+    _map = static_cast<uint8_t *>(view);
+    _map_size = static_cast<size_t>(st.st_size);
 
-        // Check if the file content description matches the allocated declaration
-        if (accum_file != file_data_size)
-        {
-            throw std::runtime_error("mem_chunk: corrupt header, file description does not match allocated declaration");
-        }
+#else
 
-        // Check if we are reading the correct section
-        if (data_size != next + accum_file)
-        {
-            throw std::runtime_error("mem_chunk: corrupt header, torn file data section");
-        }
+    // No mapping on this platform so copy the file into memory
+    load_memory_file(file_name);
+    return;
 
-        // Copy the file data section
-        const size_t data_offset = next;
-        for (size_t i = data_offset; i < data_size; i++)
-        {
-            _file_data[i - data_offset] = data[i];
-        }
+#endif
+
+    // Only the header is touched here, file pages are loaded when they are read
+    try
+    {
+        _map_header = load_header(mem_file(_map, 0, _map_size), _map);
     }
-    else
+    catch (...)
     {
-        throw std::runtime_error("mem_chunk: could not read file '" + file_name + "'");
+        unmap();
+        throw;
     }
 }
 
@@ -149,36 +431,119 @@ void min::mem_chunk::save_memory_file(const std::string &file_name) const
     static_assert(std::is_same<std::uint8_t, unsigned char>::value,
                   "std::uint8_t must be implemented as unsigned char");
 
-    // Save bytes to file
-    std::ofstream file(file_name, std::ios::out | std::ios::binary);
+    // Save bytes to a temporary file, truncating a mapped archive in place would fault its views
+    const std::string temp_name = file_name + ".tmp";
+    std::ofstream file(temp_name, std::ios::out | std::ios::binary);
     if (file.is_open())
     {
+        // Collect all files, compressed files that were never read are written as is
+        std::vector<std::pair<const std::string *, const mem_file *>> files;
+        files.reserve(size());
+        for (const auto &p : _files)
+        {
+            files.emplace_back(&p.first, &p.second);
+        }
+        for (const auto &p : _packed)
+        {
+            files.emplace_back(&p.first, &p.second.first);
+        }
+
+        // Keep the file order, mapped files come before files added after mapping
+        std::vector<size_t> order(files.size());
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&files](const size_t a, const size_t b) {
+            const mem_file &ma = *files[a].second;
+            const mem_file &mb = *files[b].second;
+            if (ma.is_view() != mb.is_view())
+            {
+                return ma.is_view();
+            }
+            return ma.offset() < mb.offset();
+        });
+        std::vector<std::pair<const std::string *, const mem_file *>> list;
+        list.reserve(files.size());
+        for (const size_t i : order)
+        {
+            list.push_back(files[i]);
+        }
+
+        // Compress files that were requested compressed
+        std::vector<std::vector<uint8_t>> packed(list.size());
+        std::vector<uint32_t> sizes(list.size());
+        std::vector<uint32_t> raw_sizes;
+        raw_sizes.reserve(list.size());
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            const std::string &name = *list[i].first;
+            const mem_file &mem = *list[i].second;
+            const auto p = _packed.find(name);
+            if (p != _packed.end())
+            {
+                raw_sizes.push_back(p->second.second);
+                sizes[i] = mem.size();
+            }
+            else
+            {
+                raw_sizes.push_back(mem.size());
+                sizes[i] = mem.size();
+                if (_compress.count(name) > 0)
+                {
+                    // Only keep the compressed file if it is smaller
+                    pack(mem, packed[i]);
+                    if (packed[i].size() < mem.size())
+                    {
+                        sizes[i] = packed[i].size();
+                    }
+                    else
+                    {
+                        std::vector<uint8_t>().swap(packed[i]);
+                    }
+                }
+            }
+        }
+
         // Generate header byte stream
         std::vector<uint8_t> header;
 
+        // Write the magic number and version
+        write_le<uint32_t>(header, MAGIC);
+        write_le<uint32_t>(header, VERSION);
+
         // Write the size of the file data
-        write_le<uint32_t>(header, _file_data.size());
+        size_t file_data_size = 0;
+        for (const uint32_t size : sizes)
+        {
+            file_data_size += size;
+        }
+        write_le<uint32_t>(header, file_data_size);
 
         // Write the number of files in file list
-        write_le<uint32_t>(header, _files.size());
+        write_le<uint32_t>(header, list.size());
 
-        // Write the map contents to header
-        for (auto &p : _files)
+        // Write the file list contents to header
+        size_t offset = 0;
+        for (size_t i = 0; i < list.size(); i++)
         {
             // Write the file offset to header
-            write_le<uint32_t>(header, p.second.offset());
+            write_le<uint32_t>(header, offset);
+            offset += sizes[i];
 
-            // Write file size to header
-            write_le<uint32_t>(header, p.second.size());
+            // Write stored and uncompressed file size to header
+            write_le<uint32_t>(header, sizes[i]);
+            write_le<uint32_t>(header, raw_sizes[i]);
 
             // Write the size of the file name string
-            const size_t str_size = p.first.size();
+            const std::string &name = *list[i].first;
+            const size_t str_size = name.size();
             write_le<uint32_t>(header, str_size);
 
             // Write each character in file name
-            for (size_t i = 0; i < str_size; i++)
+            for (size_t j = 0; j < str_size; j++)
             {
-                write_le<char>(header, p.first[i]);
+                write_le<char>(header, name[j]);
             }
         }
 
@@ -187,11 +552,38 @@ void min::mem_chunk::save_memory_file(const std::string &file_name) const
         file.write(header_data, header.size());
 
         // Write the file data
-        const char *file_data = reinterpret_cast<const char *>(_file_data.data());
-        file.write(file_data, _file_data.size());
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (packed[i].size() > 0)
+            {
+                file.write(reinterpret_cast<const char *>(packed[i].data()), packed[i].size());
+            }
+            else if (sizes[i] > 0)
+            {
+                const mem_file &mem = *list[i].second;
+                file.write(reinterpret_cast<const char *>(&mem[0]), sizes[i]);
+            }
+        }
 
         // Close the file
         file.close();
+        if (!file)
+        {
+            std::remove(temp_name.c_str());
+            throw std::runtime_error("mem_chunk: could not save file '" + file_name + "'");
+        }
+
+        // Replace the target, mapped views keep the old file contents
+#if defined(_WIN32)
+        const bool replaced = MoveFileExA(temp_name.c_str(), file_name.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+        const bool replaced = std::rename(temp_name.c_str(), file_name.c_str()) == 0;
+#endif
+        if (!replaced)
+        {
+            std::remove(temp_name.c_str());
+            throw std::runtime_error("mem_chunk: could not replace file '" + file_name + "'");
+        }
     }
     else
     {
@@ -199,22 +591,54 @@ void min::mem_chunk::save_memory_file(const std::string &file_name) const
     }
 }
 
-min::mem_chunk::mem_chunk(const std::string &file)
+void min::mem_chunk::unmap()
+{
+    if (_map)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(_map);
+#elif __linux__
+        munmap(_map, _map_size);
+#endif
+        _map = nullptr;
+        _map_size = 0;
+        _map_header = 0;
+    }
+}
+
+min::mem_chunk::mem_chunk(const std::string &file, const bool map) : _map(nullptr), _map_size(0), _map_header(0)
 {
     // Load the file list from a file
-    load_memory_file(file);
+    if (map)
+    {
+        map_memory_file(file);
+    }
+    else
+    {
+        load_memory_file(file);
+    }
 }
 
-void min::mem_chunk::add_file(const std::string &file)
+min::mem_chunk::~mem_chunk()
 {
-    const auto &i = _files.find(file);
-    if (i == _files.end())
+    unmap();
+}
+
+void min::mem_chunk::add_file(const std::string &file, const bool compress)
+{
+    if (_files.count(file) == 0 && _packed.count(file) == 0)
     {
         // Push file onto end of file list
         const mem_file mf = push_back_file(file);
 
         // Insert the file name into file list
         _files.insert({file, mf});
+
+        // Compress this file when the archive is written
+        if (compress)
+        {
+            _compress.insert(file);
+        }
     }
     else
     {
@@ -227,39 +651,30 @@ void min::mem_chunk::clear()
     // This function should deallocate all held memory
     std::vector<uint8_t>().swap(_file_data);
     std::unordered_map<std::string, mem_file>().swap(_files);
+    std::unordered_map<std::string, std::pair<mem_file, uint32_t>>().swap(_packed);
+    std::deque<std::vector<uint8_t>>().swap(_unpacked);
+    std::unordered_set<std::string>().swap(_compress);
+    unmap();
 }
 
 const min::mem_file &min::mem_chunk::get_file(const std::string &key) const
 {
-    // Lookup key in the map
-    const auto &i = _files.find(key);
-    if (i != _files.end())
-    {
-        return i->second;
-    }
-    else
-    {
-        throw std::runtime_error("mem_chunk: file " + key + " is not in the file list");
-    }
+    return find_file(key);
 }
 
 min::mem_file &min::mem_chunk::get_file(const std::string &key)
 {
-    // Lookup key in the map
-    const auto &i = _files.find(key);
-    if (i != _files.end())
-    {
-        return i->second;
-    }
-    else
-    {
-        throw std::runtime_error("mem_chunk: file " + key + " is not in the file list");
-    }
+    return find_file(key);
+}
+
+bool min::mem_chunk::is_mapped() const
+{
+    return _map != nullptr;
 }
 
 size_t min::mem_chunk::size() const
 {
-    return _files.size();
+    return _files.size() + _packed.size();
 }
 
 void min::mem_chunk::write_memory_file(const std::string &file)
@@ -15,34 +15,67 @@ limitations under the License.
 #ifndef __MEMORY_CHUNK__
 #define __MEMORY_CHUNK__
 
+#include <algorithm>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "lz.h"
 #include "serial.h"
 
+// A mem_chunk can be loaded by copying the archive into memory or by mapping it
+// Mapped files are copy on write views into the archive and pages are loaded lazily as they are read
+
+// Files can be stored compressed in independent blocks, a compressed file is decompressed on first access
+// get_file can be called from many threads, other functions can not
+// Archive version 1 has no magic number and no compression, version 2 adds the uncompressed file size
+
 namespace min
 {
 
 class mem_chunk
 {
   private:
-    std::vector<uint8_t> _file_data;
-    std::unordered_map<std::string, mem_file> _files;
+    static constexpr uint32_t MAGIC = 0x434C474D;
+    static constexpr uint32_t VERSION = 2;
+    static constexpr uint32_t BLOCK_SIZE = 65536;
+
+    mutable std::vector<uint8_t> _file_data;
+    mutable std::unordered_map<std::string, mem_file> _files;
+    mutable std::unordered_map<std::string, std::pair<mem_file, uint32_t>> _packed;
+    mutable std::deque<std::vector<uint8_t>> _unpacked;
+    mutable std::mutex _lock;
+    std::unordered_set<std::string> _compress;
+    uint8_t *_map;
+    size_t _map_size;
+    size_t _map_header;
 
+    mem_file &find_file(const std::string&) const;
+    void pack(const mem_file&, std::vector<uint8_t>&) const;
     mem_file push_back_file(const std::string&);
+    size_t load_header(const mem_file&, uint8_t *const);
     void load_memory_file(const std::string&);
+    void map_memory_file(const std::string&);
     void save_memory_file(const std::string&) const;
+    void unmap();
 
   public:
-    mem_chunk() {}
-    mem_chunk(const std::string&);
-    void add_file(const std::string&);
+    mem_chunk() : _map(nullptr), _map_size(0), _map_header(0) {}
+    mem_chunk(const std::string&, const bool = false);
+    mem_chunk(const mem_chunk&) = delete;
+    mem_chunk &operator=(const mem_chunk&) = delete;
+    ~mem_chunk();
+    void add_file(const std::string&, const bool = false);
     void clear();
     const mem_file &get_file(const std::string&) const;
     mem_file &get_file(const std::string&);
+    bool is_mapped() const;
     size_t size() const;
     void write_memory_file(const std::string&);
 };
@@ -240,3 +240,166 @@ uint32_t min::ogg::get_sample_rate() const
 {
     return _sample_rate;
 }
+
+
+// ogg_stream member functions
+std::vector<uint8_t> min::ogg_stream::load_file(const std::string &_file)
+{
+    std::ifstream file(_file, std::ios::in | std::ios::binary | std::ios::ate);
+    if (file.is_open())
+    {
+        // Get the size of the file
+        const auto size = file.tellg();
+
+        // Adjust file pointer to beginning
+        file.seekg(0, std::ios::beg);
+
+        // Allocate space for new file
+        std::vector<uint8_t> data(size);
+
+        // Read bytes and close the file
+        char *ptr = reinterpret_cast<char *>(data.data());
+        file.read(ptr, size);
+
+        // Close the file
+        file.close();
+
+        return data;
+    }
+    else
+    {
+        throw std::runtime_error("ogg_stream: Could not load file '" + _file + "'");
+    }
+}
+
+void min::ogg_stream::open()
+{
+    // Check for an empty file before handing it to OggVorbis
+    if (_file.size() == 0)
+    {
+        throw std::runtime_error("ogg_stream: empty file");
+    }
+
+    // Set the callbacks struct using the fake file interface
+    ov_callbacks callbacks;
+    callbacks.read_func = fake_read_ogg;
+    callbacks.seek_func = fake_seek_ogg;
+    callbacks.close_func = fake_close_ogg;
+    callbacks.tell_func = fake_tell_ogg;
+
+    // Open the file from memory, the compressed file must outlive the OggVorbis_File
+    std::memset(&_ov_file, 0, sizeof(OggVorbis_File));
+    const int ret = ov_open_callbacks((void *)&_fake, &_ov_file, nullptr, -1, callbacks);
+    if (ret != 0)
+    {
+        throw std::runtime_error("ogg_stream: Error at ov_open_callbacks");
+    }
+
+    // Get the info from the OggVorbis file
+    const vorbis_info *const info = ov_info(&_ov_file, -1);
+    _num_channels = info->channels;
+    _sample_rate = info->rate;
+
+    // Assuming 16 bits per sample depth
+    _bits_per_sample = 16;
+}
+
+min::ogg_stream::ogg_stream(const std::string &file)
+    : _file(load_file(file)),
+      _fake(reinterpret_cast<char *>(_file.data()), reinterpret_cast<char *>(_file.data()), _file.size()),
+      _num_channels(0), _sample_rate(0), _bits_per_sample(0), _eof(false)
+{
+    open();
+}
+
+min::ogg_stream::ogg_stream(const mem_file &mem)
+    : _file(mem.data(), mem.data() + mem.size()),
+      _fake(reinterpret_cast<char *>(_file.data()), reinterpret_cast<char *>(_file.data()), _file.size()),
+      _num_channels(0), _sample_rate(0), _bits_per_sample(0), _eof(false)
+{
+    open();
+}
+
+min::ogg_stream::~ogg_stream()
+{
+    // Release the OggFile
+    ov_clear(&_ov_file);
+}
+
+size_t min::ogg_stream::decode(uint8_t *const dest, const size_t size)
+{
+    // Compressed data is decoded into the destination until it is full or the stream ends
+    const int endian = 0;
+    const int depth = 2;
+    const int sgned = 1;
+    int bit_stream = 0;
+    size_t offset = 0;
+    while (offset < size && !_eof)
+    {
+        // Read up to the space left in the destination
+        // Sound samples must be 16 bit depth!
+        char *const to = reinterpret_cast<char *>(dest + offset);
+        const int length = static_cast<int>(std::min<size_t>(size - offset, 4096));
+        const long bytes = ov_read(&_ov_file, to, length, endian, depth, sgned, &bit_stream);
+        if (bytes > 0)
+        {
+            offset += bytes;
+        }
+        else if (bytes == 0)
+        {
+            _eof = true;
+        }
+        else if (bytes != OV_HOLE)
+        {
+            throw std::runtime_error("ogg_stream: Error at ov_read '" + std::to_string(bytes) + "'");
+        }
+    }
+
+    // Return the number of bytes decoded
+    return offset;
+}
+
+bool min::ogg_stream::is_eof() const
+{
+    return _eof;
+}
+
+bool min::ogg_stream::is_mono() const
+{
+    return _num_channels == 1;
+}
+
+bool min::ogg_stream::is_stereo() const
+{
+    return _num_channels > 1;
+}
+
+uint32_t min::ogg_stream::get_bits_per_sample() const
+{
+    return _bits_per_sample;
+}
+
+size_t min::ogg_stream::get_block_size(const unsigned ms) const
+{
+    // Bytes of PCM for 'ms' milliseconds, rounded down to whole sample frames
+    const size_t frame = _num_channels * (_bits_per_sample / 8);
+    const size_t frames = (static_cast<size_t>(_sample_rate) * ms) / 1000;
+
+    return std::max<size_t>(frames, 1) * frame;
+}
+
+uint32_t min::ogg_stream::get_sample_rate() const
+{
+    return _sample_rate;
+}
+
+void min::ogg_stream::rewind()
+{
+    // Seek back to the first sample
+    const int ret = ov_pcm_seek(&_ov_file, 0);
+    if (ret != 0)
+    {
+        throw std::runtime_error("ogg_stream: Error at ov_pcm_seek");
+    }
+    _eof = false;
+}
@@ -15,7 +15,11 @@ limitations under the License.
 #ifndef OGG
 #define OGG
 
+#include <algorithm>
 #include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <vorbis/vorbisfile.h>
 
@@ -64,5 +68,38 @@ class ogg
     size_t get_data_samples() const;
     uint32_t get_sample_rate() const;
 };
+
+// Decodes an ogg file incrementally, only the compressed file is kept in memory
+// Blocks of 16 bit PCM are decoded on demand, so a stream can refill a few small buffers while playing
+class ogg_stream
+{
+  private:
+    std::vector<uint8_t> _file;
+    fake_file _fake;
+    OggVorbis_File _ov_file;
+    uint16_t _num_channels;
+    uint32_t _sample_rate;
+    uint32_t _bits_per_sample;
+    bool _eof;
+
+    static std::vector<uint8_t> load_file(const std::string&);
+    void open();
+
+  public:
+    ogg_stream(const std::string&);
+    ogg_stream(const mem_file&);
+    ~ogg_stream();
+    ogg_stream(const ogg_stream&) = delete;
+    ogg_stream &operator=(const ogg_stream&) = delete;
+
+    size_t decode(uint8_t *const, const size_t);
+    bool is_eof() const;
+    bool is_mono() const;
+    bool is_stereo() const;
+    uint32_t get_bits_per_sample() const;
+    size_t get_block_size(const unsigned) const;
+    uint32_t get_sample_rate() const;
+    void rewind();
+};
 }
 #endif
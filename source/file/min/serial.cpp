@@ -129,28 +129,16 @@ void min::write_be(std::vector<uint8_t> &stream, const T data, const size_t offs
 
 template std::vector<unsigned short> min::read_le_vector(const std::vector<uint8_t>&, size_t&);
 template std::vector<unsigned int> min::read_le_vector(const std::vector<uint8_t>&, size_t&);
+template std::vector<int> min::read_le_vector(const std::vector<uint8_t>&, size_t&);
+template std::vector<float> min::read_le_vector(const std::vector<uint8_t>&, size_t&);
 template <typename T>
 std::vector<T> min::read_le_vector(const std::vector<uint8_t> &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
     std::vector<T> out;
-    out.reserve(size);
-
-    // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(T) * size) > ssize)
-    {
-        throw std::runtime_error("read_le_vector: ran out of data in stream");
-    }
-
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
-    {
-        const T data = read_le<T>(stream, next);
-        out.push_back(data);
-    }
+    cursor.read_le_vector<T>(out);
+    next = cursor.next();
 
     return out;
 }
@@ -183,6 +171,8 @@ std::vector<T> min::read_be_vector(const std::vector<uint8_t> &stream, size_t &n
 
 template void min::write_le_vector(std::vector<uint8_t>&, const std::vector<unsigned short>&);
 template void min::write_le_vector(std::vector<uint8_t>&, const std::vector<unsigned int>&);
+template void min::write_le_vector(std::vector<uint8_t>&, const std::vector<int>&);
+template void min::write_le_vector(std::vector<uint8_t>&, const std::vector<float>&);
 template <typename T>
 void min::write_le_vector(std::vector<uint8_t> &stream, const std::vector<T> &data)
 {
@@ -192,11 +182,10 @@ void min::write_le_vector(std::vector<uint8_t> &stream, const std::vector<T> &da
     // Write vector size to stream, zero vector is allowed
     write_le<uint32_t>(stream, size);
 
-    // Write each data element
-    for (uint32_t i = 0; i < size; i++)
-    {
-        write_le<T>(stream, data[i]);
-    }
+    // Grow the stream once and copy all elements in bulk
+    const size_t offset = stream.size();
+    stream.resize(offset + sizeof(T) * size);
+    write_le_array<T>(stream.data() + offset, data.data(), size);
 }
 
 template <typename T>
@@ -322,25 +311,11 @@ template std::vector<min::vec2<double>> min::read_le_vector_vec2(const std::vect
 template <typename T>
 std::vector<min::vec2<T>> min::read_le_vector_vec2(const std::vector<uint8_t> &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
     std::vector<min::vec2<T>> out;
-    out.reserve(size);
-
-    // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(min::vec2<T>) * size) > ssize)
-    {
-        throw std::runtime_error("read_le_vector_vec2: ran out of data in stream");
-    }
-
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
-    {
-        const min::vec2<T> data = read_le_vec2<T>(stream, next);
-        out.push_back(data);
-    }
+    cursor.read_le_vector_vec2<T>(out);
+    next = cursor.next();
 
     return out;
 }
@@ -376,25 +351,11 @@ template std::vector<min::vec3<double>> min::read_le_vector_vec3(const std::vect
 template <typename T>
 std::vector<min::vec3<T>> min::read_le_vector_vec3(const std::vector<uint8_t> &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
     std::vector<min::vec3<T>> out;
-    out.reserve(size);
-
-    // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(min::vec3<T>) * size) > ssize)
-    {
-        throw std::runtime_error("read_le_vector_vec3: ran out of data in stream");
-    }
-
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
-    {
-        const min::vec3<T> data = read_le_vec3<T>(stream, next);
-        out.push_back(data);
-    }
+    cursor.read_le_vector_vec3<T>(out);
+    next = cursor.next();
 
     return out;
 }
@@ -430,25 +391,11 @@ template std::vector<min::vec4<double>> min::read_le_vector_vec4(const std::vect
 template <typename T>
 std::vector<min::vec4<T>> min::read_le_vector_vec4(const std::vector<uint8_t> &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
     std::vector<min::vec4<T>> out;
-    out.reserve(size);
-
-    // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(min::vec4<T>) * size) > ssize)
-    {
-        throw std::runtime_error("read_le_vector_vec4: ran out of data in stream");
-    }
-
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
-    {
-        const min::vec4<T> data = read_le_vec4<T>(stream, next);
-        out.push_back(data);
-    }
+    cursor.read_le_vector_vec4<T>(out);
+    next = cursor.next();
 
     return out;
 }
@@ -484,17 +431,19 @@ template void min::write_le_vector_vec2(std::vector<uint8_t>&, const std::vector
 template <typename T>
 void min::write_le_vector_vec2(std::vector<uint8_t> &stream, const std::vector<vec2<T>> &data)
 {
+    // Vectors are packed arrays of T
+    static_assert(sizeof(vec2<T>) == 2 * sizeof(T), "vec2<T> must be packed");
+
     // Get data size, must be less than 2^32-1
     const uint32_t size = data.size();
 
     // Write vector size to stream, zero vector is allowed
     write_le<uint32_t>(stream, size);
 
-    // Write each data element
-    for (uint32_t i = 0; i < size; i++)
-    {
-        write_le_vec2<T>(stream, data[i]);
-    }
+    // Grow the stream once and copy all elements in bulk
+    const size_t offset = stream.size();
+    stream.resize(offset + sizeof(T) * 2 * size);
+    write_le_array<T>(stream.data() + offset, reinterpret_cast<const T *>(data.data()), 2 * size);
 }
 
 template <typename T>
@@ -518,17 +467,19 @@ template void min::write_le_vector_vec3(std::vector<uint8_t>&, const std::vector
 template <typename T>
 void min::write_le_vector_vec3(std::vector<uint8_t> &stream, const std::vector<vec3<T>> &data)
 {
+    // Vectors are packed arrays of T
+    static_assert(sizeof(vec3<T>) == 3 * sizeof(T), "vec3<T> must be packed");
+
     // Get data size, must be less than 2^32-1
     const uint32_t size = data.size();
 
     // Write vector size to stream, zero vector is allowed
     write_le<uint32_t>(stream, size);
 
-    // Write each data element
-    for (uint32_t i = 0; i < size; i++)
-    {
-        write_le_vec3<T>(stream, data[i]);
-    }
+    // Grow the stream once and copy all elements in bulk
+    const size_t offset = stream.size();
+    stream.resize(offset + sizeof(T) * 3 * size);
+    write_le_array<T>(stream.data() + offset, reinterpret_cast<const T *>(data.data()), 3 * size);
 }
 
 template <typename T>
@@ -552,17 +503,19 @@ template void min::write_le_vector_vec4(std::vector<uint8_t>&, const std::vector
 template <typename T>
 void min::write_le_vector_vec4(std::vector<uint8_t> &stream, const std::vector<vec4<T>> &data)
 {
+    // Vectors are packed arrays of T
+    static_assert(sizeof(vec4<T>) == 4 * sizeof(T), "vec4<T> must be packed");
+
     // Get data size, must be less than 2^32-1
     const uint32_t size = data.size();
 
     // Write vector size to stream, zero vector is allowed
     write_le<uint32_t>(stream, size);
 
-    // Write each data element
-    for (uint32_t i = 0; i < size; i++)
-    {
-        write_le_vec4<T>(stream, data[i]);
-    }
+    // Grow the stream once and copy all elements in bulk
+    const size_t offset = stream.size();
+    stream.resize(offset + sizeof(T) * 4 * size);
+    write_le_array<T>(stream.data() + offset, reinterpret_cast<const T *>(data.data()), 4 * size);
 }
 
 template <typename T>
@@ -580,3 +533,214 @@ void min::write_be_vector_vec4(std::vector<uint8_t> &stream, const std::vector<v
         write_be_vec4<T>(stream, data[i]);
     }
 }
+
+std::string min::read_le_string(const std::vector<uint8_t> &stream, size_t &next)
+{
+    const uint32_t size = read_le<uint32_t>(stream, next);
+
+    // Check that the stream has enough data
+    if ((next + size) > stream.size())
+    {
+        throw std::runtime_error("read_le_string: ran out of data in stream");
+    }
+
+    // Copy the characters out of the stream
+    const std::string out(stream.begin() + next, stream.begin() + next + size);
+    next += size;
+
+    return out;
+}
+
+void min::write_le_string(std::vector<uint8_t> &stream, const std::string &data)
+{
+    // Write string size to stream, followed by the characters
+    write_le<uint32_t>(stream, data.size());
+    stream.insert(stream.end(), data.begin(), data.end());
+}
+
+template void min::swap_bytes<unsigned short>(uint8_t *const, const size_t);
+template void min::swap_bytes<unsigned int>(uint8_t *const, const size_t);
+template void min::swap_bytes<int>(uint8_t *const, const size_t);
+template void min::swap_bytes<float>(uint8_t *const, const size_t);
+template void min::swap_bytes<double>(uint8_t *const, const size_t);
+template <typename T>
+void min::swap_bytes(uint8_t *const bytes, const size_t count)
+{
+    // Reverse the bytes of each element in 16 byte blocks, this is a fixed shuffle the compiler can vectorize
+    constexpr size_t block = 16;
+    constexpr size_t size = sizeof(T);
+    static_assert(block % size == 0, "Invalid type size, sizeof(T) must divide 16");
+
+    const size_t length = count * size;
+    const size_t end = length - (length % block);
+    for (size_t i = 0; i < end; i += block)
+    {
+        uint8_t swap[block];
+        for (size_t j = 0; j < block; j++)
+        {
+            swap[j] = bytes[i + (j - j % size) + (size - 1 - j % size)];
+        }
+        std::memcpy(bytes + i, swap, block);
+    }
+
+    // Swap the remaining elements
+    for (size_t i = end; i < length; i += size)
+    {
+        for (size_t j = 0; j < size / 2; j++)
+        {
+            const uint8_t temp = bytes[i + j];
+            bytes[i + j] = bytes[i + size - 1 - j];
+            bytes[i + size - 1 - j] = temp;
+        }
+    }
+}
+
+template void min::read_le_array(const uint8_t *const, unsigned short *const, const size_t);
+template void min::read_le_array(const uint8_t *const, unsigned int *const, const size_t);
+template void min::read_le_array(const uint8_t *const, int *const, const size_t);
+template void min::read_le_array(const uint8_t *const, float *const, const size_t);
+template void min::read_le_array(const uint8_t *const, double *const, const size_t);
+template <typename T>
+void min::read_le_array(const uint8_t *const src, T *const dst, const size_t count)
+{
+    // Copy the whole array at once
+    if (count > 0)
+    {
+        std::memcpy(dst, src, sizeof(T) * count);
+
+#ifdef MGL_BIG_ENDIAN
+        // Convert from little endian to host byte order
+        swap_bytes<T>(reinterpret_cast<uint8_t *>(dst), count);
+#endif
+    }
+}
+
+template void min::write_le_array(uint8_t *const, const unsigned short *const, const size_t);
+template void min::write_le_array(uint8_t *const, const unsigned int *const, const size_t);
+template void min::write_le_array(uint8_t *const, const int *const, const size_t);
+template void min::write_le_array(uint8_t *const, const float *const, const size_t);
+template void min::write_le_array(uint8_t *const, const double *const, const size_t);
+template <typename T>
+void min::write_le_array(uint8_t *const dst, const T *const src, const size_t count)
+{
+    // Copy the whole array at once
+    if (count > 0)
+    {
+        std::memcpy(dst, src, sizeof(T) * count);
+
+#ifdef MGL_BIG_ENDIAN
+        // Convert from host byte order to little endian
+        swap_bytes<T>(dst, count);
+#endif
+    }
+}
+
+// min::stream_cursor methods
+void min::stream_cursor::check(const size_t bytes) const
+{
+    // Check that the stream has enough data
+    if (_next > _size || bytes > _size - _next)
+    {
+        throw std::runtime_error("stream_cursor: ran out of data in stream");
+    }
+}
+
+size_t min::stream_cursor::next() const
+{
+    return _next;
+}
+
+size_t min::stream_cursor::size() const
+{
+    return _size;
+}
+
+void min::stream_cursor::skip(const size_t bytes)
+{
+    check(bytes);
+    _next += bytes;
+}
+
+template unsigned short min::stream_cursor::read_le<unsigned short>();
+template unsigned int min::stream_cursor::read_le<unsigned int>();
+template int min::stream_cursor::read_le<int>();
+template float min::stream_cursor::read_le<float>();
+template double min::stream_cursor::read_le<double>();
+template <typename T>
+T min::stream_cursor::read_le()
+{
+    T out;
+    read_le<T>(&out, 1);
+
+    return out;
+}
+
+template void min::stream_cursor::read_le<unsigned short>(unsigned short *const, const size_t);
+template void min::stream_cursor::read_le<unsigned int>(unsigned int *const, const size_t);
+template void min::stream_cursor::read_le<int>(int *const, const size_t);
+template void min::stream_cursor::read_le<float>(float *const, const size_t);
+template void min::stream_cursor::read_le<double>(double *const, const size_t);
+template <typename T>
+void min::stream_cursor::read_le(T *const dst, const size_t count)
+{
+    // Check once and copy directly into the destination
+    const size_t bytes = sizeof(T) * count;
+    check(bytes);
+    read_le_array<T>(_data + _next, dst, count);
+    _next += bytes;
+}
+
+template void min::stream_cursor::read_le_vector<unsigned short>(std::vector<unsigned short>&);
+template void min::stream_cursor::read_le_vector<unsigned int>(std::vector<unsigned int>&);
+template void min::stream_cursor::read_le_vector<int>(std::vector<int>&);
+template void min::stream_cursor::read_le_vector<float>(std::vector<float>&);
+template void min::stream_cursor::read_le_vector<double>(std::vector<double>&);
+template <typename T>
+void min::stream_cursor::read_le_vector(std::vector<T> &out)
+{
+    const uint32_t size = read_le<uint32_t>();
+
+    // Check before resizing so bad sizes do not allocate
+    check(sizeof(T) * size);
+    out.resize(size);
+    read_le<T>(out.data(), size);
+}
+
+template void min::stream_cursor::read_le_vector_vec2<float>(std::vector<min::vec2<float>>&);
+template void min::stream_cursor::read_le_vector_vec2<double>(std::vector<min::vec2<double>>&);
+template <typename T>
+void min::stream_cursor::read_le_vector_vec2(std::vector<vec2<T>> &out)
+{
+    static_assert(sizeof(vec2<T>) == 2 * sizeof(T), "vec2<T> must be packed");
+
+    const uint32_t size = read_le<uint32_t>();
+    check(sizeof(vec2<T>) * size);
+    out.resize(size);
+    read_le<T>(reinterpret_cast<T *>(out.data()), 2 * size);
+}
+
+template void min::stream_cursor::read_le_vector_vec3<float>(std::vector<min::vec3<float>>&);
+template void min::stream_cursor::read_le_vector_vec3<double>(std::vector<min::vec3<double>>&);
+template <typename T>
+void min::stream_cursor::read_le_vector_vec3(std::vector<vec3<T>> &out)
+{
+    static_assert(sizeof(vec3<T>) == 3 * sizeof(T), "vec3<T> must be packed");
+
+    const uint32_t size = read_le<uint32_t>();
+    check(sizeof(vec3<T>) * size);
+    out.resize(size);
+    read_le<T>(reinterpret_cast<T *>(out.data()), 3 * size);
+}
+
+template void min::stream_cursor::read_le_vector_vec4<float>(std::vector<min::vec4<float>>&);
+template void min::stream_cursor::read_le_vector_vec4<double>(std::vector<min::vec4<double>>&);
+template <typename T>
+void min::stream_cursor::read_le_vector_vec4(std::vector<vec4<T>> &out)
+{
+    static_assert(sizeof(vec4<T>) == 4 * sizeof(T), "vec4<T> must be packed");
+
+    const uint32_t size = read_le<uint32_t>();
+    check(sizeof(vec4<T>) * size);
+    out.resize(size);
+    read_le<T>(reinterpret_cast<T *>(out.data()), 4 * size);
+}
@@ -20,6 +20,12 @@
 // Although this produces more instructions for the worst case,
 // we do not have to constantly check the machine byte order through the program lifetime and this eliminates branching
 
+// Arrays are the exception, shifting every element is too slow for large meshes
+// The byte order is fixed at compile time, little endian hosts copy arrays directly and big endian hosts swap them after copying
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define MGL_BIG_ENDIAN
+#endif
+
 namespace min
 {
 template <typename T> T read_le(const std::vector<uint8_t>&, size_t&);
@@ -56,5 +62,38 @@ template <typename T> void write_le_vector_vec3(std::vector<uint8_t>&, const std
 template <typename T> void write_be_vector_vec3(std::vector<uint8_t>&, const std::vector<vec3<T>>&);
 template <typename T> void write_le_vector_vec4(std::vector<uint8_t>&, const std::vector<vec4<T>>&);
 template <typename T> void write_be_vector_vec4(std::vector<uint8_t>&, const std::vector<vec4<T>>&);
+std::string read_le_string(const std::vector<uint8_t>&, size_t&);
+void write_le_string(std::vector<uint8_t>&, const std::string&);
+template <typename T> void swap_bytes(uint8_t *const, const size_t);
+template <typename T> void read_le_array(const uint8_t *const, T *const, const size_t);
+template <typename T> void write_le_array(uint8_t *const, const T *const, const size_t);
+
+// A cursor reads a little endian byte stream front to back
+// Bounds are checked once per call and arrays are copied in bulk into the destination
+class stream_cursor
+{
+  private:
+    const uint8_t *const _data;
+    const size_t _size;
+    size_t _next;
+
+    void check(const size_t) const;
+
+  public:
+    stream_cursor(const std::vector<uint8_t> &stream, const size_t next = 0)
+        : _data(stream.data()), _size(stream.size()), _next(next) {}
+    stream_cursor(const mem_file &mem, const size_t next = 0)
+        : _data(mem.data()), _size(mem.size()), _next(next) {}
+
+    size_t next() const;
+    size_t size() const;
+    void skip(const size_t);
+    template <typename T> T read_le();
+    template <typename T> void read_le(T *const, const size_t);
+    template <typename T> void read_le_vector(std::vector<T>&);
+    template <typename T> void read_le_vector_vec2(std::vector<vec2<T>>&);
+    template <typename T> void read_le_vector_vec3(std::vector<vec3<T>>&);
+    template <typename T> void read_le_vector_vec4(std::vector<vec4<T>>&);
+};
 }
 #endif
@@ -1,15 +1,25 @@
-#include "serial_mem.h"
+#include "serial.h"
 
 
 // min::mem_file methods
 const uint8_t &min::mem_file::operator[](const size_t index) const
 {
-    return (*_data)[_offset + index];
+    return (_view) ? _view[_offset + index] : (*_data)[_offset + index];
 }
 
 uint8_t &min::mem_file::operator[](const size_t index)
 {
-    return (*_data)[_offset + index];
+    return (_view) ? _view[_offset + index] : (*_data)[_offset + index];
+}
+
+const uint8_t *min::mem_file::data() const
+{
+    return ((_view) ? _view : _data->data()) + _offset;
+}
+
+bool min::mem_file::is_view() const
+{
+    return _view != nullptr;
 }
 
 size_t min::mem_file::offset() const
@@ -28,7 +38,7 @@ std::string min::mem_file::to_string() const
     std::string out(_size, 0);
 
     // Copy data into string
-    std::memcpy(&out[0], &(*_data)[_offset], _size);
+    std::memcpy(&out[0], &(*this)[0], _size);
 
     // Return the copied string
     return out;
@@ -89,28 +99,16 @@ T min::read_be(const mem_file &stream, size_t &next)
 
 template std::vector<unsigned int> min::read_le_vector(const mem_file&, size_t&);
 template std::vector<unsigned short> min::read_le_vector(const mem_file&, size_t&);
+template std::vector<int> min::read_le_vector(const mem_file&, size_t&);
+template std::vector<float> min::read_le_vector(const mem_file&, size_t&);
 template <typename T>
 std::vector<T> min::read_le_vector(const mem_file &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
     std::vector<T> out;
-    out.reserve(size);
-
-    // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(T) * size) > ssize)
-    {
-        throw std::runtime_error("read_le_vector: ran out of data in stream");
-    }
-
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
-    {
-        const T data = read_le<T>(stream, next);
-        out.push_back(data);
-    }
+    cursor.read_le_vector<T>(out);
+    next = cursor.next();
 
     return out;
 }
@@ -200,25 +198,11 @@ template std::vector<min::vec2<double>> min::read_le_vector_vec2(const min::mem_
 template <typename T>
 std::vector<min::vec2<T>> min::read_le_vector_vec2(const mem_file &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
     std::vector<min::vec2<T>> out;
-    out.reserve(size);
-
-    // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(min::vec2<T>) * size) > ssize)
-    {
-        throw std::runtime_error("read_le_vector_vec2: ran out of data in stream");
-    }
-
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
-    {
-        const min::vec2<T> data = read_le_vec2<T>(stream, next);
-        out.push_back(data);
-    }
+    cursor.read_le_vector_vec2<T>(out);
+    next = cursor.next();
 
     return out;
 }
@@ -254,25 +238,11 @@ template std::vector<min::vec3<double>> min::read_le_vector_vec3(const min::mem_
 template <typename T>
 std::vector<min::vec3<T>> min::read_le_vector_vec3(const mem_file &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
     std::vector<min::vec3<T>> out;
-    out.reserve(size);
-
-    // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(min::vec3<T>) * size) > ssize)
-    {
-        throw std::runtime_error("read_le_vector_vec3: ran out of data in stream");
-    }
-
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
-    {
-        const min::vec3<T> data = read_le_vec3<T>(stream, next);
-        out.push_back(data);
-    }
+    cursor.read_le_vector_vec3<T>(out);
+    next = cursor.next();
 
     return out;
 }
@@ -308,7 +278,19 @@ template std::vector<min::vec4<double>> min::read_le_vector_vec4(const mem_file&
 template <typename T>
 std::vector<min::vec4<T>> min::read_le_vector_vec4(const mem_file &stream, size_t &next)
 {
-    const uint32_t size = read_le<uint32_t>(stream, next);
+    // Bulk copy the vector through a cursor
+    stream_cursor cursor(stream, next);
+    std::vector<min::vec4<T>> out;
+    cursor.read_le_vector_vec4<T>(out);
+    next = cursor.next();
+
+    return out;
+}
+
+template <typename T>
+std::vector<min::vec4<T>> min::read_be_vector_vec4(const mem_file &stream, size_t &next)
+{
+    const uint32_t size = read_be<uint32_t>(stream, next);
 
     // Create output vector and reserve memory
     std::vector<min::vec4<T>> out;
@@ -318,41 +300,36 @@ std::vector<min::vec4<T>> min::read_le_vector_vec4(const mem_file &stream, size_
     const size_t ssize = stream.size();
     if ((next + sizeof(min::vec4<T>) * size) > ssize)
     {
-        throw std::runtime_error("read_le_vector_vec4: ran out of data in stream");
+        throw std::runtime_error("read_be_vector_vec4: ran out of data in stream");
     }
 
     // Read all vector elements
     for (uint32_t i = 0; i < size; i++)
     {
-        const min::vec4<T> data = read_le_vec4<T>(stream, next);
+        const min::vec4<T> data = read_be_vec4<T>(stream, next);
         out.push_back(data);
     }
 
     return out;
 }
 
-template <typename T>
-std::vector<min::vec4<T>> min::read_be_vector_vec4(const mem_file &stream, size_t &next)
+std::string min::read_le_string(const mem_file &stream, size_t &next)
 {
-    const uint32_t size = read_be<uint32_t>(stream, next);
-
-    // Create output vector and reserve memory
-    std::vector<min::vec4<T>> out;
-    out.reserve(size);
+    const uint32_t size = read_le<uint32_t>(stream, next);
 
     // Check that the stream has enough data
-    const size_t ssize = stream.size();
-    if ((next + sizeof(min::vec4<T>) * size) > ssize)
+    if ((next + size) > stream.size())
     {
-        throw std::runtime_error("read_be_vector_vec4: ran out of data in stream");
+        throw std::runtime_error("read_le_string: ran out of data in stream");
     }
 
-    // Read all vector elements
-    for (uint32_t i = 0; i < size; i++)
+    // Copy the characters out of the stream
+    std::string out(size, 0);
+    if (size > 0)
     {
-        const min::vec4<T> data = read_be_vec4<T>(stream, next);
-        out.push_back(data);
+        std::memcpy(&out[0], &stream[next], size);
     }
+    next += size;
 
     return out;
 }
@@ -21,19 +21,25 @@
 namespace min
 {
 
+// A mem_file is either an offset into a growable byte vector, or a view into fixed memory such as a mapped file
 class mem_file
 {
   private:
     std::vector<uint8_t> *const _data;
+    uint8_t *const _view;
     size_t _offset;
     size_t _size;
 
   public:
     mem_file(std::vector<uint8_t> *const data, const size_t offset, const size_t size)
-        : _data(data), _offset(offset), _size(size) {}
+        : _data(data), _view(nullptr), _offset(offset), _size(size) {}
+    mem_file(uint8_t *const view, const size_t offset, const size_t size)
+        : _data(nullptr), _view(view), _offset(offset), _size(size) {}
 
     const uint8_t &operator[](const size_t) const;
     uint8_t &operator[](const size_t);
+    const uint8_t *data() const;
+    bool is_view() const;
     size_t offset() const;
     size_t size() const;
     std::string to_string() const;
@@ -55,6 +61,7 @@ template <typename T> std::vector<min::vec3<T>> read_le_vector_vec3(const mem_fi
 template <typename T> std::vector<min::vec3<T>> read_be_vector_vec3(const mem_file&, size_t&);
 template <typename T> std::vector<min::vec4<T>> read_le_vector_vec4(const mem_file&, size_t&);
 template <typename T> std::vector<min::vec4<T>> read_be_vector_vec4(const mem_file&, size_t&);
+std::string read_le_string(const mem_file&, size_t&);
 
 }
 #endif
@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "strtoken.h"
 
+template bool min::to_real<float>(const char*&, const char*, float&);
+template bool min::to_real<double>(const char*&, const char*, double&);
+
 // trim from start
 std::string &min::ltrim(std::string &s)
 {
@@ -196,3 +199,187 @@ std::string min::to_lower(const std::string &s)
 
     return out;
 }
+
+bool min::is_space(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+// Returns pointer to first non 'space' character or end
+const char *min::skip_space(const char *s, const char *end)
+{
+    while (s != end && is_space(*s))
+    {
+        s++;
+    }
+
+    return s;
+}
+
+// Returns pointer to first 'space' character or end
+const char *min::skip_token(const char *s, const char *end)
+{
+    while (s != end && !is_space(*s))
+    {
+        s++;
+    }
+
+    return s;
+}
+
+// Returns end pointer with trailing 'space' characters removed
+const char *min::trim_end(const char *s, const char *end)
+{
+    while (end != s && is_space(*(end - 1)))
+    {
+        end--;
+    }
+
+    return end;
+}
+
+// Reads an unsigned integer and stops at the first non digit, fails on no digits or overflow
+bool min::to_uint(const char *&s, const char *end, uint32_t &out)
+{
+    const char *p = skip_space(s, end);
+
+    // Accumulate digits in 64 bits to detect overflow
+    uint64_t value = 0;
+    const char *start = p;
+    for (; p != end && *p >= '0' && *p <= '9'; p++)
+    {
+        value = value * 10 + (*p - '0');
+        if (value > 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+
+    // Check that we read something
+    if (p == start)
+    {
+        return false;
+    }
+
+    // Advance the stream
+    out = static_cast<uint32_t>(value);
+    s = p;
+
+    return true;
+}
+
+// Reads a decimal real number '[+-]digits[.digits][(e|E)[+-]digits]'
+// The number must be terminated by a 'space' character or end
+template <typename T>
+bool min::to_real(const char *&s, const char *end, T &out)
+{
+    // Exact powers of ten representable as double
+    static constexpr double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char *p = skip_space(s, end);
+
+    // Read the sign
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    // Read up to 19 significant digits, which always fit in 64 bits
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool valid = false;
+    for (; p != end && *p >= '0' && *p <= '9'; p++)
+    {
+        valid = true;
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += (mantissa != 0);
+        }
+        else
+        {
+            // Drop the digit but keep the magnitude
+            exponent++;
+        }
+    }
+
+    // Read the fraction
+    if (p != end && *p == '.')
+    {
+        for (p++; p != end && *p >= '0' && *p <= '9'; p++)
+        {
+            valid = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+
+    // Check that we read something
+    if (!valid)
+    {
+        return false;
+    }
+
+    // Read the exponent
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool negative_exp = false;
+        if (p != end && (*p == '-' || *p == '+'))
+        {
+            negative_exp = (*p == '-');
+            p++;
+        }
+
+        // Clamp the exponent, anything this large is zero or infinity anyway
+        int e = 0;
+        const char *start = p;
+        for (; p != end && *p >= '0' && *p <= '9'; p++)
+        {
+            if (e < 10000)
+            {
+                e = e * 10 + (*p - '0');
+            }
+        }
+
+        // An exponent needs digits
+        if (p == start)
+        {
+            return false;
+        }
+
+        exponent += negative_exp ? -e : e;
+    }
+
+    // The number must end here
+    if (p != end && !is_space(*p))
+    {
+        return false;
+    }
+
+    // Scale the mantissa, a single multiply or divide by an exact power is correctly rounded
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0)
+    {
+        value /= (exponent >= -22) ? pow10[-exponent] : std::pow(10.0, -exponent);
+    }
+    else if (exponent > 0)
+    {
+        value *= (exponent <= 22) ? pow10[exponent] : std::pow(10.0, exponent);
+    }
+
+    // Advance the stream
+    out = static_cast<T>(negative ? -value : value);
+    s = p;
+
+    return true;
+}
@@ -17,8 +17,11 @@ limitations under the License.
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <locale>
+#include <string>
 #include <vector>
 
 namespace min
@@ -37,5 +40,13 @@ std::vector<std::pair<size_t, size_t>> read_lines(const std::string&, const size
 std::vector<std::string> get_lines(const std::string&, const std::vector<std::pair<size_t, size_t>>&, const unsigned, size_t&);
 std::string to_lower(const std::string&);
 
+// In place tokenizing of a character range, these never allocate and advance the pointer past what they read
+bool is_space(const char);
+const char *skip_space(const char*, const char*);
+const char *skip_token(const char*, const char*);
+const char *trim_end(const char*, const char*);
+bool to_uint(const char*&, const char*, uint32_t&);
+template <typename T> bool to_real(const char*&, const char*, T&);
+
 }
 #endif
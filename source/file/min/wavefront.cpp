@@ -18,6 +18,21 @@ limitations under the License.
 template class min::wavefront<double, unsigned short>;
 template class min::wavefront<float, unsigned int>;
 
+template <typename T, typename K>
+template <typename L>
+void min::wavefront<T,K>::append(std::vector<L> &to, std::vector<L> &from)
+{
+    // Steal the buffer if we have nothing yet
+    if (to.size() == 0)
+    {
+        to.swap(from);
+    }
+    else
+    {
+        to.insert(to.end(), from.begin(), from.end());
+    }
+}
+
 template <typename T, typename K>
 void min::wavefront<T,K>::flush()
 {
@@ -30,7 +45,7 @@ void min::wavefront<T,K>::flush()
 }
 
 template <typename T, typename K>
-void min::wavefront<T,K>::load_file(const std::string _file)
+void min::wavefront<T,K>::load_file(const std::string _file, thread_pool *const pool)
 {
     std::ifstream file(_file, std::ios::in | std::ios::binary | std::ios::ate);
     if (file.is_open())
@@ -50,105 +65,228 @@ void min::wavefront<T,K>::load_file(const std::string _file)
         // Close the file
         file.close();
 
-        // Process the DDS file
-        load(data);
+        // Process the OBJ file
+        load(data.data(), data.size(), pool);
+    }
+    else
+    {
+        throw std::runtime_error("wavefront: Could not load file '" + _file + "'");
+    }
+}
+
+template <typename T, typename K>
+void min::wavefront<T,K>::load(const char *data, const size_t size, thread_pool *const pool)
+{
+    // Split large files into chunks of at least 1 MB, a few chunks per thread to balance the load
+    size_t chunks = 1;
+    if (pool)
+    {
+        chunks = std::max(std::min(pool->get_size() * 4, size >> 20), static_cast<size_t>(1));
+    }
+
+    // Move each chunk boundary forward to the start of the next line
+    const char *const end = data + size;
+    std::vector<const char *> bounds(chunks + 1);
+    bounds[0] = data;
+    bounds[chunks] = end;
+    for (size_t i = 1; i < chunks; i++)
+    {
+        const char *p = std::max(data + (size * i) / chunks, bounds[i - 1]);
+        const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        bounds[i] = (eol) ? eol + 1 : end;
+    }
+
+    // Parse each chunk, the thread pool does not propagate exceptions so store them
+    std::vector<std::vector<segment>> segments(chunks);
+    std::vector<std::exception_ptr> errors(chunks);
+    const auto work = [this, &bounds, &segments, &errors](const size_t i) {
+        try
+        {
+            parse(bounds[i], bounds[i + 1], segments[i]);
+        }
+        catch (...)
+        {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    // Only use the pool if there is more than one chunk
+    if (chunks > 1)
+    {
+        pool->run(work, 0, chunks);
     }
     else
     {
-        throw std::runtime_error("md5_mesh: Could not load file '" + _file + "'");
+        work(0);
+    }
+
+    // Merge chunks in file order, so errors are reported in the same order as a serial load
+    for (size_t i = 0; i < chunks; i++)
+    {
+        for (auto &s : segments[i])
+        {
+            merge(s);
+        }
+
+        if (errors[i])
+        {
+            std::rethrow_exception(errors[i]);
+        }
     }
+
+    // Consume data in buffers
+    flush();
 }
 
 template <typename T, typename K>
-void min::wavefront<T,K>::load(const std::string &data)
+void min::wavefront<T,K>::merge(segment &s)
 {
-    // Get locations of all lines in string buffer
-    auto lines = min::read_lines(data);
+    // if new object
+    if (s.object)
+    {
+        // Consume data in buffers
+        flush();
+
+        // Create new mesh to be processed
+        _mesh.emplace_back(s.name);
+    }
+
+    // Indices are relative to the current object so just append the attributes
+    append(_v, s.v);
+    append(_uv, s.uv);
+    append(_n, s.n);
+    append(_i, s.i);
+}
+
+template <typename T, typename K>
+void min::wavefront<T,K>::parse(const char *begin, const char *end, std::vector<segment> &out) const
+{
+    // Attributes before the first object line continue the previous chunk
+    out.emplace_back(nullptr, nullptr, false);
 
     // Read line by line
-    for (auto &position : lines)
+    const char *line = begin;
+    while (line != end)
     {
-        // read line and trim the line whitespace
-        std::string line = data.substr(position.first, position.second);
-        min::trim(line);
+        // Find the end of this line
+        const char *eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        eol = (eol) ? eol : end;
+
+        // Trim the line whitespace in place
+        const char *b = min::skip_space(line, eol);
+        const char *e = min::trim_end(b, eol);
+
+        // Advance to next line
+        line = (eol != end) ? eol + 1 : end;
 
-        // skip empty line size in bytes
-        if (line.size() == 0)
+        // skip empty line, all prefixes are at least two bytes except faces
+        const size_t length = e - b;
+        if (length == 0)
         {
             continue;
         }
+        const char second = (length > 1) ? b[1] : '\0';
 
         // if new object
-        if (line.compare(0, 2, "o ") == 0)
+        if (b[0] == 'o' && second == ' ')
         {
-            process_object(line);
+            out.emplace_back(min::skip_space(b + 2, e), e, true);
         }
         // If vertex coordinate
-        else if (line.compare(0, 2, "v ") == 0)
+        else if (b[0] == 'v' && second == ' ')
         {
-            process_vertex(line);
+            process_vertex(b, e, out.back());
         }
         // if texture coordinate
-        else if (line.compare(0, 2, "vt") == 0)
+        else if (b[0] == 'v' && second == 't')
         {
-            process_uv(line);
+            process_uv(b, e, out.back());
         }
         // if normal coordinate
-        else if (line.compare(0, 2, "vn") == 0)
+        else if (b[0] == 'v' && second == 'n')
         {
-            process_normal(line);
+            process_normal(b, e, out.back());
         }
         // if face coordinate
-        else if (line.compare(0, 1, "f") == 0)
+        else if (b[0] == 'f')
         {
-            process_face(line);
+            process_face(b, e, out.back());
         }
     }
-
-    // Consume data in buffers
-    flush();
 }
 
 template <typename T, typename K>
 void min::wavefront<T,K>::process_mesh(mesh<T, K> &mesh)
 {
     // Check attribute indices are multiple of three
-    auto size = _i.size();
+    const size_t size = _i.size();
     if (size % 3 != 0)
     {
         throw std::runtime_error("wavefront: Face attribute indices not multiple of three, invalid format");
     }
 
-    // Use a map to test for unique index combinations
-    std::map<std::array<K, 3>, K> map;
-    std::vector<std::array<K, 3>> attr;
+    // Open addressing hash table to test for unique index combinations
+    // Slots store the attribute node index + 1, zero marks an empty slot
+    const size_t nodes = size / 3;
+    size_t capacity = 16;
+    while (capacity < nodes * 2)
+    {
+        capacity <<= 1;
+    }
+    const size_t mask = capacity - 1;
+    std::vector<size_t> table(capacity, 0);
 
     // Store all unique attribute nodes in the attribute vector on successful insert
-    for (size_t i = 0, j = 0; i < size; i += 3)
+    std::vector<std::array<K, 3>> attr;
+    attr.reserve(nodes);
+    mesh.index.reserve(mesh.index.size() + nodes);
+    for (size_t i = 0; i < size; i += 3)
     {
-        // If inserted into map, copy the attribute to attribute vector
-        std::array<K, 3> node = {_i[i], _i[i + 1], _i[i + 2]};
-        auto it = map.insert(std::pair<std::array<K, 3>, K>(node, j));
-        if (it.second)
+        const K a = _i[i];
+        const K b = _i[i + 1];
+        const K c = _i[i + 2];
+
+        // Hash the index combination
+        uint64_t h = (a * 0x9E3779B97F4A7C15ULL) ^ (b * 0xC2B2AE3D27D4EB4FULL) ^ (c * 0x165667B19E3779F9ULL);
+        size_t slot = (h ^ (h >> 32)) & mask;
+
+        // Linear probe until we find this node or an empty slot
+        while (true)
         {
-            // No duplicate so copy this node
-            attr.push_back(node);
-            j++;
+            const size_t node = table[slot];
+            if (node == 0)
+            {
+                // No duplicate so copy this node
+                attr.push_back({a, b, c});
+                table[slot] = attr.size();
+                mesh.index.push_back(attr.size() - 1);
+                break;
+            }
+
+            // Set index for this node if duplicate
+            const std::array<K, 3> &n = attr[node - 1];
+            if (n[0] == a && n[1] == b && n[2] == c)
+            {
+                mesh.index.push_back(node - 1);
+                break;
+            }
+
+            slot = (slot + 1) & mask;
         }
-
-        // Set index for this node
-        mesh.index.push_back(it.first->second);
     }
 
     // Process all attribute nodes, copy vertex, uv, and normal into buffer using indices
+    mesh.vertex.reserve(mesh.vertex.size() + attr.size());
+    mesh.uv.reserve(mesh.uv.size() + attr.size());
+    mesh.normal.reserve(mesh.normal.size() + attr.size());
     for (const auto &node : attr)
     {
         // Check that indices are valid before copying, node[N] is index + 1
-        if (node[0] > _v.size())
+        if (node[0] == 0 || node[0] > _v.size())
             throw std::runtime_error("wavefront: face index out of range, invalid format");
-        if (node[1] > _uv.size())
+        if (node[1] == 0 || node[1] > _uv.size())
             throw std::runtime_error("wavefront: face index out of range, invalid format");
-        if (node[2] > _n.size())
+        if (node[2] == 0 || node[2] > _n.size())
             throw std::runtime_error("wavefront: face index out of range, invalid format");
 
         // Get attribute references
@@ -176,120 +314,131 @@ void min::wavefront<T,K>::process_mesh(mesh<T, K> &mesh)
 }
 
 template <typename T, typename K>
-void min::wavefront<T,K>::process_object(const std::string &line)
-{
-    // Trim the mesh name
-    std::string name = line.substr(2);
-    min::trim(name);
-
-    // Consume data in buffers
-    flush();
-
-    // Create new mesh to be processed
-    _mesh.emplace_back(name);
-}
-
-template <typename T, typename K>
-void min::wavefront<T,K>::process_vertex(const std::string &line)
+void min::wavefront<T,K>::process_vertex(const char *begin, const char *end, segment &s) const
 {
     // Parse string to three numbers
     T x, y, z;
-    std::istringstream s(line.substr(2));
-    s >> x >> y >> z;
-
-    // Check for errors
-    if (s.fail())
+    const char *p = begin + 2;
+    if (!min::to_real(p, end, x) || !min::to_real(p, end, y) || !min::to_real(p, end, z))
     {
-        throw std::runtime_error("wavefront: Invalid vertex line '" + line + "'");
+        throw std::runtime_error("wavefront: Invalid vertex line '" + std::string(begin, end) + "'");
     }
 
     // add vertex to list
-    _v.emplace_back(x, y, z, 1.0);
+    s.v.emplace_back(x, y, z, 1.0);
 }
 
 template <typename T, typename K>
-void min::wavefront<T,K>::process_uv(const std::string &line)
+void min::wavefront<T,K>::process_uv(const char *begin, const char *end, segment &s) const
 {
     // Parse string to two numbers
-    std::istringstream s(line.substr(2));
     T u, v;
-    s >> u >> v;
-
-    // Check for errors
-    if (s.fail())
+    const char *p = begin + 2;
+    if (!min::to_real(p, end, u) || !min::to_real(p, end, v))
     {
-        throw std::runtime_error("wavefront: Invalid uv line '" + line + "'");
+        throw std::runtime_error("wavefront: Invalid uv line '" + std::string(begin, end) + "'");
     }
 
     // Check inverted flag
     // add texture coordinate to list
     if (!_invert)
-        _uv.emplace_back(u, v);
+        s.uv.emplace_back(u, v);
     else
-        _uv.emplace_back(u, 1.0 - v);
+        s.uv.emplace_back(u, 1.0 - v);
 }
 
 template <typename T, typename K>
-void min::wavefront<T,K>::process_normal(const std::string &line)
+void min::wavefront<T,K>::process_normal(const char *begin, const char *end, segment &s) const
 {
     // Parse string to three numbers
     T x, y, z;
-    std::istringstream s(line.substr(2));
-    s >> x >> y >> z;
-
-    // Check for errors
-    if (s.fail())
+    const char *p = begin + 2;
+    if (!min::to_real(p, end, x) || !min::to_real(p, end, y) || !min::to_real(p, end, z))
     {
-        throw std::runtime_error("wavefront: Invalid normal line '" + line + "'");
+        throw std::runtime_error("wavefront: Invalid normal line '" + std::string(begin, end) + "'");
     }
 
     // Add normals to list
-    _n.emplace_back(x, y, z);
+    s.n.emplace_back(x, y, z);
 }
 
 template <typename T, typename K>
-void min::wavefront<T,K>::process_face(const std::string &line)
+void min::wavefront<T,K>::process_face(const char *begin, const char *end, segment &s) const
 {
-    // Trim the substring
-    std::string sub = line.substr(2);
-    min::trim(sub);
+    // Trim the face prefix
+    const char *sub = min::skip_space(begin + 1, end);
 
     // Split on space, verify three columns, "\\s+"
-    auto columns = min::split_space(sub);
-    if (columns.size() != 3)
+    std::array<std::pair<const char *, const char *>, 3> columns;
+    size_t count = 0;
+    for (const char *p = sub; p != end; p = min::skip_space(p, end))
     {
-        throw std::runtime_error("wavefront: Faces must be triangulated, invalid format '" + sub + "'");
+        const char *token = min::skip_token(p, end);
+        if (count < 3)
+        {
+            columns[count] = std::make_pair(p, token);
+        }
+        count++;
+        p = token;
+    }
+
+    if (count != 3)
+    {
+        throw std::runtime_error("wavefront: Faces must be triangulated, invalid format '" + std::string(sub, end) + "'");
     }
 
     // For all columns
     for (const auto &c : columns)
     {
-        // Split on forward slash, verify 3 rows, "\\/+"
-        auto rows = min::split_slash(c);
-        if (rows.size() != 3)
+        // Parse 'v/uv/n', verify three rows
+        uint32_t v, uv, n;
+        const char *p = c.first;
+        const bool valid = min::to_uint(p, c.second, v) && p != c.second && *p++ == '/'
+                           && min::to_uint(p, c.second, uv) && p != c.second && *p++ == '/'
+                           && min::to_uint(p, c.second, n) && p == c.second;
+        if (!valid)
         {
-            throw std::runtime_error("wavefront: Faces must be fully defined vertex/uv/normal, invalid format '" + c + "'");
+            throw std::runtime_error("wavefront: Faces must be fully defined vertex/uv/normal, invalid format '" + std::string(c.first, c.second) + "'");
         }
 
-        // Add all indices to the index list
-        for (const auto &r : rows)
+        // Check indices fit in the index type before narrowing
+        const uint32_t max = std::numeric_limits<K>::max();
+        if (v > max || uv > max || n > max)
         {
-            int value = std::stoi(r);
-            _i.push_back(value);
+            throw std::runtime_error("wavefront: Face index exceeds index type range '" + std::string(c.first, c.second) + "'");
         }
+
+        // Add all indices to the index list
+        s.i.push_back(v);
+        s.i.push_back(uv);
+        s.i.push_back(n);
     }
 }
 
 template <typename T, typename K>
 min::wavefront<T,K>::wavefront(const std::string &file, const bool invert) : _invert(invert)
 {
-    load_file(file);
+    load_file(file, nullptr);
 }
 
 template <typename T, typename K>
 min::wavefront<T,K>::wavefront(const mem_file &mem, const bool invert) : _invert(invert)
 {
-    load(mem.to_string());
+    const char *data = (mem.size() > 0) ? reinterpret_cast<const char *>(&mem[0]) : nullptr;
+    load(data, mem.size(), nullptr);
+}
+
+template <typename T, typename K>
+min::wavefront<T,K>::wavefront(const std::string &file, thread_pool &pool, const bool invert) : _invert(invert)
+{
+    load_file(file, &pool);
+}
+
+template <typename T, typename K>
+min::wavefront<T,K>::wavefront(const mem_file &mem, thread_pool &pool, const bool invert) : _invert(invert)
+{
+    const char *data = (mem.size() > 0) ? reinterpret_cast<const char *>(&mem[0]) : nullptr;
+    load(data, mem.size(), &pool);
 }
 
 template <typename T, typename K>
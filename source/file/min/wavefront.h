@@ -15,17 +15,19 @@ limitations under the License.
 #ifndef WAVEFRONT
 #define WAVEFRONT
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <limits>
-#include <map>
-#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "geom/min/mesh.h"
+#include "platform/min/thread_pool.h"
 
 #include "mem_chunk.h"
 #include "strtoken.h"
@@ -37,6 +39,9 @@ limitations under the License.
 // Support is limited to fully triangulated meshes, that have uv and normals
 // defined for each vertex
 
+// Lines are tokenized in place without allocating, large files are split on line
+// boundaries and each chunk is parsed on a thread pool if one is provided
+
 namespace min
 {
 
@@ -44,6 +49,20 @@ template <typename T, typename K>
 class wavefront
 {
   private:
+    // Attributes parsed from a line range, a segment starts at an 'o' line or at the chunk start
+    class segment
+    {
+      public:
+        std::string name;
+        std::vector<vec4<T>> v;
+        std::vector<vec2<T>> uv;
+        std::vector<vec3<T>> n;
+        std::vector<K> i;
+        bool object;
+
+        segment(const char *begin, const char *end, const bool obj) : name(begin, end), object(obj) {}
+    };
+
     std::vector<mesh<T, K>> _mesh;
     std::vector<vec4<T>> _v;
     std::vector<vec2<T>> _uv;
@@ -51,20 +70,24 @@ class wavefront
     std::vector<K> _i;
     bool _invert;
 
+    template <typename L>
+    static void append(std::vector<L>&, std::vector<L>&);
     void flush();
-    void load_file(const std::string _file);
-    void load(const std::string&);
+    void load_file(const std::string, thread_pool *const);
+    void load(const char*, const size_t, thread_pool *const);
+    void merge(segment&);
+    void parse(const char*, const char*, std::vector<segment>&) const;
     void process_mesh(mesh<T, K>&);
-    void process_object(const std::string&);
-    void process_vertex(const std::string&);
-    void process_uv(const std::string&);
-    void process_normal(const std::string&);
-    void process_face(const std::string&);
-
+    void process_vertex(const char*, const char*, segment&) const;
+    void process_uv(const char*, const char*, segment&) const;
+    void process_normal(const char*, const char*, segment&) const;
+    void process_face(const char*, const char*, segment&) const;
 
   public:
     wavefront(const std::string&, const bool = false);
     wavefront(const mem_file&, const bool = false);
+    wavefront(const std::string&, thread_pool&, const bool = false);
+    wavefront(const mem_file&, thread_pool&, const bool = false);
 
     const std::vector<mesh<T,K>> &get_meshes() const;
     std::vector<mesh<T,K>> &get_meshes();
@@ -274,14 +274,11 @@ void min::append_mesh(const min::sphere<T, min::vec3> &s, min::mesh<T, K> &m)
         vec4<T>(0, 0.382683, 0.923879, 1.0),
         vec4<T>(0, 0.92388, 0.382683, 1.0)};
 
-    // Scale the sphere points by radius
+    // Scale the sphere points by radius and move to center
     const T radius = s.get_radius();
-    const vec3<T> center = s.get_center();
-    for (auto &v : verts)
-    {
-        v *= radius;
-        v += center;
-    }
+    mat4<T> transform(s.get_center());
+    transform.set_scale(vec3<T>(radius, radius, radius));
+    transform_points(transform, verts.data(), verts.size());
 
     // Append vertices
     m.vertex.insert(m.vertex.end(), verts.begin(), verts.end());
@@ -19,6 +19,7 @@ limitations under the License.
 #include <initializer_list>
 
 #include "aabbox.h"
+#include "math/min/batch.h"
 #include "mesh.h"
 #include "sphere.h"
 
@@ -0,0 +1,288 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "cull_list.h"
+
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+template class min::cull_list<float>;
+template class min::cull_list<double>;
+
+template <typename T>
+void min::cull_list<T>::load_planes(const min::frustum<T> &f)
+{
+    // Copy the plane equations, n · x - c = d
+    const vec3<T> origin(0.0, 0.0, 0.0);
+    for (size_t i = 0; i < 6; i++)
+    {
+        const plane<T, vec3> &p = f.get_plane(i);
+        const vec3<T> &n = p.get_normal();
+        _nx[i] = n.x;
+        _ny[i] = n.y;
+        _nz[i] = n.z;
+        _c[i] = -p.get_distance(origin);
+    }
+}
+
+template <typename T>
+bool min::cull_list<T>::outside(const size_t i, const size_t p) const
+{
+    // Distance from plane of the closest box corner or sphere surface
+    const T d = _nx[p] * _x[i] + _ny[p] * _y[i] + _nz[p] * _z[i] - _c[p];
+    const T e = std::abs(_nx[p]) * _ex[i] + std::abs(_ny[p]) * _ey[i] + std::abs(_nz[p]) * _ez[i] + _r[i];
+
+    // A positive distance is outside the half space
+    return d - e > 0.0;
+}
+
+template <typename T>
+bool min::cull_list<T>::reject(const size_t i)
+{
+    // Test the plane that rejected this bound last time first
+    const uint8_t last = _last[i];
+    if (outside(i, last))
+    {
+        return true;
+    }
+
+    // Test the remaining planes and remember the rejecting plane
+    for (uint8_t p = 0; p < 6; p++)
+    {
+        if (p != last && outside(i, p))
+        {
+            _last[i] = p;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+void min::cull_list<T>::set(const size_t i, const min::vec3<T> &center, const min::vec3<T> &extent, const T radius)
+{
+    _x[i] = center.x;
+    _y[i] = center.y;
+    _z[i] = center.z;
+    _ex[i] = extent.x;
+    _ey[i] = extent.y;
+    _ez[i] = extent.z;
+    _r[i] = radius;
+}
+
+template <typename T>
+size_t min::cull_list<T>::add(const min::aabbox<T, min::vec3> &box)
+{
+    // Allocate a new bound
+    const size_t index = _x.size();
+    _x.resize(index + 1);
+    _y.resize(index + 1);
+    _z.resize(index + 1);
+    _ex.resize(index + 1);
+    _ey.resize(index + 1);
+    _ez.resize(index + 1);
+    _r.resize(index + 1);
+    _last.resize(index + 1, 0);
+
+    // Store the box
+    set(index, box);
+
+    return index;
+}
+
+template <typename T>
+size_t min::cull_list<T>::add(const min::sphere<T, min::vec3> &s)
+{
+    // Allocate a new bound
+    const size_t index = _x.size();
+    _x.resize(index + 1);
+    _y.resize(index + 1);
+    _z.resize(index + 1);
+    _ex.resize(index + 1);
+    _ey.resize(index + 1);
+    _ez.resize(index + 1);
+    _r.resize(index + 1);
+    _last.resize(index + 1, 0);
+
+    // Store the sphere
+    set(index, s);
+
+    return index;
+}
+
+template <typename T>
+void min::cull_list<T>::clear()
+{
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _ex.clear();
+    _ey.clear();
+    _ez.clear();
+    _r.clear();
+    _last.clear();
+    _visible.clear();
+}
+
+template <typename T>
+void min::cull_list<T>::cull(const min::frustum<T> &f)
+{
+    load_planes(f);
+
+    // Clear the visibility bits
+    const size_t size = _x.size();
+    _visible.assign((size + 7) / 8, 0);
+
+    // Set the bit of each bound that is not outside any plane
+    for (size_t i = 0; i < size; i++)
+    {
+        if (!reject(i))
+        {
+            _visible[i >> 3] |= (1 << (i & 7));
+        }
+    }
+}
+
+template <typename T>
+const std::vector<uint8_t> &min::cull_list<T>::get_visible() const
+{
+    return _visible;
+}
+
+template <typename T>
+bool min::cull_list<T>::is_visible(const size_t index) const
+{
+    return (_visible[index >> 3] >> (index & 7)) & 0x1;
+}
+
+template <typename T>
+void min::cull_list<T>::reserve(const size_t size)
+{
+    _x.reserve(size);
+    _y.reserve(size);
+    _z.reserve(size);
+    _ex.reserve(size);
+    _ey.reserve(size);
+    _ez.reserve(size);
+    _r.reserve(size);
+    _last.reserve(size);
+}
+
+template <typename T>
+void min::cull_list<T>::set(const size_t index, const min::aabbox<T, min::vec3> &box)
+{
+    // Boxes have zero radius
+    const vec3<T> &min = box.get_min();
+    const vec3<T> &max = box.get_max();
+    set(index, (min + max) * 0.5, (max - min) * 0.5, 0.0);
+}
+
+template <typename T>
+void min::cull_list<T>::set(const size_t index, const min::sphere<T, min::vec3> &s)
+{
+    // Spheres have zero extent
+    set(index, s.get_center(), vec3<T>(0.0, 0.0, 0.0), s.get_radius());
+}
+
+template <typename T>
+size_t min::cull_list<T>::size() const
+{
+    return _x.size();
+}
+
+#ifdef MGL_SIMD_SSE
+template <>
+void min::cull_list<float>::cull(const min::frustum<float> &f)
+{
+    load_planes(f);
+
+    // Clear the visibility bits
+    const size_t size = _x.size();
+    _visible.assign((size + 7) / 8, 0);
+
+    // Test four bounds at a time
+    const size_t end = size - (size % 4);
+    const __m128 zero = _mm_setzero_ps();
+    for (size_t i = 0; i < end; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(&_x[i]);
+        const __m128 y = _mm_loadu_ps(&_y[i]);
+        const __m128 z = _mm_loadu_ps(&_z[i]);
+        const __m128 ex = _mm_loadu_ps(&_ex[i]);
+        const __m128 ey = _mm_loadu_ps(&_ey[i]);
+        const __m128 ez = _mm_loadu_ps(&_ez[i]);
+        const __m128 r = _mm_loadu_ps(&_r[i]);
+
+        // Test each lane against the plane that rejected it last time
+        const uint8_t l0 = _last[i];
+        const uint8_t l1 = _last[i + 1];
+        const uint8_t l2 = _last[i + 2];
+        const uint8_t l3 = _last[i + 3];
+        __m128 nx = _mm_set_ps(_nx[l3], _nx[l2], _nx[l1], _nx[l0]);
+        __m128 ny = _mm_set_ps(_ny[l3], _ny[l2], _ny[l1], _ny[l0]);
+        __m128 nz = _mm_set_ps(_nz[l3], _nz[l2], _nz[l1], _nz[l0]);
+        __m128 c = _mm_set_ps(_c[l3], _c[l2], _c[l1], _c[l0]);
+
+        // Distance of the closest point to the plane minus the projected extent, abs(n) = n & ~sign
+        const auto out = [&x, &y, &z, &ex, &ey, &ez, &r, &zero](const __m128 nx, const __m128 ny, const __m128 nz, const __m128 c) {
+            const __m128 d = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_mul_ps(nz, z)), c);
+            const __m128 sign = _mm_set1_ps(-0.0);
+            const __m128 ax = _mm_mul_ps(_mm_andnot_ps(sign, nx), ex);
+            const __m128 ay = _mm_mul_ps(_mm_andnot_ps(sign, ny), ey);
+            const __m128 az = _mm_mul_ps(_mm_andnot_ps(sign, nz), ez);
+            const __m128 e = _mm_add_ps(_mm_add_ps(_mm_add_ps(ax, ay), az), r);
+            return _mm_movemask_ps(_mm_cmpgt_ps(_mm_sub_ps(d, e), zero));
+        };
+
+        // If all lanes are still rejected by their cached plane we are done
+        int rejected = out(nx, ny, nz, c);
+        if (rejected != 0xF)
+        {
+            // Test all planes on the remaining lanes
+            for (uint8_t p = 0; p < 6 && rejected != 0xF; p++)
+            {
+                nx = _mm_set1_ps(_nx[p]);
+                ny = _mm_set1_ps(_ny[p]);
+                nz = _mm_set1_ps(_nz[p]);
+                c = _mm_set1_ps(_c[p]);
+
+                // Remember the rejecting plane for newly rejected lanes
+                const int hit = out(nx, ny, nz, c) & ~rejected;
+                for (size_t k = 0; k < 4; k++)
+                {
+                    if ((hit >> k) & 0x1)
+                    {
+                        _last[i + k] = p;
+                    }
+                }
+                rejected |= hit;
+            }
+        }
+
+        // Four visible bits, i is a multiple of four
+        _visible[i >> 3] |= ((~rejected & 0xF) << (i & 7));
+    }
+
+    // Test the remaining bounds
+    for (size_t i = end; i < size; i++)
+    {
+        if (!reject(i))
+        {
+            _visible[i >> 3] |= (1 << (i & 7));
+        }
+    }
+}
+#endif
@@ -0,0 +1,79 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef CULL_LIST
+#define CULL_LIST
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "aabbox.h"
+#include "frustum.h"
+#include "math/min/utility.h"
+#include "math/min/vec3.h"
+#include "sphere.h"
+
+// Stores bounding volumes as a structure of arrays for culling many objects per frame
+// Boxes are stored as center and half extent with zero radius, spheres as center and radius with zero extent
+// Each bound remembers the last plane that rejected it, that plane is tested first on the next cull
+
+namespace min
+{
+
+template <typename T>
+class cull_list
+{
+  private:
+    std::vector<T> _x;
+    std::vector<T> _y;
+    std::vector<T> _z;
+    std::vector<T> _ex;
+    std::vector<T> _ey;
+    std::vector<T> _ez;
+    std::vector<T> _r;
+    std::vector<uint8_t> _last;
+    std::vector<uint8_t> _visible;
+    std::array<T, 6> _nx;
+    std::array<T, 6> _ny;
+    std::array<T, 6> _nz;
+    std::array<T, 6> _c;
+
+    void load_planes(const frustum<T>&);
+    bool outside(const size_t, const size_t) const;
+    bool reject(const size_t);
+    void set(const size_t, const vec3<T>&, const vec3<T>&, const T);
+
+  public:
+    cull_list() {}
+
+    size_t add(const aabbox<T, vec3>&);
+    size_t add(const sphere<T, vec3>&);
+    void clear();
+    void cull(const frustum<T>&);
+    const std::vector<uint8_t> &get_visible() const;
+    bool is_visible(const size_t) const;
+    void reserve(const size_t);
+    void set(const size_t, const aabbox<T, vec3>&);
+    void set(const size_t, const sphere<T, vec3>&);
+    size_t size() const;
+};
+
+#ifdef MGL_SIMD_SSE
+template <>
+void cull_list<float>::cull(const frustum<float>&);
+#endif
+}
+
+#endif
@@ -24,12 +24,12 @@ bool min::frustum<T>::not_between_plane(const min::vec3<T> &min, const min::vec3
     const vec3<T> &n = pl.get_normal();
 
     // Get the excluding corner of the range to the plane
-    if (n.x() < 0.0)
-        p.x(max.x());
-    if (n.y() < 0.0)
-        p.y(max.y());
-    if (n.z() < 0.0)
-        p.z(max.z());
+    if (n.x < 0.0)
+        p.x = max.x;
+    if (n.y < 0.0)
+        p.y = max.y;
+    if (n.z < 0.0)
+        p.z = max.z;
 
     // If the excluding corner is outside the plane half space
     // it can't be between the frustum planes
@@ -53,10 +53,10 @@ template <class T>
 void min::frustum<T>::orthographic_frustum()
 {
     // This frustum is symmetric and thus is simplified from the generic equations
-    const T r = _near.x();
-    const T t = _near.y();
-    const T near = _near.z();
-    const T far = _far.z();
+    const T r = _near.x;
+    const T t = _near.y;
+    const T near = _near.z;
+    const T far = _far.z;
 
     // Create orthographic projection matrix
     _proj = mat4<T>(r, t, near, far);
@@ -66,10 +66,10 @@ template <class T>
 void min::frustum<T>::perspective_frustum()
 {
     // This frustum is symmetric and thus is simplified from the generic equations
-    const T r = _near.x();
-    const T t = _near.y();
-    const T near = _near.z();
-    const T far = _far.z();
+    const T r = _near.x;
+    const T t = _near.y;
+    const T near = _near.z;
+    const T far = _far.z;
     const T idz = 1.0 / (far - near);
 
     // Set symmetric matrix values
@@ -100,18 +100,18 @@ void min::frustum<T>::update()
     const T tang = std::tan(deg_to_rad2(_fov)) * _zoom;
 
     // Calculate near planes
-    T ny = _near.z() * tang;
+    T ny = _near.z * tang;
     T nx = ny * _ratio;
 
     // Calculate far planes
-    T fy = _far.z() * tang;
+    T fy = _far.z * tang;
     T fx = fy * _ratio;
 
     // Update the interval vectors
-    _near.x(nx);
-    _near.y(ny);
-    _far.x(fx);
-    _far.y(fy);
+    _near.x = nx;
+    _near.y = ny;
+    _far.x = fx;
+    _far.y = fy;
 }
 
 
@@ -185,6 +185,12 @@ const min::vec3<T> &min::frustum<T>::get_center() const
     return _center;
 }
 
+template <class T>
+const min::plane<T, min::vec3> &min::frustum<T>::get_plane(const size_t index) const
+{
+    return _plane[index];
+}
+
 template <class T>
 const min::vec3<T> &min::frustum<T>::get_right() const
 {
@@ -236,7 +242,7 @@ const min::mat4<T> &min::frustum<T>::look_at(const min::vec3<T> &eye, const min:
 {
     // right: up x forward - left handed coordinates
     _right = up.cross(forward);
-    _right.y(0.0);
+    _right.y = 0.0;
     _right.normalize();
 
     // up: = forward x right - left handed coordinates
@@ -244,18 +250,18 @@ const min::mat4<T> &min::frustum<T>::look_at(const min::vec3<T> &eye, const min:
     up = forward.cross(_right);
 
     // near corners: top left, top right, bottom left, bottom right
-    const vec3<T> near = eye + forward * _near.z();
-    vec3<T> tl = near + up * _near.y() - _right * _near.x();
-    vec3<T> tr = near + up * _near.y() + _right * _near.x();
-    vec3<T> bl = near - up * _near.y() - _right * _near.x();
-    vec3<T> br = near - up * _near.y() + _right * _near.x();
+    const vec3<T> near = eye + forward * _near.z;
+    vec3<T> tl = near + up * _near.y - _right * _near.x;
+    vec3<T> tr = near + up * _near.y + _right * _near.x;
+    vec3<T> bl = near - up * _near.y - _right * _near.x;
+    vec3<T> br = near - up * _near.y + _right * _near.x;
 
     // far corners: top left, top right, bottom left, bottom right
-    const vec3<T> far = eye + forward * _far.z();
-    vec3<T> ftl = far + up * _far.y() - _right * _far.x();
-    vec3<T> ftr = far + up * _far.y() + _right * _far.x();
-    vec3<T> fbl = far - up * _far.y() - _right * _far.x();
-    vec3<T> fbr = far - up * _far.y() + _right * _far.x();
+    const vec3<T> far = eye + forward * _far.z;
+    vec3<T> ftl = far + up * _far.y - _right * _far.x;
+    vec3<T> ftr = far + up * _far.y + _right * _far.x;
+    vec3<T> fbl = far - up * _far.y - _right * _far.x;
+    vec3<T> fbr = far - up * _far.y + _right * _far.x;
 
     // planes: top, bottom, left: all normals point inside
     _plane[0] = plane<T, vec3>(tr, tl, ftl);
@@ -324,14 +330,14 @@ void min::frustum<T>::set_fov(const T fov)
 template <class T>
 void min::frustum<T>::set_near(const T near)
 {
-    _near.z(near);
+    _near.z = near;
     _dirty = true;
 }
 
 template <class T>
 void min::frustum<T>::set_far(const T far)
 {
-    _far.z(far);
+    _far.z = far;
     _dirty = true;
 }
 
@@ -56,6 +56,7 @@ class frustum
     bool between(const vec3<T>&, const vec3<T>&) const;
     vec3<T> closest_point(const vec3<T>&) const;
     const vec3<T> &get_center() const;
+    const plane<T, vec3> &get_plane(const size_t) const;
     const vec3<T> &get_right() const;
     const mat4<T> &orthographic();
     const mat4<T> &perspective();
@@ -17,6 +17,10 @@ limitations under the License.
 
 template class min::mesh<double, unsigned short>;
 template class min::mesh<float, unsigned int>;
+template void min::mesh<double, unsigned short>::deserialize(const std::vector<uint8_t>&);
+template void min::mesh<double, unsigned short>::deserialize(const min::mem_file&);
+template void min::mesh<float, unsigned int>::deserialize(const std::vector<uint8_t>&);
+template void min::mesh<float, unsigned int>::deserialize(const min::mem_file&);
 
 template <typename T, typename K>
 void min::mesh<T,K>::calculate_normal(const size_t a, const size_t b, const size_t c)
@@ -286,31 +290,32 @@ template <typename T, typename K>
 template <class M>
 void min::mesh<T,K>::deserialize(const M &stream)
 {
-    size_t next = 0;
+    // Read each attribute array in bulk directly into the mesh
+    stream_cursor cursor(stream);
 
     // Read in vertices
-    vertex = read_le_vector_vec4<T>(stream, next);
+    cursor.read_le_vector_vec4<T>(vertex);
 
     // Read in uvs
-    uv = read_le_vector_vec2<T>(stream, next);
+    cursor.read_le_vector_vec2<T>(uv);
 
     // Read in normals
-    normal = read_le_vector_vec3<T>(stream, next);
+    cursor.read_le_vector_vec3<T>(normal);
 
     // Read in tangents
-    tangent = read_le_vector_vec3<T>(stream, next);
+    cursor.read_le_vector_vec3<T>(tangent);
 
     // Read in tangents
-    bitangent = read_le_vector_vec3<T>(stream, next);
+    cursor.read_le_vector_vec3<T>(bitangent);
 
     // Read in indices
-    index = read_le_vector<K>(stream, next);
+    cursor.read_le_vector<K>(index);
 
     // Read in bone index
-    bone_index = read_le_vector_vec4<T>(stream, next);
+    cursor.read_le_vector_vec4<T>(bone_index);
 
     // Read in bone index
-    bone_weight = read_le_vector_vec4<T>(stream, next);
+    cursor.read_le_vector_vec4<T>(bone_weight);
 }
 
 template <typename T, typename K>
@@ -0,0 +1,146 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "batch.h"
+
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+template void min::multiply_matrices(const min::mat4<float>*, const min::mat4<float>*, min::mat4<float>*, const size_t);
+template void min::multiply_matrices(const min::mat4<double>*, const min::mat4<double>*, min::mat4<double>*, const size_t);
+
+template <typename T>
+void min::multiply_matrices(const min::mat4<T> *a, const min::mat4<T> *b, min::mat4<T> *out, const size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+template void min::multiply_matrices(const min::mat3x4<float>*, const min::mat3x4<float>*, min::mat3x4<float>*, const size_t);
+template void min::multiply_matrices(const min::mat3x4<double>*, const min::mat3x4<double>*, min::mat3x4<double>*, const size_t);
+
+template <typename T>
+void min::multiply_matrices(const min::mat3x4<T> *a, const min::mat3x4<T> *b, min::mat3x4<T> *out, const size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+template void min::rotate_points(const min::quat<float>&, min::vec3<float>*, const size_t);
+template void min::rotate_points(const min::quat<double>&, min::vec3<double>*, const size_t);
+
+template <typename T>
+void min::rotate_points(const min::quat<T> &q, min::vec3<T> *v, const size_t size)
+{
+    // Convert the quaternion to a rotation matrix once, this is cheaper than q * p * q' per vector
+    const mat3<T> r(q);
+    for (size_t i = 0; i < size; i++)
+    {
+        v[i] = r * v[i];
+    }
+}
+
+template void min::transform_points(const min::mat4<float>&, min::vec4<float>*, const size_t);
+template void min::transform_points(const min::mat4<double>&, min::vec4<double>*, const size_t);
+
+template <typename T>
+void min::transform_points(const min::mat4<T> &m, min::vec4<T> *v, const size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        v[i] = m * v[i];
+    }
+}
+
+template void min::translate_points(const min::vec4<float>&, min::vec4<float>*, const size_t);
+template void min::translate_points(const min::vec4<double>&, min::vec4<double>*, const size_t);
+
+template <typename T>
+void min::translate_points(const min::vec4<T> &t, min::vec4<T> *v, const size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        v[i] += t;
+    }
+}
+
+#ifdef MGL_SIMD_SSE
+// The float kernels read vec4 and mat4 as packed floats, mat4 is stored row by row
+static_assert(sizeof(min::vec4<float>) == 4 * sizeof(float), "vec4<float> must be packed");
+static_assert(sizeof(min::mat4<float>) == 16 * sizeof(float), "mat4<float> must be packed");
+
+template <>
+void min::multiply_matrices(const min::mat4<float> *a, const min::mat4<float> *b, min::mat4<float> *out, const size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        const float *A = reinterpret_cast<const float *>(&a[i]);
+        const float *B = reinterpret_cast<const float *>(&b[i]);
+        float *C = reinterpret_cast<float *>(&out[i]);
+
+        // Load all rows of B before writing, so out may alias b
+        const __m128 b0 = _mm_loadu_ps(B);
+        const __m128 b1 = _mm_loadu_ps(B + 4);
+        const __m128 b2 = _mm_loadu_ps(B + 8);
+        const __m128 b3 = _mm_loadu_ps(B + 12);
+
+        // Each output row only reads the same row of A, so out may alias a
+        for (size_t r = 0; r < 16; r += 4)
+        {
+            const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[r]), b0), _mm_mul_ps(_mm_set1_ps(A[r + 1]), b1));
+            const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[r + 2]), b2), _mm_mul_ps(_mm_set1_ps(A[r + 3]), b3));
+            _mm_storeu_ps(C + r, _mm_add_ps(xy, zw));
+        }
+    }
+}
+
+template <>
+void min::transform_points(const min::mat4<float> &m, min::vec4<float> *v, const size_t size)
+{
+    // Keep the matrix rows in registers for the whole array
+    const float *M = reinterpret_cast<const float *>(&m);
+    const __m128 r0 = _mm_loadu_ps(M);
+    const __m128 r1 = _mm_loadu_ps(M + 4);
+    const __m128 r2 = _mm_loadu_ps(M + 8);
+    const __m128 r3 = _mm_loadu_ps(M + 12);
+
+    float *V = reinterpret_cast<float *>(v);
+    const size_t end = size * 4;
+    for (size_t i = 0; i < end; i += 4)
+    {
+        const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(V[i]), r0), _mm_mul_ps(_mm_set1_ps(V[i + 1]), r1));
+        const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(V[i + 2]), r2), _mm_mul_ps(_mm_set1_ps(V[i + 3]), r3));
+        _mm_storeu_ps(V + i, _mm_add_ps(xy, zw));
+    }
+}
+
+template <>
+void min::translate_points(const min::vec4<float> &t, min::vec4<float> *v, const size_t size)
+{
+    // Zero w so it is unchanged
+    const __m128 d = _mm_set_ps(0.0, t.z(), t.y(), t.x());
+
+    float *V = reinterpret_cast<float *>(v);
+    const size_t end = size * 4;
+    for (size_t i = 0; i < end; i += 4)
+    {
+        _mm_storeu_ps(V + i, _mm_add_ps(_mm_loadu_ps(V + i), d));
+    }
+}
+#endif
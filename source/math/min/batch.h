@@ -0,0 +1,64 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __BATCH__
+#define __BATCH__
+
+#include <cstddef>
+
+#include "mat3.h"
+#include "mat3x4.h"
+#include "mat4.h"
+#include "quat.h"
+#include "utility.h"
+#include "vec3.h"
+#include "vec4.h"
+
+// Batch kernels apply one operation to a contiguous array in a single pass
+// Prefer these over per element loops when transforming many vertices or bones
+
+namespace min
+{
+
+// Multiplies arrays of matrices, out[i] = a[i] * b[i], out may alias a or b
+template <typename T>
+void multiply_matrices(const mat4<T>*, const mat4<T>*, mat4<T>*, const size_t);
+
+// Multiplies arrays of affine matrices, out[i] = a[i] * b[i], out may alias a or b
+template <typename T>
+void multiply_matrices(const mat3x4<T>*, const mat3x4<T>*, mat3x4<T>*, const size_t);
+
+// Rotates an array of vectors by a quaternion in place
+template <typename T>
+void rotate_points(const quat<T>&, vec3<T>*, const size_t);
+
+// Transforms an array of vectors by a matrix in place
+template <typename T>
+void transform_points(const mat4<T>&, vec4<T>*, const size_t);
+
+// Translates an array of vectors in place, the w component is unchanged
+template <typename T>
+void translate_points(const vec4<T>&, vec4<T>*, const size_t);
+
+#ifdef MGL_SIMD_SSE
+template <>
+void multiply_matrices(const mat4<float>*, const mat4<float>*, mat4<float>*, const size_t);
+template <>
+void transform_points(const mat4<float>&, vec4<float>*, const size_t);
+template <>
+void translate_points(const vec4<float>&, vec4<float>*, const size_t);
+#endif
+}
+
+#endif
@@ -20,6 +20,8 @@ namespace min
 template <typename T>
 class mat2;
 template <typename T>
+class mat3x4;
+template <typename T>
 class mat4;
 template <typename T>
 class quat;
@@ -58,6 +60,7 @@ namespace min
 template <typename T>
 class mat3
 {
+    friend class mat3x4<T>;
     friend class mat4<T>;
 
   private:
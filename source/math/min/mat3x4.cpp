@@ -0,0 +1,194 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "mat3x4.h"
+
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+template class min::mat3x4<float>;
+template class min::mat3x4<double>;
+
+template <typename T>
+min::vec4<T> min::mat3x4<T>::one() const
+{
+    return vec4<T>(_a, _b, _c, _d);
+}
+
+template <typename T>
+min::vec4<T> min::mat3x4<T>::two() const
+{
+    return vec4<T>(_e, _f, _g, _h);
+}
+
+template <typename T>
+min::vec4<T> min::mat3x4<T>::three() const
+{
+    return vec4<T>(_i, _j, _k, _l);
+}
+
+template <typename T>
+min::mat3x4<T> min::mat3x4<T>::operator*(const min::mat3x4<T> &A) const
+{
+    // Apply this then A, the implicit last row removes a quarter of the mat4 products
+    mat3x4<T> out;
+    out._a = A._a * _a + A._b * _e + A._c * _i;
+    out._b = A._a * _b + A._b * _f + A._c * _j;
+    out._c = A._a * _c + A._b * _g + A._c * _k;
+    out._d = A._a * _d + A._b * _h + A._c * _l + A._d;
+    out._e = A._e * _a + A._f * _e + A._g * _i;
+    out._f = A._e * _b + A._f * _f + A._g * _j;
+    out._g = A._e * _c + A._f * _g + A._g * _k;
+    out._h = A._e * _d + A._f * _h + A._g * _l + A._h;
+    out._i = A._i * _a + A._j * _e + A._k * _i;
+    out._j = A._i * _b + A._j * _f + A._k * _j;
+    out._k = A._i * _c + A._j * _g + A._k * _k;
+    out._l = A._i * _d + A._j * _h + A._k * _l + A._l;
+
+    return out;
+}
+
+template <typename T>
+min::mat3x4<T> &min::mat3x4<T>::operator*=(const min::mat3x4<T> &A)
+{
+    // The product is computed into a temporary so aliasing A is safe
+    *this = this->operator*(A);
+
+    return *this;
+}
+
+template <typename T>
+min::vec3<T> min::mat3x4<T>::operator*(const min::vec3<T> &A) const
+{
+    // Transforms a point, w is implicitly one
+    T x = _a * A.x + _b * A.y + _c * A.z + _d;
+    T y = _e * A.x + _f * A.y + _g * A.z + _h;
+    T z = _i * A.x + _j * A.y + _k * A.z + _l;
+
+    return vec3<T>(x, y, z);
+}
+
+template <typename T>
+min::vec4<T> min::mat3x4<T>::operator*(const min::vec4<T> &A) const
+{
+    T x = _a * A.x() + _b * A.y() + _c * A.z() + _d * A.w();
+    T y = _e * A.x() + _f * A.y() + _g * A.z() + _h * A.w();
+    T z = _i * A.x() + _j * A.y() + _k * A.z() + _l * A.w();
+
+    return vec4<T>(x, y, z, A.w());
+}
+
+template <typename T>
+min::vec3<T> min::mat3x4<T>::get_translation() const
+{
+    return vec3<T>(_d, _h, _l);
+}
+
+template <typename T>
+min::mat3x4<T> &min::mat3x4<T>::set_translation(const min::vec3<T> &t)
+{
+    _d = t.x;
+    _h = t.y;
+    _l = t.z;
+
+    return *this;
+}
+
+template <typename T>
+bool min::mat3x4<T>::invert()
+{
+    // Invert the 3x3 block with cofactors
+    T a = _f * _k - _g * _j;
+    T b = _c * _j - _b * _k;
+    T c = _b * _g - _c * _f;
+    T e = _g * _i - _e * _k;
+    T f = _a * _k - _c * _i;
+    T g = _c * _e - _a * _g;
+    T i = _e * _j - _f * _i;
+    T j = _b * _i - _a * _j;
+    T k = _a * _f - _b * _e;
+
+    T det = _a * a + _b * e + _c * i;
+
+    if (std::abs(det) <= var<T>::TOL_REL)
+    {
+        return false;
+    }
+
+    det = 1.0 / det;
+    a *= det;
+    b *= det;
+    c *= det;
+    e *= det;
+    f *= det;
+    g *= det;
+    i *= det;
+    j *= det;
+    k *= det;
+
+    // The inverse translation is the inverted block applied to the negated translation
+    const T d = -(a * _d + b * _h + c * _l);
+    const T h = -(e * _d + f * _h + g * _l);
+    const T l = -(i * _d + j * _h + k * _l);
+
+    _a = a;
+    _b = b;
+    _c = c;
+    _d = d;
+    _e = e;
+    _f = f;
+    _g = g;
+    _h = h;
+    _i = i;
+    _j = j;
+    _k = k;
+    _l = l;
+
+    return true;
+}
+
+template <typename T>
+min::vec4<T> min::mat3x4<T>::transform(const min::vec4<T> &v) const
+{
+    // This matches mat4<T> API!
+    return this->operator*(v);
+}
+
+#ifdef MGL_SIMD_SSE
+template <>
+min::mat3x4<float> min::mat3x4<float>::operator*(const min::mat3x4<float> &A) const
+{
+    // Load the rows of this matrix, the implicit last row only contributes to w
+    const __m128 r0 = _mm_loadu_ps(&_a);
+    const __m128 r1 = _mm_loadu_ps(&_e);
+    const __m128 r2 = _mm_loadu_ps(&_i);
+    const __m128 r3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+    // Each row of the product is a linear combination of the rows of this matrix
+    const auto row = [&r0, &r1, &r2, &r3](const float x, const float y, const float z, const float w) {
+        const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(x), r0), _mm_mul_ps(_mm_set1_ps(y), r1));
+        const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(z), r2), _mm_mul_ps(_mm_set1_ps(w), r3));
+        return _mm_add_ps(xy, zw);
+    };
+
+    mat3x4<float> out;
+    _mm_storeu_ps(&out._a, row(A._a, A._b, A._c, A._d));
+    _mm_storeu_ps(&out._e, row(A._e, A._f, A._g, A._h));
+    _mm_storeu_ps(&out._i, row(A._i, A._j, A._k, A._l));
+
+    return out;
+}
+#endif
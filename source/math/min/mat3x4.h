@@ -0,0 +1,112 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __MATRIX3X4__
+#define __MATRIX3X4__
+
+namespace min
+{
+template <typename T>
+class mat3;
+template <typename T>
+class mat4;
+template <typename T>
+class quat;
+template <typename T>
+class vec3;
+template <typename T>
+class vec4;
+}
+
+#include <cmath>
+#include "mat3.h"
+#include "mat4.h"
+#include "quat.h"
+#include "utility.h"
+#include "vec3.h"
+#include "vec4.h"
+
+// This is an affine 3D transformation, a mat4<T> with the implicit last row (0, 0, 0, 1)
+// It is stored as the three rows of the transform, the last column being the translation
+// Each row maps directly to a vec4 uniform, so bones upload in 48 bytes instead of 64
+// Multiplication follows mat4<T>, A * B applies A then B
+
+namespace min
+{
+
+template <typename T>
+class mat3x4
+{
+    friend class mat4<T>;
+
+  private:
+    T _a;
+    T _b;
+    T _c;
+    T _d;
+    T _e;
+    T _f;
+    T _g;
+    T _h;
+    T _i;
+    T _j;
+    T _k;
+    T _l;
+
+  public:
+    // constructs an identity matrix
+    mat3x4()
+        : _a(1.0), _b(0.0), _c(0.0), _d(0.0), _e(0.0), _f(1.0), _g(0.0), _h(0.0), _i(0.0), _j(0.0), _k(1.0), _l(0.0) {}
+
+    // convenience constructor for direct loading, row by row
+    mat3x4(T a, T b, T c, T d, T e, T f, T g, T h, T i, T j, T k, T l)
+        : _a(a), _b(b), _c(c), _d(d), _e(e), _f(f), _g(g), _h(h), _i(i), _j(j), _k(k), _l(l) {}
+
+    // constructs a translation matrix
+    mat3x4(const vec3<T> &t)
+        : _a(1.0), _b(0.0), _c(0.0), _d(t.x), _e(0.0), _f(1.0), _g(0.0), _h(t.y), _i(0.0), _j(0.0), _k(1.0), _l(t.z) {}
+
+    // constructs a 3D rotation matrix
+    mat3x4(const mat3<T> &r)
+        : _a(r._a), _b(r._d), _c(r._g), _d(0.0), _e(r._b), _f(r._e), _g(r._h), _h(0.0), _i(r._c), _j(r._f), _k(r._i), _l(0.0) {}
+
+    // constructs a matrix that first rotates then translates in 3D
+    mat3x4(const vec3<T> &t, const mat3<T> &r)
+        : _a(r._a), _b(r._d), _c(r._g), _d(t.x), _e(r._b), _f(r._e), _g(r._h), _h(t.y), _i(r._c), _j(r._f), _k(r._i), _l(t.z) {}
+
+    // drops the last row of a mat4, which must be affine
+    explicit mat3x4(const mat4<T> &m)
+        : _a(m._a), _b(m._e), _c(m._i), _d(m._m), _e(m._b), _f(m._f), _g(m._j), _h(m._n), _i(m._c), _j(m._g), _k(m._k), _l(m._o) {}
+
+    vec4<T> one() const;
+    vec4<T> two() const;
+    vec4<T> three() const;
+    mat3x4<T> operator*(const mat3x4<T>&) const;
+    mat3x4<T> &operator*=(const mat3x4<T>&);
+    vec3<T> operator*(const vec3<T>&) const;
+    vec4<T> operator*(const vec4<T>&) const;
+    vec3<T> get_translation() const;
+    mat3x4<T> &set_translation(const vec3<T>&);
+    bool invert();
+    vec4<T> transform(const vec4<T>&) const;
+
+};
+
+#ifdef MGL_SIMD_SSE
+template <>
+mat3x4<float> mat3x4<float>::operator*(const mat3x4<float>&) const;
+#endif
+}
+
+#endif
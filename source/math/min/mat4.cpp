@@ -14,10 +14,19 @@ limitations under the License.
 */
 
 #include "mat4.h"
+#include "mat3x4.h"
+
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
 
 template class min::mat4<float>;
 template class min::mat4<double>;
 
+template <typename T>
+min::mat4<T>::mat4(const min::mat3x4<T> &m)
+    : _a(m._a), _b(m._e), _c(m._i), _d(0.0), _e(m._b), _f(m._f), _g(m._j), _h(0.0), _i(m._c), _j(m._g), _k(m._k), _l(0.0), _m(m._d), _n(m._h), _o(m._l), _p(1.0) {}
+
 template <typename T>
 void min::mat4<T>::one(vec4<T> &v)
 {
@@ -349,3 +358,151 @@ min::mat4<T> min::mat4<T>::transpose_multiply(const min::mat4<T> &A) const
 
     return out;
 }
+
+#ifdef MGL_SIMD_SSE
+template <>
+min::mat4<float> min::mat4<float>::operator*(const min::mat4<float> &A) const
+{
+    // Load the rows of A
+    const __m128 r0 = _mm_loadu_ps(&A._a);
+    const __m128 r1 = _mm_loadu_ps(&A._e);
+    const __m128 r2 = _mm_loadu_ps(&A._i);
+    const __m128 r3 = _mm_loadu_ps(&A._m);
+
+    // Each row of the product is a linear combination of the rows of A
+    const auto row = [&r0, &r1, &r2, &r3](const float x, const float y, const float z, const float w) {
+        const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(x), r0), _mm_mul_ps(_mm_set1_ps(y), r1));
+        const __m128 zw = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(z), r2), _mm_mul_ps(_mm_set1_ps(w), r3));
+        return _mm_add_ps(xy, zw);
+    };
+
+    mat4<float> out;
+    _mm_storeu_ps(&out._a, row(_a, _b, _c, _d));
+    _mm_storeu_ps(&out._e, row(_e, _f, _g, _h));
+    _mm_storeu_ps(&out._i, row(_i, _j, _k, _l));
+    _mm_storeu_ps(&out._m, row(_m, _n, _o, _p));
+
+    return out;
+}
+
+template <>
+min::mat4<float> &min::mat4<float>::operator*=(const min::mat4<float> &A)
+{
+    // The product is computed into a temporary so aliasing A is safe
+    *this = this->operator*(A);
+
+    return *this;
+}
+
+template <>
+min::vec4<float> min::mat4<float>::operator*(const min::vec4<float> &A) const
+{
+    // The output is a linear combination of the rows scaled by each component of A
+    const __m128 x = _mm_mul_ps(_mm_set1_ps(A.x()), _mm_loadu_ps(&_a));
+    const __m128 y = _mm_mul_ps(_mm_set1_ps(A.y()), _mm_loadu_ps(&_e));
+    const __m128 z = _mm_mul_ps(_mm_set1_ps(A.z()), _mm_loadu_ps(&_i));
+    const __m128 w = _mm_mul_ps(_mm_set1_ps(A.w()), _mm_loadu_ps(&_m));
+
+    // Store the result
+    float out[4];
+    _mm_storeu_ps(out, _mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)));
+
+    return vec4<float>(out[0], out[1], out[2], out[3]);
+}
+
+template <>
+bool min::mat4<float>::invert()
+{
+    // Cramer's rule on the transposed matrix, see Intel AP-928
+    const __m128 t0 = _mm_loadu_ps(&_a);
+    const __m128 t1 = _mm_loadu_ps(&_e);
+    const __m128 t2 = _mm_loadu_ps(&_i);
+    const __m128 t3 = _mm_loadu_ps(&_m);
+
+    // Transpose into row0..row3, with row1 and row3 rotated by two components
+    __m128 tmp = _mm_movelh_ps(t0, t1);
+    __m128 row1 = _mm_movelh_ps(t2, t3);
+    const __m128 row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+    row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+    tmp = _mm_movehl_ps(t1, t0);
+    __m128 row3 = _mm_movehl_ps(t3, t2);
+    __m128 row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+    row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+    // Cofactors
+    __m128 minor0, minor1, minor2, minor3;
+
+    tmp = _mm_mul_ps(row2, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = _mm_mul_ps(row1, tmp);
+    minor1 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+    minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+    minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+    tmp = _mm_mul_ps(row1, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+    minor3 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+    minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+    minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+    tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+    minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+    minor2 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+    minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+    minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+    tmp = _mm_mul_ps(row0, row1);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+    minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+    tmp = _mm_mul_ps(row0, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+    minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+    minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+    tmp = _mm_mul_ps(row0, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+    minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+    // Determinant
+    __m128 det = _mm_mul_ps(row0, minor0);
+    det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+    det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+    const float d = _mm_cvtss_f32(det);
+
+    // Singular matrix is left unchanged
+    if (std::abs(d) <= var<float>::TOL_REL)
+    {
+        return false;
+    }
+
+    // Scale the adjugate by the inverse determinant
+    const __m128 inv = _mm_set1_ps(1.0 / d);
+    _mm_storeu_ps(&_a, _mm_mul_ps(inv, minor0));
+    _mm_storeu_ps(&_e, _mm_mul_ps(inv, minor1));
+    _mm_storeu_ps(&_i, _mm_mul_ps(inv, minor2));
+    _mm_storeu_ps(&_m, _mm_mul_ps(inv, minor3));
+
+    return true;
+}
+#endif
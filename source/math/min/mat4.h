@@ -20,6 +20,8 @@ namespace min
 template <typename T>
 class mat3;
 template <typename T>
+class mat3x4;
+template <typename T>
 class quat;
 template <typename T>
 class vec3;
@@ -48,6 +50,8 @@ namespace min
 template <typename T>
 class mat4
 {
+    friend class mat3x4<T>;
+
   private:
     T _a;
     T _b;
@@ -95,6 +99,9 @@ class mat4
     mat4(const T dx, const T dy, const T near, const T far)
         : _a(1.0 / dx), _b(0.0), _c(0.0), _d(0.0), _e(0.0), _f(1.0 / dy), _g(0.0), _h(0.0), _i(0.0), _j(0.0), _k(-2.0 / (far - near)), _l((far + near) / (far - near)), _m(0.0), _n(0.0), _o(0.0), _p(1.0) {}
 
+    // expands an affine matrix with the last row (0, 0, 0, 1)
+    mat4(const mat3x4<T>&);
+
 
     void one(vec4<T>&);
     void two(vec4<T>&);
@@ -117,6 +124,17 @@ class mat4
     mat4<T> transpose_multiply(const mat4<T>&) const;
 
 };
+
+#ifdef MGL_SIMD_SSE
+template <>
+mat4<float> mat4<float>::operator*(const mat4<float>&) const;
+template <>
+mat4<float> &mat4<float>::operator*=(const mat4<float>&);
+template <>
+vec4<float> mat4<float>::operator*(const vec4<float>&) const;
+template <>
+bool mat4<float>::invert();
+#endif
 }
 
 #endif
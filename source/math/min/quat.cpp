@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "quat.h"
 
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
 template class min::quat<float>;
 template class min::quat<double>;
 
@@ -213,6 +217,33 @@ T min::quat<T>::magnitude() const
     return sqrt(_w * _w + _x * _x + _y * _y + _z * _z);
 }
 
+// Normalized lerp with a correction to the interpolation parameter so it tracks slerp
+// Takes the shortest path, max error against slerp is 1E-3 radians, no trig required
+
+template <typename T>
+min::quat<T> min::quat<T>::nlerp(const min::quat<T> &v0, const min::quat<T> &v1, const T t)
+{
+    const T cos_theta = v0.dot(v1);
+    const T d = std::abs(cos_theta);
+
+    // Cubic fit of the correction for the angle between v0 and v1
+    const T A = 1.0904 + d * (-3.2452 + d * (3.55645 - d * 1.43519));
+    const T B = 0.848013 + d * (-1.06021 + d * 0.215638);
+    const T h = t - 0.5;
+    const T k = A * h * h + B;
+    const T ct = t + t * h * (t - 1.0) * k;
+
+    // Flip v1 if needed to take the shortest path
+    const T t0 = 1.0 - ct;
+    const T t1 = (cos_theta < 0.0) ? -ct : ct;
+
+    const T w = v0.w() * t0 + v1.w() * t1;
+    const T x = v0.x() * t0 + v1.x() * t1;
+    const T y = v0.y() * t0 + v1.y() * t1;
+    const T z = v0.z() * t0 + v1.z() * t1;
+    return quat<T>(w, x, y, z).normalize();
+}
+
 template <typename T>
 min::quat<T> &min::quat<T>::normalize()
 {
@@ -335,3 +366,36 @@ void min::quat<T>::z(const T z)
 {
     _z = z;
 }
+
+#ifdef MGL_SIMD_SSE
+template <>
+min::quat<float> min::quat<float>::operator*(const min::quat<float> &b) const
+{
+    // Components are stored (w, x, y, z)
+    const __m128 q = _mm_loadu_ps(&_w);
+
+    // Columns of the product scaled by each component of b
+    const __m128 cw = q;
+    const __m128 cx = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.0, 0.0, 0.0, -0.0));
+    const __m128 cy = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(0.0, 0.0, -0.0, -0.0));
+    const __m128 cz = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(0.0, -0.0, 0.0, -0.0));
+
+    // Sum the scaled columns
+    const __m128 wx = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(b._w), cw), _mm_mul_ps(_mm_set1_ps(b._x), cx));
+    const __m128 yz = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(b._y), cy), _mm_mul_ps(_mm_set1_ps(b._z), cz));
+
+    quat<float> out;
+    _mm_storeu_ps(&out._w, _mm_add_ps(wx, yz));
+
+    return out;
+}
+
+template <>
+min::quat<float> &min::quat<float>::operator*=(const min::quat<float> &b)
+{
+    // The product is computed into a temporary so aliasing b is safe
+    *this = this->operator*(b);
+
+    return *this;
+}
+#endif
@@ -58,6 +58,7 @@ class quat
     static quat<T> lerp(const quat<T>&, const quat<T>&, const T);
     static quat<T> interpolate(const quat<T>&, const quat<T>&, const T);
     T magnitude() const;
+    static quat<T> nlerp(const quat<T>&, const quat<T>&, const T);
     quat<T> &normalize();
     static quat<T> slerp(const quat<T>&, const quat<T>&, const T);
     vec3<T> transform(const vec3<T>&) const;
@@ -71,6 +72,13 @@ class quat
     T z() const;
     void z(const T);
 };
+
+#ifdef MGL_SIMD_SSE
+template <>
+quat<float> quat<float>::operator*(const quat<float>&) const;
+template <>
+quat<float> &quat<float>::operator*=(const quat<float>&);
+#endif
 }
 
 #endif
@@ -31,6 +31,9 @@ min::tran3<T>::tran3(const min::vec3<T> &t, const min::quat<T> &r) : _m(t, r) {}
 template <typename T>
 min::tran3<T>::tran3(const min::vec3<T> &t, const min::quat<T> &r, const min::vec3<T> &s) : _m(t, r) { scale(s); }
 
+template <typename T>
+min::tran3<T>::tran3(const min::mat3x4<T> &m) : _m(m) {}
+
 template <typename T>
 min::tran3<T> &min::tran3<T>::translate(const T x, const T y, const T z)
 {
@@ -113,6 +116,13 @@ min::vec4<T> min::tran3<T>::transform(const min::vec4<T> &v) const
     return _m * v;
 }
 
+template <typename T>
+min::mat3x4<T> min::tran3<T>::affine() const
+{
+    // Drops the last row, only valid if the transform was not transposed
+    return mat3x4<T>(_m);
+}
+
 template <typename T>
 const min::mat4<T> &min::tran3<T>::m() const
 {
@@ -16,6 +16,7 @@ limitations under the License.
 #define __TRANSFORM3__
 
 #include <cmath>
+#include "mat3x4.h"
 #include "mat4.h"
 #include "quat.h"
 #include "vec3.h"
@@ -35,6 +36,7 @@ class tran3
     tran3(const quat<T>&);
     tran3(const vec3<T>&, const quat<T>&);
     tran3(const vec3<T>&, const quat<T>&, const vec3<T>&);
+    tran3(const mat3x4<T>&);
 
     tran3<T> &translate(const T, const T, const T);
     tran3<T> &translate(const vec3<T>&);
@@ -47,6 +49,7 @@ class tran3
     tran3<T> &transpose();
     tran3<T> &invert();
     vec4<T> transform(const vec4<T>&) const;
+    mat3x4<T> affine() const;
     const mat4<T> &m() const;
 
 };
@@ -99,7 +99,7 @@ T min::safe_inverse(const T v)
     T out;
 
     // Test for division by zero
-    if (std::abs(int(v)) < min::var<T>::TOL_REL)
+    if (std::abs(static_cast<double>(v)) < min::var<T>::TOL_REL)
     {
         out = std::numeric_limits<T>::max();
     }
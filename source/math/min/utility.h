@@ -20,6 +20,11 @@ limitations under the License.
 #include <cmath>
 #include <vector>
 
+// Use SSE specializations for float vec4, mat4 and quat unless disabled
+#if defined(__SSE2__) && !defined(MGL_NO_SIMD)
+#define MGL_SIMD_SSE
+#endif
+
 namespace min
 {
 
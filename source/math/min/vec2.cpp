@@ -474,11 +474,11 @@ min::vec2<T> min::vec2<T>::inverse() const
 template <typename T>
 min::vec2<T> min::vec2<T>::inverse_safe() const
 {
-    const T x = safe_inverse<T>(x);
-    const T y = safe_inverse<T>(y);
+    const T X = safe_inverse<T>(x);
+    const T Y = safe_inverse<T>(y);
 
     // return inverse
-    return min::vec2<T>(x, y);
+    return min::vec2<T>(X, Y);
 }
 
 template <typename T>
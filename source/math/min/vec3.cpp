@@ -96,10 +96,11 @@ min::vec3<T> min::vec3<T>::clamp_direction(const min::vec3<T> &min, const min::v
 template <typename T>
 min::vec3<T> min::vec3<T>::cross(const min::vec3<T> &A) const
 {
-    T x = y * A.z - z * A.y;
-    T y = z * A.x - x * A.z;
-    T z = x * A.y - y * A.x;
-    return min::vec3<T>(x, y, z);
+    // Locals must not shadow the members they are computed from
+    const T cx = y * A.z - z * A.y;
+    const T cy = z * A.x - x * A.z;
+    const T cz = x * A.y - y * A.x;
+    return min::vec3<T>(cx, cy, cz);
 }
 
 template <typename T>
@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "vec4.h"
 
+#ifdef MGL_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
 template class min::vec4<float>;
 template class min::vec4<double>;
 
@@ -2279,3 +2283,85 @@ bool min::vec4<T>::operator<=(const min::vec4<T> &A) const
 {
     return _x <= A._x && _y <= A._y && _z <= A._z;
 }
+
+#ifdef MGL_SIMD_SSE
+template <>
+float min::vec4<float>::dot(const min::vec4<float> &A) const
+{
+    // Multiply all components and sum x, y, z
+    const __m128 m = _mm_mul_ps(_mm_loadu_ps(&_x), _mm_loadu_ps(&A._x));
+    const __m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_movehl_ps(m, m);
+    return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(m, y), z));
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator+=(const float a)
+{
+    // Add zero to w to leave it unchanged
+    _mm_storeu_ps(&_x, _mm_add_ps(_mm_loadu_ps(&_x), _mm_set_ps(0.0, a, a, a)));
+    return *this;
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator+=(const min::vec4<float> &A)
+{
+    // Zero the w component of A to leave w unchanged
+    const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    _mm_storeu_ps(&_x, _mm_add_ps(_mm_loadu_ps(&_x), _mm_and_ps(_mm_loadu_ps(&A._x), xyz)));
+    return *this;
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator-=(const float a)
+{
+    // Subtract zero from w to leave it unchanged
+    _mm_storeu_ps(&_x, _mm_sub_ps(_mm_loadu_ps(&_x), _mm_set_ps(0.0, a, a, a)));
+    return *this;
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator-=(const min::vec4<float> &A)
+{
+    // Zero the w component of A to leave w unchanged
+    const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    _mm_storeu_ps(&_x, _mm_sub_ps(_mm_loadu_ps(&_x), _mm_and_ps(_mm_loadu_ps(&A._x), xyz)));
+    return *this;
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator*=(const float a)
+{
+    // Multiply w by one to leave it unchanged
+    _mm_storeu_ps(&_x, _mm_mul_ps(_mm_loadu_ps(&_x), _mm_set_ps(1.0, a, a, a)));
+    return *this;
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator*=(const min::vec4<float> &A)
+{
+    // Replace the w component of A with one to leave w unchanged
+    const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 b = _mm_or_ps(_mm_and_ps(xyz, _mm_loadu_ps(&A._x)), _mm_andnot_ps(xyz, _mm_set1_ps(1.0)));
+    _mm_storeu_ps(&_x, _mm_mul_ps(_mm_loadu_ps(&_x), b));
+    return *this;
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator/=(const float a)
+{
+    // Divide w by one to leave it unchanged
+    _mm_storeu_ps(&_x, _mm_div_ps(_mm_loadu_ps(&_x), _mm_set_ps(1.0, a, a, a)));
+    return *this;
+}
+
+template <>
+min::vec4<float> &min::vec4<float>::operator/=(const min::vec4<float> &A)
+{
+    // Replace the w component of A with one to leave w unchanged
+    const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 b = _mm_or_ps(_mm_and_ps(xyz, _mm_loadu_ps(&A._x)), _mm_andnot_ps(xyz, _mm_set1_ps(1.0)));
+    _mm_storeu_ps(&_x, _mm_div_ps(_mm_loadu_ps(&_x), b));
+    return *this;
+}
+#endif
@@ -135,6 +135,27 @@ class vec4
     bool operator<=(const vec4<T>&) const;
 
 };
+
+#ifdef MGL_SIMD_SSE
+template <>
+float vec4<float>::dot(const vec4<float>&) const;
+template <>
+vec4<float> &vec4<float>::operator+=(const float);
+template <>
+vec4<float> &vec4<float>::operator+=(const vec4<float>&);
+template <>
+vec4<float> &vec4<float>::operator-=(const float);
+template <>
+vec4<float> &vec4<float>::operator-=(const vec4<float>&);
+template <>
+vec4<float> &vec4<float>::operator*=(const float);
+template <>
+vec4<float> &vec4<float>::operator*=(const vec4<float>&);
+template <>
+vec4<float> &vec4<float>::operator/=(const float);
+template <>
+vec4<float> &vec4<float>::operator/=(const vec4<float>&);
+#endif
 }
 
 #endif
@@ -0,0 +1,164 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "thread_pool.h"
+
+void min::thread_pool::do_work()
+{
+    // Grab chunks of the loop until there is no work left
+    while (true)
+    {
+        const size_t begin = _next.fetch_add(_chunk);
+        if (begin >= _end)
+        {
+            break;
+        }
+
+        // Do the work for this chunk
+        const size_t end = (begin + _chunk < _end) ? begin + _chunk : _end;
+        try
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                (*_work)(i);
+            }
+        }
+        catch (...)
+        {
+            // Keep the first exception for the caller and skip the rest of the loop
+            std::lock_guard<std::mutex> lock(_lock);
+            if (!_error)
+            {
+                _error = std::current_exception();
+            }
+            _next = _end;
+            break;
+        }
+    }
+}
+
+void min::thread_pool::worker()
+{
+    // Workers are created before the first loop is published
+    std::unique_lock<std::mutex> lock(_lock);
+    size_t generation = 0;
+    while (true)
+    {
+        // Sleep until there is a new loop to run or we are shutting down
+        _start.wait(lock, [this, generation]() { return _kill || _generation != generation; });
+        if (_kill)
+        {
+            return;
+        }
+        generation = _generation;
+
+        // Do the work without holding the lock
+        lock.unlock();
+        do_work();
+        lock.lock();
+
+        // Signal the caller if we are the last thread to finish
+        if (--_running == 0)
+        {
+            _done.notify_one();
+        }
+    }
+}
+
+min::thread_pool::thread_pool() : thread_pool(std::thread::hardware_concurrency()) {}
+
+min::thread_pool::thread_pool(const size_t size)
+    : _work(nullptr), _next(0), _end(0), _chunk(1), _running(0), _generation(0), _kill(false)
+{
+    // The calling thread does work too, so spawn one less worker than requested
+    const size_t workers = (size > 1) ? size - 1 : 0;
+    _threads.reserve(workers);
+    for (size_t i = 0; i < workers; i++)
+    {
+        _threads.emplace_back(&thread_pool::worker, this);
+    }
+}
+
+min::thread_pool::~thread_pool()
+{
+    // Wake up all workers and tell them to quit
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _kill = true;
+    }
+    _start.notify_all();
+
+    // Wait for all workers to quit
+    for (auto &t : _threads)
+    {
+        t.join();
+    }
+}
+
+size_t min::thread_pool::get_size() const
+{
+    return _threads.size() + 1;
+}
+
+void min::thread_pool::run(const std::function<void(const size_t)> &work, const size_t begin, const size_t end)
+{
+    // Return if there is nothing to do
+    if (begin >= end)
+    {
+        return;
+    }
+
+    // If there are no workers run the loop on this thread
+    if (_threads.size() == 0)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            work(i);
+        }
+
+        return;
+    }
+
+    // Split the loop into a few chunks per thread to balance the load
+    const size_t chunk = (end - begin) / (get_size() * 4);
+
+    // Publish the loop to the workers
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _work = &work;
+        _error = nullptr;
+        _next = begin;
+        _end = end;
+        _chunk = (chunk > 0) ? chunk : 1;
+        _running = _threads.size();
+        _generation++;
+    }
+    _start.notify_all();
+
+    // Work on the loop on this thread
+    do_work();
+
+    // Wait for all workers to finish, even if the loop threw
+    std::unique_lock<std::mutex> lock(_lock);
+    _done.wait(lock, [this]() { return _running == 0; });
+
+    // Rethrow the first exception on the calling thread
+    if (_error)
+    {
+        std::exception_ptr error = _error;
+        _error = nullptr;
+        lock.unlock();
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,62 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef THREAD_POOL
+#define THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace min
+{
+
+// A fixed set of worker threads that run parallel for loops
+// The calling thread also works on the loop, so a pool of size 1 has no workers and runs serially
+class thread_pool
+{
+  private:
+    std::vector<std::thread> _threads;
+    std::mutex _lock;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    const std::function<void(const size_t)> *_work;
+    std::exception_ptr _error;
+    std::atomic<size_t> _next;
+    size_t _end;
+    size_t _chunk;
+    size_t _running;
+    size_t _generation;
+    bool _kill;
+
+    void do_work();
+    void worker();
+
+  public:
+    thread_pool();
+    thread_pool(const size_t);
+    ~thread_pool();
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    size_t get_size() const;
+    void run(const std::function<void(const size_t)>&, const size_t, const size_t);
+};
+}
+
+#endif
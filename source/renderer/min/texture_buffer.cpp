@@ -15,6 +15,55 @@ limitations under the License.
 
 #include "texture_buffer.h"
 
+GLuint min::texture_buffer::add_stream(std::unique_ptr<dds_stream> stream, const uint32_t levels, const bool srgb)
+{
+    // Extracted input image data
+    const uint32_t width = stream->get_width();
+    const uint32_t height = stream->get_height();
+    const uint32_t mips = stream->get_mips();
+
+    // Check the texture size vs the maximum size
+    check_texture_size(width, height);
+
+    // Generate 1 texture id
+    const auto id = generate_texture(1, mips);
+
+    // Store this id in the internal id buffer
+    _ids.push_back(id[0]);
+
+    // Mandate 4 byte row alignment, we change this in text_buffer!
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Create the stream state for this texture
+    texture_stream ts;
+    ts._type = dds_type(stream->get_format(), width, srgb);
+    ts._stream = std::move(stream);
+    ts._id = id[0];
+    ts._base = mips;
+
+    // Upload the smallest mips now so the texture can be drawn right away
+    const uint32_t first = mips - std::min(std::max(levels, (uint32_t)1), mips);
+    for (uint32_t i = mips; i-- > first;)
+    {
+        upload_stream_level(ts, i);
+    }
+
+    // Check if the mips need to be generated
+    if (mips == 1)
+    {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+
+    // Keep the stream open if there are larger mips left to upload
+    if (ts._base > 0)
+    {
+        _streams.push_back(std::move(ts));
+    }
+
+    // Return the id for this texture
+    return id[0];
+}
+
 void min::texture_buffer::check_extensions() const
 {
     const bool fbo = GLEW_ARB_framebuffer_object;
@@ -38,6 +87,60 @@ void min::texture_buffer::check_texture_size(const uint32_t width, const uint32_
     }
 }
 
+GLenum min::texture_buffer::dds_type(const uint32_t format, const uint32_t width, const bool srgb) const
+{
+    // Figure out the type of compression based on the DDS format
+    GLenum type;
+    if (format == dds::DXT1)
+    {
+        // If gamma correcting texture
+        if (srgb)
+        {
+            type = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+        }
+        else
+        {
+            type = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        }
+
+        // If image row is not aligned by 4 bytes throw error, this could cause texture distortion
+        if (width % 4 != 0)
+        {
+            throw std::runtime_error("texture_buffer: BMP is not 4 byte aligned");
+        }
+    }
+    else if (format == dds::DXT3)
+    {
+        // If gamma correcting texture
+        if (srgb)
+        {
+            type = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+        }
+        else
+        {
+            type = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        }
+    }
+    else if (format == dds::DXT5)
+    {
+        // If gamma correcting texture
+        if (srgb)
+        {
+            type = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+        }
+        else
+        {
+            type = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        }
+    }
+    else
+    {
+        throw std::runtime_error("texture_buffer: DDS format is not supported");
+    }
+
+    return type;
+}
+
 std::vector<GLuint> min::texture_buffer::generate_texture(const size_t n, const size_t mips)
 {
     // Generating N textures
@@ -71,7 +174,23 @@ std::vector<GLuint> min::texture_buffer::generate_texture(const size_t n, const
     return out;
 }
 
-min::texture_buffer::texture_buffer() : _max_size(get_max_texture_size())
+void min::texture_buffer::upload_stream_level(texture_stream &ts, const uint32_t level)
+{
+    // Read only this mip level from the stream
+    ts._stream->read_level(level, _stream_buffer);
+
+    // Load the compressed mip map into the texture buffer
+    const uint32_t w = ts._stream->get_level_width(level);
+    const uint32_t h = ts._stream->get_level_height(level);
+    glBindTexture(GL_TEXTURE_2D, ts._id);
+    glCompressedTexImage2D(GL_TEXTURE_2D, level, ts._type, w, h, 0, _stream_buffer.size(), &_stream_buffer[0]);
+
+    // Only sample from the levels that have been uploaded
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    ts._base = level;
+}
+
+min::texture_buffer::texture_buffer() : _max_size(get_max_texture_size()), _stream_next(0)
 {
     // Check that all needed extensions are present
     check_extensions();
@@ -92,62 +211,93 @@ min::texture_buffer::~texture_buffer()
 
 GLuint min::texture_buffer::add_bmp_texture(const min::bmp &b, const bool srgb)
 {
-    // Extracted input image data
-    const uint32_t width = b.get_width();
-    const uint32_t height = b.get_height();
-    const uint32_t pixel_size = b.get_pixel_size();
-    const std::vector<uint8_t> &pixels = b.get_pixels();
+    // If image row is not aligned by 4 bytes throw error, this could cause texture distortion
+    if (b.get_pixel_size() == 3 && b.get_width() % 4 != 0)
+    {
+        throw std::runtime_error("texture_buffer: BMP is not 4 byte aligned");
+    }
 
-    // Check the texture size vs the maximum size
-    check_texture_size(width, height);
+    // Filter the mip map levels on the CPU, gamma correct if sRGB
+    const std::vector<image> mips = image(b).mip_chain(image::BOX, srgb);
 
-    // Generate 1 texture id
-    auto id = generate_texture(1, 1);
+    return add_mip_texture(mips, srgb);
+}
 
-    // Store this id in the internal id buffer
-    _ids.push_back(id[0]);
+GLuint min::texture_buffer::add_dds_stream(const std::string &file, const uint32_t levels, const bool srgb)
+{
+    return add_stream(std::unique_ptr<dds_stream>(new dds_stream(file)), levels, srgb);
+}
 
-    // Mandate 4 bytes per pixel, since we change this in text_buffer!
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+GLuint min::texture_buffer::add_dds_stream(const mem_file &mem, const uint32_t levels, const bool srgb)
+{
+    return add_stream(std::unique_ptr<dds_stream>(new dds_stream(mem)), levels, srgb);
+}
 
-    // Check if 24 or 32 bit image
-    if (pixel_size == 3)
+GLuint min::texture_buffer::add_mip_texture(const std::vector<image> &mips, const bool srgb)
+{
+    if (mips.size() == 0)
     {
-        // If image row is not aligned by 4 bytes throw error, this could cause texture distortion
-        if (width % 4 != 0)
-        {
-            throw std::runtime_error("texture_buffer: BMP is not 4 byte aligned");
-        }
+        throw std::runtime_error("texture_buffer: mip chain has no levels");
+    }
 
-        // If gamma correcting texture
-        if (srgb)
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8, width, height, 0, GL_BGR, GL_UNSIGNED_BYTE, &pixels[0]);
-        }
-        else
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_BGR, GL_UNSIGNED_BYTE, &pixels[0]);
-        }
+    // Extracted input image data
+    const uint32_t width = mips[0].get_width();
+    const uint32_t height = mips[0].get_height();
+    const uint32_t pixel_size = mips[0].get_pixel_size();
+
+    // Check the texture size vs the maximum size
+    check_texture_size(width, height);
+
+    // Figure out the texture format based on the pixel size
+    GLint internal;
+    GLenum format;
+    GLenum type;
+    if (pixel_size == 3)
+    {
+        // bitmap is stored in GL_BGR
+        internal = (srgb) ? GL_SRGB8 : GL_RGB8;
+        format = GL_BGR;
+        type = GL_UNSIGNED_BYTE;
     }
     else if (pixel_size == 4)
     {
-        // If gamma correcting texture
-        if (srgb)
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, width, height, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, &pixels[0]);
-        }
-        else
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, &pixels[0]);
-        }
+        internal = (srgb) ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+        format = GL_RGBA;
+        type = GL_UNSIGNED_INT_8_8_8_8;
     }
     else
     {
         throw std::runtime_error("texture_buffer: BMP format is not supported");
     }
 
-    // Generate mip map levels for this texture
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // Generate 1 texture id
+    const auto id = generate_texture(1, mips.size());
+
+    // Store this id in the internal id buffer
+    _ids.push_back(id[0]);
+
+    // Upload every mip level so the driver does not have to generate them
+    uint32_t w = width;
+    uint32_t h = height;
+    for (size_t i = 0; i < mips.size(); i++)
+    {
+        // Check the level matches the expected mip map dimensions
+        if (mips[i].get_width() != w || mips[i].get_height() != h || mips[i].get_pixel_size() != pixel_size)
+        {
+            throw std::runtime_error("texture_buffer: mip map level " + std::to_string(i) + " has invalid dimensions");
+        }
+
+        // Image rows are not padded, small 24 bit levels need byte alignment
+        glPixelStorei(GL_UNPACK_ALIGNMENT, ((w * pixel_size) % 4 == 0) ? 4 : 1);
+        glTexImage2D(GL_TEXTURE_2D, i, internal, w, h, 0, format, type, &mips[i].get_pixels()[0]);
+
+        // Calculate width and height for next level, accurate for non-power of two textures
+        w = std::max((unsigned)1, w / 2);
+        h = std::max((unsigned)1, h / 2);
+    }
+
+    // Mandate 4 bytes per pixel, since we change this in text_buffer!
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
     // Return the id for this texture
     return id[0];
@@ -175,53 +325,7 @@ GLuint min::texture_buffer::add_dds_texture(const min::dds &d, const bool srgb)
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
     // Figure out the type of compression based on the DDS format
-    GLenum type;
-    if (format == dds::DXT1)
-    {
-        // If gamma correcting texture
-        if (srgb)
-        {
-            type = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
-        }
-        else
-        {
-            type = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
-        }
-
-        // If image row is not aligned by 4 bytes throw error, this could cause texture distortion
-        if (width % 4 != 0)
-        {
-            throw std::runtime_error("texture_buffer: BMP is not 4 byte aligned");
-        }
-    }
-    else if (format == dds::DXT3)
-    {
-        // If gamma correcting texture
-        if (srgb)
-        {
-            type = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
-        }
-        else
-        {
-            type = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-        }
-    }
-    else if (format == dds::DXT5)
-    {
-        // If gamma correcting texture
-        if (srgb)
-        {
-            type = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
-        }
-        else
-        {
-            type = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-        }
-    }
-    else
-    {
-        throw std::runtime_error("texture_buffer: DDS format is not supported");
-    }
+    const GLenum type = dds_type(format, width, srgb);
 
     // For all mip map levels
     // Determine the blocksize based on the DDS format
@@ -288,6 +392,20 @@ size_t min::texture_buffer::get_max_texture_size() const
     return (size_t)size;
 }
 
+bool min::texture_buffer::is_streaming(const GLuint id) const
+{
+    // Check if this texture still has mip levels to upload
+    for (const auto &ts : _streams)
+    {
+        if (ts._id == id)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void min::texture_buffer::set_texture_uniform(const min::program &program, const std::string &name, const size_t layer) const
 {
     const GLint sampler_location = glGetUniformLocation(program.id(), name.c_str());
@@ -305,3 +423,49 @@ void min::texture_buffer::set_texture_uniform(const min::program &program, const
     // Check for opengl errors
     throw_gl_error();
 }
+
+size_t min::texture_buffer::upload_streams(const size_t budget)
+{
+    // Mandate 4 byte row alignment, we change this in text_buffer!
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Upload the next larger mip of each stream in turn until the byte budget is spent
+    // Each call starts after the last stream served so a large level can not starve the others
+    const size_t size = _streams.size();
+    const size_t start = _stream_next;
+    size_t uploaded = 0;
+    bool pending = true;
+    while (pending)
+    {
+        pending = false;
+        for (size_t i = 0; i < size; i++)
+        {
+            const size_t index = (start + i) % size;
+            texture_stream &ts = _streams[index];
+            if (ts._base == 0)
+            {
+                continue;
+            }
+
+            // Always upload at least one level per call so large levels can not stall forever
+            const size_t level_size = ts._stream->get_level_size(ts._base - 1);
+            if (uploaded > 0 && uploaded + level_size > budget)
+            {
+                continue;
+            }
+
+            upload_stream_level(ts, ts._base - 1);
+            uploaded += level_size;
+            pending = true;
+            _stream_next = index + 1;
+        }
+    }
+
+    // Close the streams that are fully uploaded
+    const auto done = [](const texture_stream &ts) { return ts._base == 0; };
+    const size_t served = std::count_if(_streams.begin(), _streams.begin() + std::min(_stream_next, size), done);
+    _streams.erase(std::remove_if(_streams.begin(), _streams.end(), done), _streams.end());
+    _stream_next = (_streams.size() > 0) ? (_stream_next - served) % _streams.size() : 0;
+
+    return uploaded;
+}
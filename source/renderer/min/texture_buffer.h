@@ -17,25 +17,45 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "file/min/bmp.h"
 #include "file/min/dds.h"
+#include "file/min/image.h"
 #include "program.h"
 #include "platform/min/window.h"
 
 namespace min
 {
 
+// A dds texture whose larger mip levels are still being uploaded
+// upload_streams binds each streamed texture, so call it before binding textures for drawing
+struct texture_stream
+{
+    std::unique_ptr<dds_stream> _stream;
+    GLuint _id;
+    GLenum _type;
+    uint32_t _base;
+};
+
 class texture_buffer
 {
   private:
     std::vector<GLuint> _ids;
     size_t _max_size;
+    std::vector<texture_stream> _streams;
+    std::vector<uint8_t> _stream_buffer;
+    size_t _stream_next;
 
+    GLuint add_stream(std::unique_ptr<dds_stream>, const uint32_t, const bool);
     void check_extensions() const;
     void check_texture_size(const uint32_t, const uint32_t);
+    GLenum dds_type(const uint32_t, const uint32_t, const bool) const;
     std::vector<GLuint> generate_texture(const size_t, const size_t);
+    void upload_stream_level(texture_stream&, const uint32_t);
 
   public:
     texture_buffer();
@@ -44,9 +64,14 @@ class texture_buffer
 
     GLuint add_bmp_texture(const bmp&, const bool= false);
     GLuint add_dds_texture(const dds&, const bool = false);
+    GLuint add_dds_stream(const std::string&, const uint32_t, const bool = false);
+    GLuint add_dds_stream(const mem_file&, const uint32_t, const bool = false);
+    GLuint add_mip_texture(const std::vector<image>&, const bool = false);
     void bind(const GLuint, const size_t) const;
     size_t get_max_texture_size() const;
+    bool is_streaming(const GLuint) const;
     void set_texture_uniform(const program&, const std::string&, const size_t) const;
+    size_t upload_streams(const size_t);
 
 };
 }
@@ -427,6 +427,18 @@ min::uniform_buffer<T>::~uniform_buffer()
     throw_gl_error();
 }
 
+template<typename T>
+size_t min::uniform_buffer<T>::add_affine(const min::mat3x4<T> &mat)
+{
+    // Affine matrices are stored as three rows in the vector buffer
+    _vector.push_back(mat.one());
+    _vector.push_back(mat.two());
+    _vector.push_back(mat.three());
+
+    // Return vector ID of the first row
+    return _vector.size() - 3;
+}
+
 template<typename T>
 size_t min::uniform_buffer<T>::add_light(const min::light<T> &light)
 {
@@ -507,6 +519,16 @@ size_t min::uniform_buffer<T>::get_max_buffer_size()
     return (size_t)size;
 }
 
+template<typename T>
+void min::uniform_buffer<T>::insert_affine(const std::vector<min::mat3x4<T>> &v)
+{
+    _vector.reserve(_vector.size() + v.size() * 3);
+    for (const auto &mat : v)
+    {
+        add_affine(mat);
+    }
+}
+
 template<typename T>
 void min::uniform_buffer<T>::insert_light(const std::vector<min::light<T>> &v)
 {
@@ -561,6 +583,14 @@ void min::uniform_buffer<T>::reserve_vector(const size_t size)
     _vector.reserve(size);
 }
 
+template<typename T>
+void min::uniform_buffer<T>::set_affine(const min::mat3x4<T> &mat, const size_t id)
+{
+    _vector[id] = mat.one();
+    _vector[id + 1] = mat.two();
+    _vector[id + 2] = mat.three();
+}
+
 template<typename T>
 void min::uniform_buffer<T>::set_light(const min::light<T> &light, const size_t id)
 {
@@ -21,6 +21,7 @@ limitations under the License.
 #include <stdexcept>
 
 #include "scene/min/light.h"
+#include "math/min/mat3x4.h"
 #include "math/min/mat4.h"
 #include "math/min/vec4.h"
 #include "platform/min/window.h"
@@ -78,6 +79,7 @@ class uniform_buffer
 
     void defer_construct(const unsigned, const unsigned, const unsigned);
     void load_buffers();
+    size_t add_affine(const mat3x4<T>&);
     size_t add_light(const light<T>&);
     size_t add_matrix(const mat4<T>&);
     size_t add_vector(const vec4<T>&);
@@ -86,6 +88,7 @@ class uniform_buffer
     void clear_matrix();
     void clear_vector();
     static size_t get_max_buffer_size();
+    void insert_affine(const std::vector<mat3x4<T>>&);
     void insert_light(const std::vector<light<T>>&);
     void insert_matrix(const std::vector<mat4<T>>&);
     void insert_vector(const std::vector<vec4<T>>&);
@@ -95,6 +98,7 @@ class uniform_buffer
     void reserve_lights(const size_t);
     void reserve_matrix(const size_t);
     void reserve_vector(const size_t);
+    void set_affine(const mat3x4<T>&, const size_t);
     void set_light(const light<T>&, const size_t);
     void set_matrix(const mat4<T>&, const size_t);
     void set_vector(const vec4<T>&, const size_t);
@@ -0,0 +1,50 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef COLLISION_FILTER
+#define COLLISION_FILTER
+
+#include <cstdint>
+
+namespace min
+{
+
+// A body belongs to all layers set in category and collides with all layers set in mask
+// Two bodies can only collide if each body's category is in the other body's mask
+class collision_filter
+{
+  private:
+    uint32_t _category;
+    uint32_t _mask;
+
+  public:
+    collision_filter() : _category(0x1), _mask(0xFFFFFFFF) {}
+    collision_filter(const uint32_t category, const uint32_t mask) : _category(category), _mask(mask) {}
+
+    inline bool collides(const collision_filter &f) const
+    {
+        return (_category & f._mask) && (f._category & _mask);
+    }
+    inline uint32_t get_category() const
+    {
+        return _category;
+    }
+    inline uint32_t get_mask() const
+    {
+        return _mask;
+    }
+};
+}
+
+#endif
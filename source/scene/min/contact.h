@@ -0,0 +1,62 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef CONTACT
+#define CONTACT
+
+#include <cstddef>
+
+namespace min
+{
+
+// A contact event between two bodies recorded during a physics solve
+// The normal points toward the first body and the impulse is the magnitude applied along the normal
+template <typename T, template <typename> class vec>
+class contact
+{
+  private:
+    size_t _index1;
+    size_t _index2;
+    vec<T> _point;
+    vec<T> _normal;
+    T _impulse;
+
+  public:
+    contact(const size_t index1, const size_t index2, const vec<T> &point, const vec<T> &normal, const T impulse)
+        : _index1(index1), _index2(index2), _point(point), _normal(normal), _impulse(impulse) {}
+
+    inline size_t get_index1() const
+    {
+        return _index1;
+    }
+    inline size_t get_index2() const
+    {
+        return _index2;
+    }
+    inline const vec<T> &get_point() const
+    {
+        return _point;
+    }
+    inline const vec<T> &get_normal() const
+    {
+        return _normal;
+    }
+    inline T get_impulse() const
+    {
+        return _impulse;
+    }
+};
+}
+
+#endif
@@ -137,6 +137,12 @@ void min::grid<T,K,L,vec,cell,shape>::get_pairs(const min::grid_node<T, K, L, ve
     // Perform an N^2-N intersection test for all shapes in this cell
     const std::vector<K> &keys = node.get_keys();
     const K size = keys.size();
+#ifdef MGL_PHYSICS_PROFILE
+    if (size > 1)
+    {
+        _cells_tested++;
+    }
+#endif
     for (K i = 0; i < size; i++)
     {
         for (K j = i + 1; j < size; j++)
@@ -150,12 +156,21 @@ void min::grid<T,K,L,vec,cell,shape>::get_pairs(const min::grid_node<T, K, L, ve
                 b = keys[i];
             }
 
+            // Skip pairs whose layers can't collide before doing any work
+            if (_filters.size() > 0 && !_filters[a].collides(_filters[b]))
+            {
+                continue;
+            }
+
             // Add the test to flags to avoid retesting
             if (!_flags.get_set_on(a, b))
             {
                 // Get the two cells
                 const shape<T, vec> &a_shape = _shapes[a];
                 const shape<T, vec> &b_shape = _shapes[b];
+#ifdef MGL_PHYSICS_PROFILE
+                _pairs_tested++;
+#endif
                 if (intersect(a_shape, b_shape))
                 {
                     _hits.emplace_back(a, b);
@@ -166,7 +181,59 @@ void min::grid<T,K,L,vec,cell,shape>::get_pairs(const min::grid_node<T, K, L, ve
 }
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
-void min::grid<T,K,L,vec,cell,shape>::get_ray_intersect(const min::grid_node<T, K, L, vec, cell, shape> &node, const min::ray<T, vec> &r) const
+void min::grid<T,K,L,vec,cell,shape>::get_ray_collisions(const ray<T, vec> &r, const uint32_t mask, std::vector<std::pair<K, vec<T>>> &hits) const
+{
+    // Output vector
+    hits.clear();
+
+    // Check if grid is not built yet
+    if (_cells.size() == 0)
+    {
+        return;
+    }
+
+    // Get the cell from the ray origin
+    // this will check if ray originates within the grid
+    const grid_node<T, K, L, vec, cell, shape> &node = get_node(r.get_origin());
+
+    // Get the intersecting pairs in this cell
+    get_ray_intersect(node, r, mask, hits);
+
+    // If we found shapes return early
+    if (hits.size() > 0)
+    {
+        return;
+    }
+
+    // This function computes the ray lengths along the grid cell
+    auto grid_ray = vec<T>::grid_ray(_cell_extent, r.get_origin(), r.get_direction(), r.get_inverse());
+
+    // Get the grid cell of ray origin
+    auto grid_index = vec<T>::grid_index(_root.get_min(), _cell_extent, r.get_origin());
+
+    // While we didn't hit anything in the grid
+    bool bad_flag = false;
+    while (hits.size() == 0 && !bad_flag)
+    {
+        // Find the next cell along the ray to test, bad flag signals that we have hit the last valid cell
+        const size_t next = vec<T>::grid_ray_next(grid_index, grid_ray, bad_flag, _scale);
+
+        // check to see if we are still inside the grid
+        if (bad_flag || next >= _cells.size())
+        {
+            return;
+        }
+
+        // Get the cell from the next key
+        const grid_node<T, K, L, vec, cell, shape> &node = _cells[next];
+
+        // Get the intersecting pairs in this cell
+        get_ray_intersect(node, r, mask, hits);
+    }
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::grid<T,K,L,vec,cell,shape>::get_ray_intersect(const min::grid_node<T, K, L, vec, cell, shape> &node, const min::ray<T, vec> &r, const uint32_t mask, std::vector<std::pair<K, vec<T>>> &hits) const
 {
     // Perform an N intersection test for all shapes in this cell against the ray
     const std::vector<K> &keys = node.get_keys();
@@ -175,10 +242,17 @@ void min::grid<T,K,L,vec,cell,shape>::get_ray_intersect(const min::grid_node<T,
     for (K i = 0; i < size; i++)
     {
         const K key = keys[i];
+
+        // Skip shapes that are not on the ray layers
+        if (_filters.size() > 0 && !(_filters[key].get_category() & mask))
+        {
+            continue;
+        }
+
         const shape<T, vec> &s = _shapes[key];
         if (intersect(s, r, point))
         {
-            _ray_hits.emplace_back(key, point);
+            hits.emplace_back(key, point);
         }
     }
 }
@@ -251,6 +325,18 @@ void min::grid<T,K,L,vec,cell,shape>::sort(const std::vector<shape<T, vec>> &sha
     }
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::grid<T,K,L,vec,cell,shape>::sort_filters(const std::vector<collision_filter> &filters)
+{
+    // Store filters in the same order as the sorted shapes
+    _filters.clear();
+    _filters.reserve(_index_map.size());
+    for (const auto &i : _index_map)
+    {
+        _filters.emplace_back(filters[i]);
+    }
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 min::grid<T,K,L,vec,cell,shape>::grid(const cell<T, vec> &c)
     : _root(c),
@@ -310,6 +396,10 @@ const std::vector<std::pair<K, K>> &min::grid<T,K,L,vec,cell,shape>::get_collisi
 {
     // Clear out the old collision sets and vectors
     _flags.clear();
+#ifdef MGL_PHYSICS_PROFILE
+    _cells_tested = 0;
+    _pairs_tested = 0;
+#endif
 
     // Output vector
     _hits.clear();
@@ -352,64 +442,43 @@ template <typename T, typename K, typename L, template <typename> class vec, tem
 const std::vector<std::pair<K, vec<T>>> &min::grid<T,K,L,vec,cell,shape>::get_collisions(const ray<T, vec> &r) const
 {
     // Output vector
-    _ray_hits.clear();
     _ray_hits.reserve(_shapes.size());
 
-    // Check if grid is not built yet
-    if (_cells.size() == 0)
-    {
-        return _ray_hits;
-    }
-
-    // Get the cell from the ray origin
-    // this will check if ray originates within the grid
-    const grid_node<T, K, L, vec, cell, shape> &node = get_node(r.get_origin());
-
-    // Get the intersecting pairs in this cell
-    get_ray_intersect(node, r);
-
-    // If we found shapes return early
-    if (_ray_hits.size() > 0)
-    {
-        return _ray_hits;
-    }
-
-    // This function computes the ray lengths along the grid cell
-    auto grid_ray = vec<T>::grid_ray(_cell_extent, r.get_origin(), r.get_direction(), r.get_inverse());
-
-    // Get the grid cell of ray origin
-    auto grid_index = vec<T>::grid_index(_root.get_min(), _cell_extent, r.get_origin());
-
-    // While we didn't hit anything in the grid
-    bool bad_flag = false;
-    while (_ray_hits.size() == 0 && !bad_flag)
-    {
-        // Find the next cell along the ray to test, bad flag signals that we have hit the last valid cell
-        const size_t next = vec<T>::grid_ray_next(grid_index, grid_ray, bad_flag, _scale);
-
-        // check to see if we are still inside the grid
-        if (bad_flag || next >= _cells.size())
-        {
-            return _ray_hits;
-        }
-
-        // Get the cell from the next key
-        const grid_node<T, K, L, vec, cell, shape> &node = _cells[next];
-
-        // Get the intersecting pairs in this cell
-        get_ray_intersect(node, r);
-    }
+    // Get shapes intersecting ray on all layers
+    get_ray_collisions(r, 0xFFFFFFFF, _ray_hits);
 
     // Return the collision list
     return _ray_hits;
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::grid<T,K,L,vec,cell,shape>::get_collisions(const ray<T, vec> &r, const uint32_t mask, std::vector<std::pair<K, vec<T>>> &hits, std::vector<std::vector<size_t>> &cache) const
+{
+    // This overload only writes to the output, so it can be called from many threads
+    // The grid doesn't need scratch space for traversal so the cache is unused
+    get_ray_collisions(r, mask, hits);
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 const std::vector<K> &min::grid<T,K,L,vec,cell,shape>::get_index_map() const
 {
     return _index_map;
 }
 
+#ifdef MGL_PHYSICS_PROFILE
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+size_t min::grid<T,K,L,vec,cell,shape>::get_cells_tested() const
+{
+    return _cells_tested;
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+size_t min::grid<T,K,L,vec,cell,shape>::get_pairs_tested() const
+{
+    return _pairs_tested;
+}
+#endif
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 K min::grid<T,K,L,vec,cell,shape>::get_scale() const
 {
@@ -464,6 +533,9 @@ bool min::grid<T,K,L,vec,cell,shape>::inside(const vec<T> &point) const
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 void min::grid<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &shapes)
 {
+    // Don't filter any pairs
+    _filters.clear();
+
     // Set the grid scale
     set_scale(shapes);
 
@@ -477,6 +549,9 @@ void min::grid<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &s
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 void min::grid<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &shapes, const K scale)
 {
+    // Don't filter any pairs
+    _filters.clear();
+
     // Set the grid scale
     _scale = scale;
 
@@ -490,9 +565,22 @@ void min::grid<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &s
     build();
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::grid<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &shapes, const std::vector<collision_filter> &filters)
+{
+    // Insert and sort the shapes
+    insert(shapes);
+
+    // Sort the filters to match the shapes
+    sort_filters(filters);
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 void min::grid<T,K,L,vec,cell,shape>::insert_no_sort(const std::vector<shape<T, vec>> &shapes)
 {
+    // Don't filter any pairs
+    _filters.clear();
+
     // Set the grid scale
     set_scale(shapes);
 
@@ -500,10 +588,24 @@ void min::grid<T,K,L,vec,cell,shape>::insert_no_sort(const std::vector<shape<T,
     _shapes.clear();
     _shapes.insert(_shapes.end(), shapes.begin(), shapes.end());
 
+    // Keys are the shape indices
+    _index_map.resize(_shapes.size());
+    std::iota(_index_map.begin(), _index_map.end(), 0);
+
     // Rebuild the grid after changing the contents
     build();
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::grid<T,K,L,vec,cell,shape>::insert_no_sort(const std::vector<shape<T, vec>> &shapes, const std::vector<collision_filter> &filters)
+{
+    // Insert shapes without sorting
+    insert_no_sort(shapes);
+
+    // Insert filters without sorting
+    _filters.insert(_filters.end(), filters.begin(), filters.end());
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 const std::vector<K> &min::grid<T,K,L,vec,cell,shape>::point_inside(const vec<T> &point) const
 {
@@ -20,6 +20,7 @@ limitations under the License.
 #include <stdexcept>
 #include <vector>
 
+#include "collision_filter.h"
 #include "geom/min/intersect.h"
 #include "geom/min/ray.h"
 #include "math/min/utility.h"
@@ -66,6 +67,7 @@ class grid
 {
   private:
     std::vector<shape<T, vec>> _shapes;
+    std::vector<collision_filter> _filters;
     std::vector<grid_node<T, K, L, vec, cell, shape>> _cells;
     std::vector<K> _index_map;
     std::vector<size_t> _key_cache;
@@ -80,14 +82,20 @@ class grid
     K _scale;
     vec<T> _cell_extent;
     size_t _flag_size;
+#ifdef MGL_PHYSICS_PROFILE
+    mutable size_t _cells_tested = 0;
+    mutable size_t _pairs_tested = 0;
+#endif
 
     void build();
     size_t get_key(const vec<T>&) const;
     void get_overlap(const size_t) const;
     void get_pairs(const grid_node<T, K, L, vec, cell, shape>&) const;
-    void get_ray_intersect(const grid_node<T, K, L, vec, cell, shape>&, const ray<T, vec>&) const;
+    void get_ray_collisions(const ray<T, vec>&, const uint32_t, std::vector<std::pair<K, vec<T>>>&) const;
+    void get_ray_intersect(const grid_node<T, K, L, vec, cell, shape>&, const ray<T, vec>&, const uint32_t, std::vector<std::pair<K, vec<T>>>&) const;
     void set_scale(const std::vector<shape<T, vec>>&);
     void sort(const std::vector<shape<T, vec>>&);
+    void sort_filters(const std::vector<collision_filter>&);
 
   public:
     grid(const cell<T, vec> &c);
@@ -101,14 +109,21 @@ class grid
     const std::vector<std::pair<K, K>> &get_collisions() const;
     const std::vector<std::pair<K, K>> &get_collisions(const vec<T>&) const;
     const std::vector<std::pair<K, vec<T>>> &get_collisions(const ray<T, vec>&) const;
+    void get_collisions(const ray<T, vec>&, const uint32_t, std::vector<std::pair<K, vec<T>>>&, std::vector<std::vector<size_t>>&) const;
     const std::vector<K> &get_index_map() const;
+#ifdef MGL_PHYSICS_PROFILE
+    size_t get_cells_tested() const;
+    size_t get_pairs_tested() const;
+#endif
     K get_scale() const;
     const std::vector<std::pair<K, K>> &get_overlap(const shape<T, vec>&) const;
     const std::vector<shape<T, vec>> &get_shapes();
     bool inside(const vec<T>&) const;
     void insert(const std::vector<shape<T, vec>>&);
     void insert(const std::vector<shape<T, vec>>&, const K);
+    void insert(const std::vector<shape<T, vec>>&, const std::vector<collision_filter>&);
     void insert_no_sort(const std::vector<shape<T, vec>>&);
+    void insert_no_sort(const std::vector<shape<T, vec>>&, const std::vector<collision_filter>&);
     const std::vector<K> &point_inside(const vec<T>&) const;
 
 };
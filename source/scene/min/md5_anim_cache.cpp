@@ -0,0 +1,140 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "md5_anim_cache.h"
+
+template class min::md5_anim_cache<float>;
+
+template <typename T>
+min::md5_anim_cache<T>::md5_anim_cache(const std::vector<min::mat3x4<T>> &inverse_bp, const T rate)
+    : _inverse_bp(inverse_bp), _size(0), _rate(rate)
+{
+    if (_rate <= 0.0)
+    {
+        throw std::runtime_error("md5_anim_cache: sample rate must be positive");
+    }
+}
+
+template <typename T>
+size_t min::md5_anim_cache<T>::check_animation()
+{
+    // Validate that the animation frame size matches the model bones
+    if (_animations.back().get_nodes().size() != _inverse_bp.size())
+    {
+        _animations.pop_back();
+        throw std::runtime_error("md5_anim_cache: animation is not compatible with model");
+    }
+
+    // Time is wrapped by the animation length, which fails for a zero or infinite length
+    const T length = _animations.back().get_length();
+    if (!(length > 0.0) || !std::isfinite(length))
+    {
+        _animations.pop_back();
+        throw std::runtime_error("md5_anim_cache: animation has no length");
+    }
+
+    // return animation index
+    return _animations.size() - 1;
+}
+
+template <typename T>
+size_t min::md5_anim_cache<T>::add_animation(const std::string &file)
+{
+    // Load animation in place
+    _animations.emplace_back(file);
+
+    return check_animation();
+}
+
+template <typename T>
+size_t min::md5_anim_cache<T>::add_animation(const mem_file &mem)
+{
+    // Load animation in place
+    _animations.emplace_back(mem);
+
+    return check_animation();
+}
+
+template <typename T>
+void min::md5_anim_cache<T>::clear()
+{
+    // Keep the palette memory for the next frame
+    _lookup.clear();
+    _size = 0;
+}
+
+template <typename T>
+const min::md5_anim<T> &min::md5_anim_cache<T>::get_animation(const size_t index) const
+{
+    return _animations[index];
+}
+
+template <typename T>
+size_t min::md5_anim_cache<T>::get_animation_size() const
+{
+    return _animations.size();
+}
+
+template <typename T>
+const std::vector<min::mat3x4<T>> &min::md5_anim_cache<T>::get_bones(const size_t index, const T time)
+{
+    const md5_anim<T> &anim = _animations[index];
+
+    // Wrap time into the animation and quantize it
+    const T length = anim.get_length();
+    T wrap = std::fmod(time, length);
+    if (wrap < 0.0)
+    {
+        wrap += length;
+    }
+    const uint32_t tick = static_cast<uint32_t>(wrap * _rate);
+
+    // Return the palette if it was already evaluated
+    const uint64_t key = (static_cast<uint64_t>(index) << 32) | tick;
+    const auto it = _lookup.find(key);
+    if (it != _lookup.end())
+    {
+        return _palettes[it->second];
+    }
+
+    // Allocate a palette, deque keeps references to older palettes valid
+    const size_t slot = _size++;
+    if (slot == _palettes.size())
+    {
+        _palettes.emplace_back(_inverse_bp.size());
+    }
+
+    // Evaluate the pose once and transform it by the inverse bind pose
+    std::vector<mat3x4<T>> &palette = _palettes[slot];
+    anim.evaluate(tick / _rate, _pose);
+    multiply_matrices(_inverse_bp.data(), _pose.data(), palette.data(), palette.size());
+
+    // Cache the palette for other instances
+    _lookup.emplace(key, slot);
+
+    return palette;
+}
+
+template <typename T>
+T min::md5_anim_cache<T>::get_rate() const
+{
+    return _rate;
+}
+
+template <typename T>
+size_t min::md5_anim_cache<T>::size() const
+{
+    return _size;
+}
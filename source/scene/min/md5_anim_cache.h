@@ -0,0 +1,65 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __MD5_ANIM_CACHE__
+#define __MD5_ANIM_CACHE__
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file/min/md5_anim.h"
+#include "math/min/batch.h"
+#include "math/min/mat3x4.h"
+
+// Shares md5 animations and evaluated bone palettes across many instances of one model
+// Animations are loaded once, instances only keep an animation index and a time
+// Palettes are keyed by (animation, quantized time) and evaluated at most once between clears
+
+namespace min
+{
+
+template <typename T>
+class md5_anim_cache
+{
+  private:
+    std::vector<mat3x4<T>> _inverse_bp;
+    std::vector<md5_anim<T>> _animations;
+    std::unordered_map<uint64_t, size_t> _lookup;
+    std::deque<std::vector<mat3x4<T>>> _palettes;
+    std::vector<mat3x4<T>> _pose;
+    size_t _size;
+    T _rate;
+
+    size_t check_animation();
+
+  public:
+    md5_anim_cache(const std::vector<mat3x4<T>>&, const T);
+
+    size_t add_animation(const std::string&);
+    size_t add_animation(const mem_file&);
+    void clear();
+    const md5_anim<T> &get_animation(const size_t) const;
+    size_t get_animation_size() const;
+    const std::vector<mat3x4<T>> &get_bones(const size_t, const T);
+    T get_rate() const;
+    size_t size() const;
+};
+}
+
+#endif
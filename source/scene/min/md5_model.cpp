@@ -41,7 +41,7 @@ void min::md5_model<T,K,vec,bound>::make_bind_pose(const std::vector<min::md5_jo
     for (const auto &joint : joints)
     {
         // Create inverse transformation matrix
-        mat4<T> bone(joint.get_position(), joint.get_rotation());
+        mat3x4<T> bone(joint.get_position(), joint.get_rotation());
 
         // Check if matrix has an inverse
         if (!bone.invert())
@@ -54,9 +54,50 @@ void min::md5_model<T,K,vec,bound>::make_bind_pose(const std::vector<min::md5_jo
     }
 }
 
+template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
+void min::md5_model<T,K,vec,bound>::update_lod_map()
+{
+    // Without pruning or an animation hierarchy every joint maps to itself
+    _lod_map.clear();
+    if (_lod_prune == 0 || _animations.size() == 0)
+    {
+        return;
+    }
+
+    // Parents always precede children in md5 files
+    const std::vector<md5_node> &nodes = _animations[_current].get_nodes();
+    const size_t size = nodes.size();
+
+    // Calculate the height of each joint subtree, leaves have height zero
+    std::vector<unsigned> height(size, 0);
+    for (size_t i = size; i-- > 0;)
+    {
+        const int parent = nodes[i].get_parent();
+        if (parent >= 0)
+        {
+            height[parent] = std::max(height[parent], height[i] + 1);
+        }
+    }
+
+    // Map pruned joints to their nearest kept ancestor
+    _lod_map.resize(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        const int parent = nodes[i].get_parent();
+        if (parent < 0 || height[i] >= _lod_prune)
+        {
+            _lod_map[i] = i;
+        }
+        else
+        {
+            _lod_map[i] = _lod_map[parent];
+        }
+    }
+}
+
 template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
 min::md5_model<T,K,vec,bound>::md5_model(md5_mesh<T, K> &&m)
-    : model<T, K, vec, bound>(std::move(m.get_meshes())), _current(0)
+    : model<T, K, vec, bound>(std::move(m.get_meshes())), _current(0), _lod_rate(1), _lod_prune(0), _lod_count(0), _lod_time(0.0)
 {
     // Joints are thrown away after this
     make_bind_pose(m.get_joints());
@@ -67,7 +108,7 @@ min::md5_model<T,K,vec,bound>::md5_model(md5_mesh<T, K> &&m)
 
 template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
 min::md5_model<T,K,vec,bound>::md5_model(const min::md5_mesh<T, K> &m)
-    : model<T, K, vec, bound>(m.get_meshes()), _current(0)
+    : model<T, K, vec, bound>(m.get_meshes()), _current(0), _lod_rate(1), _lod_prune(0), _lod_count(0), _lod_time(0.0)
 {
     // Joints are thrown away after this
     make_bind_pose(m.get_joints());
@@ -77,7 +118,23 @@ min::md5_model<T,K,vec,bound>::md5_model(const min::md5_mesh<T, K> &m)
 }
 
 template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
-const std::vector<min::mat4<T>> &min::md5_model<T,K,vec,bound>::get_bones() const
+void min::md5_model<T,K,vec,bound>::add_lod(const T distance, const unsigned rate, const unsigned prune)
+{
+    if (rate == 0)
+    {
+        throw std::runtime_error("md5_model: lod update rate must be positive");
+    }
+
+    // Keep the levels sorted by distance
+    const md5_lod<T> lod(distance, rate, prune);
+    const auto it = std::upper_bound(_lods.begin(), _lods.end(), lod, [](const md5_lod<T> &a, const md5_lod<T> &b) {
+        return a.get_distance() < b.get_distance();
+    });
+    _lods.insert(it, lod);
+}
+
+template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
+const std::vector<min::mat3x4<T>> &min::md5_model<T,K,vec,bound>::get_bones() const
 {
     return _bones;
 }
@@ -88,6 +145,24 @@ const min::md5_anim<T> &min::md5_model<T,K,vec,bound>::get_current_animation() c
     return _animations[_current];
 }
 
+template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
+const std::vector<min::mat3x4<T>> &min::md5_model<T,K,vec,bound>::get_inverse_bind_pose() const
+{
+    return _inverse_bp;
+}
+
+template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
+unsigned min::md5_model<T,K,vec,bound>::get_lod_prune() const
+{
+    return _lod_prune;
+}
+
+template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
+unsigned min::md5_model<T,K,vec,bound>::get_lod_rate() const
+{
+    return _lod_rate;
+}
+
 template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
 bool min::md5_model<T,K,vec,bound>::is_animating() const
 {
@@ -111,7 +186,7 @@ size_t min::md5_model<T,K,vec,bound>::load_animation(const std::string &file)
     _current = _animations.size() - 1;
 
     // Get current frame of animation
-    const std::vector<mat4<T>> &frame = _animations[_current].get_current_frame();
+    const std::vector<mat3x4<T>> &frame = _animations[_current].get_current_frame();
 
     // Validate that the animation frame size matches the model bones
     const size_t size = frame.size();
@@ -120,6 +195,9 @@ size_t min::md5_model<T,K,vec,bound>::load_animation(const std::string &file)
         throw std::runtime_error("md5_model: animation is not compatible with model");
     }
 
+    // Update the pruned joints for the new hierarchy
+    update_lod_map();
+
     // return current animation index
     return _current;
 }
@@ -134,7 +212,7 @@ size_t min::md5_model<T,K,vec,bound>::load_animation(const mem_file &mem)
     _current = _animations.size() - 1;
 
     // Get current frame of animation
-    const std::vector<mat4<T>> &frame = _animations[_current].get_current_frame();
+    const std::vector<mat3x4<T>> &frame = _animations[_current].get_current_frame();
 
     // Validate that the animation frame size matches the model bones
     const size_t size = frame.size();
@@ -143,6 +221,9 @@ size_t min::md5_model<T,K,vec,bound>::load_animation(const mem_file &mem)
         throw std::runtime_error("md5_model: animation is not compatible with model");
     }
 
+    // Update the pruned joints for the new hierarchy
+    update_lod_map();
+
     // return current animation index
     return _current;
 }
@@ -153,7 +234,7 @@ void min::md5_model<T,K,vec,bound>::reset_bones() const
     // Reset bones to mind bose
     for (auto &b : _bones)
     {
-        b = mat4<T>();
+        b = mat3x4<T>();
     }
 }
 
@@ -162,6 +243,51 @@ void min::md5_model<T,K,vec,bound>::set_current_animation(const size_t animation
 {
     // Set animation with index
     _current = animation;
+
+    // Update the pruned joints for the new hierarchy
+    if (_lod_prune != 0)
+    {
+        update_lod_map();
+    }
+}
+
+template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
+void min::md5_model<T,K,vec,bound>::set_lod(const unsigned rate, const unsigned prune)
+{
+    if (rate == 0)
+    {
+        throw std::runtime_error("md5_model: lod update rate must be positive");
+    }
+
+    // Set the update rate divisor
+    _lod_rate = rate;
+
+    // Rebuild the joint map if pruning changed
+    if (_lod_prune != prune)
+    {
+        _lod_prune = prune;
+        update_lod_map();
+    }
+}
+
+template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
+void min::md5_model<T,K,vec,bound>::set_lod_distance(const T distance)
+{
+    // Use the farthest level closer than distance, full detail if none
+    unsigned rate = 1;
+    unsigned prune = 0;
+    for (const auto &lod : _lods)
+    {
+        if (lod.get_distance() > distance)
+        {
+            break;
+        }
+
+        rate = lod.get_rate();
+        prune = lod.get_prune();
+    }
+
+    set_lod(rate, prune);
 }
 
 template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
@@ -173,14 +299,24 @@ void min::md5_model<T,K,vec,bound>::step(const T time) const
         throw std::runtime_error("md5_model: no animations are loaded");
     }
 
+    // Accumulate time and reuse the last pose until the lod update is due
+    _lod_time += time;
+    if (++_lod_count < _lod_rate)
+    {
+        return;
+    }
+    const T lod_time = _lod_time;
+    _lod_count = 0;
+    _lod_time = 0.0;
+
     // Get the current animation
     const md5_anim<T> &anim = _animations[_current];
 
-    // Step the animation
-    anim.step(time);
+    // Step the animation, pruned joints are not interpolated
+    anim.step(lod_time, _lod_map);
 
     // Get current frame of animation
-    const std::vector<mat4<T>> &frame = anim.get_current_frame();
+    const std::vector<mat3x4<T>> &frame = anim.get_current_frame();
 
     // Check frame size, consider removing since we checked on load
     if (frame.size() != _bones.size())
@@ -188,11 +324,29 @@ void min::md5_model<T,K,vec,bound>::step(const T time) const
         throw std::runtime_error("md5_model: animation is not compatible with model");
     }
 
-    // Update the model bones
+    // Transform the bones based off animation frame
+    if (_lod_map.size() == 0)
+    {
+        multiply_matrices(_inverse_bp.data(), frame.data(), _bones.data(), frame.size());
+        return;
+    }
+
+    // Only transform kept joints, the palette size is unchanged for skinning
     const size_t size = frame.size();
     for (size_t i = 0; i < size; i++)
     {
-        // Transform the bone based off animation frame
-        _bones[i] = _inverse_bp[i] * frame[i];
+        if (_lod_map[i] == i)
+        {
+            _bones[i] = _inverse_bp[i] * frame[i];
+        }
+    }
+
+    // Pruned joints follow the bind pose relative to their kept ancestor
+    for (size_t i = 0; i < size; i++)
+    {
+        if (_lod_map[i] != i)
+        {
+            _bones[i] = _bones[_lod_map[i]];
+        }
     }
 }
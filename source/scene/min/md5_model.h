@@ -15,6 +15,8 @@ limitations under the License.
 #ifndef __MD5_MODEL__
 #define __MD5_MODEL__
 
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 #include "file/min/md5_anim.h"
@@ -24,17 +26,52 @@ limitations under the License.
 namespace min
 {
 
+// A level of detail for animation, used past a camera distance
+// Rate is the update divisor, the pose is evaluated every 'rate' steps and reused in between
+// Prune drops joints whose subtree height is less than 'prune', they follow their nearest kept ancestor
+template <typename T>
+class md5_lod
+{
+  private:
+    T _distance;
+    unsigned _rate;
+    unsigned _prune;
+
+  public:
+    md5_lod(const T distance, const unsigned rate, const unsigned prune)
+        : _distance(distance), _rate(rate), _prune(prune) {}
+    T get_distance() const
+    {
+        return _distance;
+    }
+    unsigned get_rate() const
+    {
+        return _rate;
+    }
+    unsigned get_prune() const
+    {
+        return _prune;
+    }
+};
+
 template <typename T, typename K, template <typename> class vec, template <typename, template <typename> class> class bound>
 class md5_model : public model<T, K, vec, bound>
 {
   protected:
-    std::vector<mat4<T>> _inverse_bp;
-    mutable std::vector<mat4<T>> _bones;
+    std::vector<mat3x4<T>> _inverse_bp;
+    mutable std::vector<mat3x4<T>> _bones;
     std::vector<md5_anim<T>> _animations;
     size_t _current;
+    std::vector<md5_lod<T>> _lods;
+    std::vector<size_t> _lod_map;
+    unsigned _lod_rate;
+    unsigned _lod_prune;
+    mutable unsigned _lod_count;
+    mutable T _lod_time;
 
     void check_bones();
     void make_bind_pose(const std::vector<md5_joint<T>>&);
+    void update_lod_map();
 
 
   public:
@@ -42,13 +79,19 @@ class md5_model : public model<T, K, vec, bound>
     md5_model(md5_mesh<T, K>&&);
     md5_model(const md5_mesh<T, K>&);
 
-    const std::vector<mat4<T>> &get_bones() const;
+    void add_lod(const T, const unsigned, const unsigned);
+    const std::vector<mat3x4<T>> &get_bones() const;
     const md5_anim<T> &get_current_animation() const;
+    const std::vector<mat3x4<T>> &get_inverse_bind_pose() const;
+    unsigned get_lod_prune() const;
+    unsigned get_lod_rate() const;
     bool is_animating() const;
     size_t load_animation(const std::string&);
     size_t load_animation(const mem_file&);
     void reset_bones() const;
     void set_current_animation(const size_t);
+    void set_lod(const unsigned, const unsigned);
+    void set_lod_distance(const T);
     void step(const T) const;
 
 };
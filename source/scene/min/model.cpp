@@ -62,13 +62,11 @@ template <typename T, typename K, template <typename> class vec, template <typen
 const vec<T> &min::model<T,K,vec,bound>::center_model()
 {
     // Center all vertices in the model
+    const vec<T> offset = _center * -1.0;
     for (auto &m : _mesh)
     {
         // Center all meshes by substracting the center
-        for (auto &vert : m.vertex)
-        {
-            vert -= _center;
-        }
+        translate_points(offset, m.vertex.data(), m.vertex.size());
     }
 
     // Clear out the model bounding volumes
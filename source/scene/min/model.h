@@ -19,6 +19,7 @@ limitations under the License.
 #include <vector>
 
 #include "geom/min/mesh.h"
+#include "math/min/batch.h"
 #include "math/min/vec2.h"
 #include "math/min/vec3.h"
 #include "math/min/vec4.h"
@@ -18,9 +18,9 @@ limitations under the License.
 //// body_base ////
 template <typename T, template <typename> class vec, class angular, template<typename> class rot>
 min::body_base<T, vec, angular, rot>::body_base(const vec<T> &center, const vec<T> &gravity, const T mass, const size_t id, const body_data data)
-    : _force(gravity * mass), _position(center), _angular_velocity{},
+    : _force(gravity * mass), _position(center), _prev_position(center), _angular_velocity{},
       _mass(mass), _inv_mass(1.0 / mass),
-      _id(id), _data(data), _dead(false) {}
+      _id(id), _data(data), _dead(false), _ccd(false) {}
 
 
 template <typename T, template <typename> class vec, class angular, template<typename> class rot>
@@ -93,6 +93,20 @@ const T min::body_base<T, vec, angular, rot>::get_inv_mass() const
     return _inv_mass;
 }
 
+template <typename T, template <typename> class vec, class angular, template<typename> class rot>
+vec<T> min::body_base<T, vec, angular, rot>::get_interpolated_position(const T t) const
+{
+    // Interpolate between the previous and current timestep
+    return vec<T>::lerp(_prev_position, _position, t);
+}
+
+template <typename T, template <typename> class vec, class angular, template<typename> class rot>
+rot<T> min::body_base<T, vec, angular, rot>::get_interpolated_rotation(const T t) const
+{
+    // Interpolate between the previous and current timestep
+    return interpolate<T>(_prev_rotation, _rotation, t);
+}
+
 template <typename T, template <typename> class vec, class angular, template<typename> class rot>
 const rot<T> &min::body_base<T, vec, angular, rot>::get_rotation() const
 {
@@ -105,6 +119,12 @@ const vec<T> &min::body_base<T, vec, angular, rot>::get_position() const
     return _position;
 }
 
+template <typename T, template <typename> class vec, class angular, template<typename> class rot>
+bool min::body_base<T, vec, angular, rot>::is_ccd() const
+{
+    return _ccd;
+}
+
 template <typename T, template <typename> class vec, class angular, template<typename> class rot>
 bool min::body_base<T, vec, angular, rot>::is_dead() const
 {
@@ -123,6 +143,13 @@ void min::body_base<T, vec, angular, rot>::set_angular_velocity(const angular w)
     _angular_velocity = w;
 }
 
+template <typename T, template <typename> class vec, class angular, template<typename> class rot>
+void min::body_base<T, vec, angular, rot>::set_ccd(const bool flag)
+{
+    // Enable continuous collision detection for this body
+    _ccd = flag;
+}
+
 template <typename T, template <typename> class vec, class angular, template<typename> class rot>
 void min::body_base<T, vec, angular, rot>::set_data(const body_data data)
 {
@@ -174,27 +201,19 @@ void min::body_base<T, vec, angular, rot>::update_position(const vec<T> &linear_
     _linear_velocity = linear_velocity * direction;
 }
 
-//// body<T, vec2> ////
-template <typename T>
-min::body<T, min::vec2>::body(const min::vec2<T> &center, const min::vec2<T> &gravity, const T mass, const size_t id, const min::body_data data)
-    : body_base<T, vec2, T, mat2>(center, gravity, mass, id, data), _f(nullptr) {}
-
-
-template <typename T>
-void min::body<T, min::vec2>::callback(body<T, min::vec2> &b2)
+template <typename T, template <typename> class vec, class angular, template<typename> class rot>
+void min::body_base<T, vec, angular, rot>::update_previous()
 {
-    // If we registered a callback
-    if (this->_f)
-    {
-        this->_f(*this, b2);
-    }
+    // Store the current state for interpolating between timesteps
+    _prev_position = _position;
+    _prev_rotation = _rotation;
 }
 
+//// body<T, vec2> ////
 template <typename T>
-void min::body<T, min::vec2>::register_callback(const std::function<void(body<T, min::vec2> &, min::body<T, min::vec2> &)> &f)
-{
-    this->_f = f;
-}
+min::body<T, min::vec2>::body(const min::vec2<T> &center, const min::vec2<T> &gravity, const T mass, const size_t id, const min::body_data data)
+    : body_base<T, vec2, T, mat2>(center, gravity, mass, id, data) {}
+
 
 template <typename T>
 min::mat2<T> min::body<T, min::vec2>::update_rotation(const T time_step)
@@ -213,25 +232,9 @@ min::mat2<T> min::body<T, min::vec2>::update_rotation(const T time_step)
 //// body<T, vec3> ////
 template <typename T>
 min::body<T, min::vec3>::body(const min::vec3<T> &center, const min::vec3<T> &gravity, const T mass, const size_t id, const min::body_data data)
-    : body_base<T, vec3, vec3<T>, quat>(center, gravity, mass, id, data), _f(nullptr) {}
+    : body_base<T, vec3, vec3<T>, quat>(center, gravity, mass, id, data) {}
 
 
-template <typename T>
-void min::body<T, min::vec3>::callback(body<T, min::vec3> &b2)
-{
-    // If we registered a callback
-    if (this->_f)
-    {
-        this->_f(*this, b2);
-    }
-}
-
-template <typename T>
-void min::body<T, min::vec3>::register_callback(const std::function<void(body<T, min::vec3> &, min::body<T, min::vec3> &)> &f)
-{
-    this->_f = f;
-}
-
 template <typename T>
 min::quat<T> min::body<T, min::vec3>::update_rotation(const T time_step)
 {
@@ -264,24 +267,8 @@ min::quat<T> min::body<T, min::vec3>::update_rotation(const T time_step)
 //// body<T, vec4> ////
 template <typename T>
 min::body<T, min::vec4>::body(const min::vec4<T> &center, const min::vec4<T> &gravity, const T mass, const size_t id, const min::body_data data)
-    : body_base<T, vec4, vec4<T>, quat>(center, gravity, mass, id, data), _f(nullptr) {}
-
+    : body_base<T, vec4, vec4<T>, quat>(center, gravity, mass, id, data) {}
 
-template <typename T>
-void min::body<T, min::vec4>::callback(body<T, min::vec4> &b2)
-{
-    // If we registered a callback
-    if (this->_f)
-    {
-        this->_f(*this, b2);
-    }
-}
-
-template <typename T>
-void min::body<T, min::vec4>::register_callback(const std::function<void(body<T, min::vec4> &, min::body<T, min::vec4> &)> &f)
-{
-    this->_f = f;
-}
 
 template <typename T>
 min::quat<T> min::body<T, min::vec4>::update_rotation(const T time_step)
@@ -340,12 +327,11 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::collide(const size_t index1, co
     vec<T> intersection;
     const vec<T> offset = resolve<T, vec>(s1, s2, collision_normal, intersection, _collision_tolerance);
 
-    // Do the collision callback function
-    b1.callback(b2);
-    b2.callback(b1);
-
     // Solve linear and angular momentum conservation equations
-    solve_energy_conservation(b1, b2, collision_normal, intersection);
+    const T impulse = solve_energy_conservation(b1, b2, collision_normal, intersection);
+
+    // Record the contact event for the application to process after solving
+    _contacts.emplace_back(index1, index2, intersection, collision_normal, impulse);
 
     // If an object has infinite mass, inv_mass = 0
     // Move each object based off inv_mass
@@ -368,6 +354,40 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::collide(const size_t index1, co
     }
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::collide_parallel(const size_t index)
+{
+    // Get the bodies of this contact pair, no other pair in this batch touches them
+    const size_t index1 = _pairs[index].first;
+    const size_t index2 = _pairs[index].second;
+    body<T, vec> &b1 = _bodies[index1];
+    body<T, vec> &b2 = _bodies[index2];
+    contact_solve<T, vec> &out = _pair_solve[index];
+
+    // Check if either body has died
+    out.hit = !(b1.is_dead() || b2.is_dead());
+    if (!out.hit)
+    {
+        return;
+    }
+
+    // Calculate the collision normal, intersection point and offset to resolve the collision
+    const vec<T> offset = resolve<T, vec>(_shapes[index1], _shapes[index2], out.normal, out.point, _collision_tolerance);
+
+    // Solve linear and angular momentum conservation equations
+    out.impulse = solve_energy_conservation(b1, b2, out.normal, out.point);
+
+    // Split the offset based off inv_mass, see collide()
+    const T total = b1.get_inv_mass() + b2.get_inv_mass();
+    if (total > var<T>::TOL_ZERO)
+    {
+        const T inv_total = 1.0 / total;
+        b1.move_offset(offset * (total - b2.get_inv_mass()) * inv_total);
+        b2.move_offset(offset * (b1.get_inv_mass() - total) * inv_total);
+    }
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 bool min::physics<T,K,L,vec,cell,shape,spatial>::collide_static(const size_t index, const shape<T, vec> &s2)
@@ -407,11 +427,12 @@ bool min::physics<T,K,L,vec,cell,shape,spatial>::collide_static(const size_t ind
     // return if we collided
     return collide;
 }
+
 // Intersection point intersect
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
-void min::physics<T,K,L,vec,cell,shape,spatial>::solve_energy_conservation(body<T, vec> &b1, min::body<T, vec> &b2, const vec<T> &n, const vec<T> &intersect)
+T min::physics<T,K,L,vec,cell,shape,spatial>::calculate_impulse(const body<T, vec> &b1, const body<T, vec> &b2, const vec<T> &n) const
 {
     // Get velocities of bodies in world space
     const T v1n = b1.get_linear_velocity().dot(n);
@@ -421,13 +442,34 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::solve_energy_conservation(body<
     // If objects are moving away from each other, skip calculation
     if (v1n >= -_collision_tolerance && v2n <= _collision_tolerance)
     {
-        return;
+        return 0.0;
     }
 
     // If objects are moving in the same direction, skip calculation
     if (std::abs(v1n - v2n) <= _collision_tolerance)
     {
-        return;
+        return 0.0;
+    }
+
+    // Calculate the relative velocity between b1 and b2 in world space
+    const vec<T> v12 = b1.get_linear_velocity() - b2.get_linear_velocity();
+
+    // Calculate the kinetic resistance of the object
+    const T resistance = b1.get_inv_mass() + b2.get_inv_mass();
+
+    // Calculate the impulse
+    return -(1.0 + _elasticity) * (v12.dot(n) / resistance);
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+T min::physics<T,K,L,vec,cell,shape,spatial>::solve_energy_conservation(body<T, vec> &b1, min::body<T, vec> &b2, const vec<T> &n, const vec<T> &intersect)
+{
+    // Calculate the impulse, skip if the bodies are separating
+    const T j = calculate_impulse(b1, b2, n);
+    if (j == 0.0)
+    {
+        return 0.0;
     }
 
     // Get inverse masses of bodies
@@ -438,15 +480,6 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::solve_energy_conservation(body<
     const vec<T> &v1 = b1.get_linear_velocity();
     const vec<T> &v2 = b2.get_linear_velocity();
 
-    // Calculate the relative velocity between b1 and b2 in world space
-    const vec<T> v12 = v1 - v2;
-
-    // Calculate the kinetic resistance of the object
-    const T resistance = inv_m1 + inv_m2;
-
-    // Calculate the impulse
-    const T j = -(1.0 + _elasticity) * (v12.dot(n) / resistance);
-
     // Calculate the impulse vector
     const vec<T> impulse = n * j;
 
@@ -457,6 +490,9 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::solve_energy_conservation(body<
     // Update body linear velocity
     b1.set_linear_velocity(v1_out);
     b2.set_linear_velocity(v2_out);
+
+    // Return the impulse magnitude
+    return j;
 }
 
 // Collision with object of infinite mass
@@ -508,12 +544,15 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::solve_energy_conservation_stati
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
-void min::physics<T,K,L,vec,cell,shape,spatial>::solve_integrals(const size_t index, const T dt, const T damping)
+void min::physics<T,K,L,vec,cell,shape,spatial>::solve_integrals(const size_t index, const T dt, const T damping, const bool ccd)
 {
     // Check if body has died
     body<T, vec> &b = _bodies[index];
     if (b.is_dead())
     {
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.dead++;
+#endif
         return;
     }
 
@@ -533,8 +572,11 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::solve_integrals(const size_t in
     // Calculate the linear velocity at this time step
     const auto v_n1 = v_n + (vk1 + (vk2 * 2.0) + (vk3 * 2.0) + vk4) * dt6;
 
+    // Sweep fast moving bodies against the spatial structure to prevent tunneling
+    const T step = (ccd && b.is_ccd()) ? dt * solve_toi(index, v_n1 * dt) : dt;
+
     // Update the body position at this timestep
-    b.update_position(v_n1, dt, _spatial.get_lower_bound(), _spatial.get_upper_bound());
+    b.update_position(v_n1, step, _spatial.get_lower_bound(), _spatial.get_upper_bound());
 
     // Update the body rotation at this timestep
     const auto abs_rotation = b.update_rotation(dt);
@@ -552,21 +594,117 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::solve_integrals(const size_t in
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
-void min::physics<T,K,L,vec,cell,shape,spatial>::solve_integrals(const T dt, const T damping)
+void min::physics<T,K,L,vec,cell,shape,spatial>::solve_integrals(const T dt, const T damping, const bool ccd)
 {
     // Solve the first order initial value problem differential equations with Runge-Kutta4
     const size_t size = _bodies.size();
     for (size_t i = 0; i < size; i++)
     {
-        solve_integrals(i, dt, damping);
+        solve_integrals(i, dt, damping, ccd);
+    }
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+T min::physics<T,K,L,vec,cell,shape,spatial>::solve_toi(const size_t index, const vec<T> &displacement)
+{
+    // If the body barely moves this timestep it can't tunnel
+    const T length2 = displacement.dot(displacement);
+    if (length2 <= _collision_tolerance * _collision_tolerance)
+    {
+        return 1.0;
+    }
+
+    // Get the shape at the start of this timestep
+    const shape<T, vec> &s = _shapes[index];
+    const vec<T> center = s.get_center();
+    const vec<T> half_extent = (s.get_max() - s.get_min()) * 0.5;
+
+    // Create a box that encloses the shape over the entire sweep
+    const vec<T> sweep_center = center + displacement * 0.5;
+    const vec<T> sweep_extent = half_extent + vec<T>(displacement).abs() * 0.5;
+    const shape<T, vec> sweep(sweep_center - sweep_extent, sweep_center + sweep_extent);
+
+    // Create a ray along the path of the shape center
+    ray<T, vec> r;
+    const T length = r.set(center, center + displacement);
+    const T inv_length = 1.0 / length;
+
+    // Test all shapes overlapping the swept region for the earliest impact
+    const std::vector<K> &map = _spatial.get_index_map();
+    const std::vector<std::pair<K, K>> &overlap = _spatial.get_overlap(sweep);
+    size_t hit = index;
+    T toi = 1.0;
+    vec<T> point;
+    for (const auto &o : overlap)
+    {
+        // Skip this body, any dead bodies and bodies on layers we don't collide with
+        const size_t other = map[o.first];
+        if (other == index || _bodies[other].is_dead() || !_filters[index].collides(_filters[other]))
+        {
+            continue;
+        }
+
+        // Sweeping a box against a box is a ray against the minkowski sum of both boxes
+        const shape<T, vec> &s2 = _shapes[other];
+        const aabbox<T, vec> box(s2.get_min() - half_extent, s2.get_max() + half_extent);
+
+        // Bodies already intersecting are handled by the collision solver
+        if (intersect(box, r, point))
+        {
+            const T t = (point - center).magnitude() * inv_length;
+            if (t < toi)
+            {
+                hit = other;
+                toi = t;
+            }
+        }
+    }
+
+    // If nothing was hit the body can move the full timestep
+    if (hit == index)
+    {
+        return 1.0;
     }
+
+    // Conservative advancement of the true shape from the box time of impact
+    // Stepping by the distance to the bounding radius can never skip past the target
+    const shape<T, vec> &target = _shapes[hit];
+    const T radius = std::sqrt(s.square_size()) * 0.5;
+    shape<T, vec> moved(s);
+    for (size_t i = 0; i < _ccd_iterations; i++)
+    {
+        // Stop when the shape is touching the target, the collision solver will resolve it
+        moved.set_position(center + displacement * toi);
+        if (intersect(moved, target))
+        {
+            break;
+        }
+
+        // Advance at least the collision tolerance to guarantee progress
+        T gap = std::sqrt(target.square_distance(moved.get_center())) - radius;
+        if (gap < _collision_tolerance)
+        {
+            gap = _collision_tolerance;
+        }
+
+        // If we advance past the end of the timestep there was no impact
+        toi += gap * inv_length;
+        if (toi >= 1.0)
+        {
+            return 1.0;
+        }
+    }
+
+    return toi;
 }
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 min::physics<T,K,L,vec,cell,shape,spatial>::physics(const cell<T, vec> &world, const vec<T> &gravity)
     : _spatial(world),
-      _gravity(gravity), _elasticity(1.0), _clean(true) {}
+      _gravity(gravity), _elasticity(1.0),
+      _fixed_dt(1.0 / 60.0), _accum_time(0.0), _max_steps(4), _clean(true) {}
 
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
@@ -596,6 +734,9 @@ size_t min::physics<T,K,L,vec,cell,shape,spatial>::add_body(const shape<T, vec>
         // Recycle shape
         _shapes[index] = in_s;
 
+        // Reset the collision filter
+        _filters[index] = collision_filter();
+
         // Recycle body
         _bodies[index] = body<T, vec>(center, _gravity, mass, id, data);
 
@@ -606,6 +747,9 @@ size_t min::physics<T,K,L,vec,cell,shape,spatial>::add_body(const shape<T, vec>
     // Add shape to shape vector
     _shapes.push_back(in_s);
 
+    // Add default collision filter for this shape
+    _filters.emplace_back();
+
     // Create rigid body for this shape
     _bodies.emplace_back(center, _gravity, mass, id, data);
 
@@ -641,9 +785,15 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::clear()
     // Clear out the shapes
     _shapes.clear();
 
+    // Clear out the collision filters
+    _filters.clear();
+
     // Clear out the bodies
     _bodies.clear();
 
+    // Clear out the contact events
+    _contacts.clear();
+
     // Clear out the dead bodies
     _dead.clear();
 
@@ -651,6 +801,14 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::clear()
     _clean = true;
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::clear_contacts()
+{
+    // Drain the contact events, the buffer keeps its capacity for the next solve
+    _contacts.clear();
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 bool min::physics<T,K,L,vec,cell,shape,spatial>::collide(const size_t index, const shape<T, vec> &s)
@@ -694,6 +852,120 @@ const std::vector<std::pair<K, vec<T>>> &min::physics<T,K,L,vec,cell,shape,spati
     return _spatial.get_collisions(r);
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::get_collisions(thread_pool &pool, const std::vector<ray<T, vec>> &rays, const std::vector<uint32_t> &masks, std::vector<ray_hit<T, vec>> &out) const
+{
+    // Masks are optional, but if given there must be one per ray
+    const size_t size = rays.size();
+    if (masks.size() > 0 && masks.size() != size)
+    {
+        throw std::runtime_error("physics: ray mask count does not match ray count");
+    }
+
+    // Split the rays into blocks, each block owns scratch buffers that are kept between calls
+    const size_t blocks = (size + _ray_block - 1) / _ray_block;
+    if (_ray_hits.size() < blocks)
+    {
+        _ray_hits.resize(blocks);
+        _ray_cache.resize(blocks);
+    }
+    out.resize(size);
+
+    // Get the index map for converting keys to bodies
+    const std::vector<K> &map = _spatial.get_index_map();
+
+    // Cast a block of rays against the spatial structure
+    const auto work = [this, size, &rays, &masks, &out, &map](const size_t block) {
+        std::vector<std::pair<K, vec<T>>> &hits = _ray_hits[block];
+        std::vector<std::vector<size_t>> &cache = _ray_cache[block];
+        const size_t begin = block * _ray_block;
+        const size_t end = (begin + _ray_block < size) ? begin + _ray_block : size;
+        for (size_t i = begin; i < end; i++)
+        {
+            // Get shapes intersecting the ray on the ray layers
+            const ray<T, vec> &r = rays[i];
+            const uint32_t mask = (masks.size() > 0) ? masks[i] : 0xFFFFFFFF;
+            _spatial.get_collisions(r, mask, hits, cache);
+
+            // Find the closest living body
+            out[i] = ray_hit<T, vec>();
+            T closest = 0.0;
+            for (const auto &hit : hits)
+            {
+                const size_t index = map[hit.first];
+                if (_bodies[index].is_dead())
+                {
+                    continue;
+                }
+
+                // Compare square distance from the ray origin
+                const vec<T> d = hit.second - r.get_origin();
+                const T d2 = d.dot(d);
+                if (!out[i].is_hit() || d2 < closest)
+                {
+                    closest = d2;
+                    out[i] = ray_hit<T, vec>(index, hit.second, d2);
+                }
+            }
+
+            // Convert the square distance
+            if (out[i].is_hit())
+            {
+                out[i] = ray_hit<T, vec>(out[i].get_index(), out[i].get_point(), std::sqrt(closest));
+            }
+        }
+    };
+
+    // Cast all blocks in parallel
+    pool.run(work, 0, blocks);
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+const std::vector<min::contact<T, vec>> &min::physics<T,K,L,vec,cell,shape,spatial>::get_contacts() const
+{
+    return _contacts;
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+const min::collision_filter &min::physics<T,K,L,vec,cell,shape,spatial>::get_filter(const size_t index) const
+{
+    return _filters[index];
+}
+
+#ifdef MGL_PHYSICS_PROFILE
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+const min::physics_stats &min::physics<T,K,L,vec,cell,shape,spatial>::get_stats() const
+{
+    // Return the stats of the last timestep
+    return _stats;
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+const min::physics_stats &min::physics<T,K,L,vec,cell,shape,spatial>::get_stats(const size_t age) const
+{
+    // Return the stats of the timestep 'age' steps before the last timestep
+    const size_t size = _history.size();
+    if (age >= size)
+    {
+        throw std::runtime_error("physics: stats history index out of range");
+    }
+
+    return _history[(_history_index + size - 1 - age) % size];
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+size_t min::physics<T,K,L,vec,cell,shape,spatial>::get_stats_size() const
+{
+    return _history.size();
+}
+#endif
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 const vec<T> &min::physics<T,K,L,vec,cell,shape,spatial>::get_gravity() const
@@ -722,6 +994,14 @@ const size_t min::physics<T,K,L,vec,cell,shape,spatial>::get_scale() const
     return _spatial.get_scale();
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+T min::physics<T,K,L,vec,cell,shape,spatial>::get_interpolation() const
+{
+    // Fraction of a fixed timestep left in the accumulator
+    return _accum_time / _fixed_dt;
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 const shape<T, vec> &min::physics<T,K,L,vec,cell,shape,spatial>::get_shape(const size_t index) const
@@ -729,6 +1009,43 @@ const shape<T, vec> &min::physics<T,K,L,vec,cell,shape,spatial>::get_shape(const
     return _shapes[index];
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::load_state(const physics_state<T, vec, shape> &state)
+{
+    // Restore the simulation state, the spatial structure is rebuilt on the next solve
+    _shapes.assign(state._shapes.begin(), state._shapes.end());
+    _filters.assign(state._filters.begin(), state._filters.end());
+    _bodies.assign(state._bodies.begin(), state._bodies.end());
+    _dead.assign(state._dead.begin(), state._dead.end());
+    _gravity = state._gravity;
+    _elasticity = state._elasticity;
+    _accum_time = state._accum_time;
+    _clean = state._clean;
+
+    // Contact events belong to the discarded timeline
+    _contacts.clear();
+}
+
+#ifdef MGL_PHYSICS_PROFILE
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::push_stats()
+{
+    // Fill the history until full, then overwrite the oldest entry
+    if (_history.size() < _stats_history)
+    {
+        _history.push_back(_stats);
+        _history_index = _history.size() % _stats_history;
+    }
+    else
+    {
+        _history[_history_index] = _stats;
+        _history_index = (_history_index + 1) % _stats_history;
+    }
+}
+#endif
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 void min::physics<T,K,L,vec,cell,shape,spatial>::prune_after(const size_t index)
@@ -752,6 +1069,7 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::prune_after_force(const size_t
     for (size_t i = index; i < size; i++)
     {
         _shapes.pop_back();
+        _filters.pop_back();
         _bodies.pop_back();
     }
 
@@ -768,80 +1086,354 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::prune_after_force(const size_t
     _clean = true;
 }
 
-template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
-    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
-void min::physics<T,K,L,vec,cell,shape,spatial>::register_callback(const size_t index, const std::function<void(body<T, vec> &, min::body<T, vec> &)> &f)
-{
-    _bodies[index].register_callback(f);
-}
-
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 void min::physics<T,K,L,vec,cell,shape,spatial>::reserve(const size_t size)
 {
     // Reserve memory for shapes and bodies
     _shapes.reserve(size);
+    _filters.reserve(size);
     _bodies.reserve(size);
     _dead.reserve(size);
 }
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
-void min::physics<T,K,L,vec,cell,shape,spatial>::solve(const T dt, const T damping)
+void min::physics<T,K,L,vec,cell,shape,spatial>::save_state(physics_state<T, vec, shape> &state) const
 {
+    // Snapshots are copied as raw memory so the state must be trivially copyable
+    static_assert(std::is_trivially_copyable<body<T, vec>>::value, "Physics body is not trivially copyable");
+    static_assert(std::is_trivially_copyable<shape<T, vec>>::value, "Physics shape is not trivially copyable");
+
+    // Copy the simulation state, the snapshot reuses its buffers between saves
+    state._shapes.assign(_shapes.begin(), _shapes.end());
+    state._filters.assign(_filters.begin(), _filters.end());
+    state._bodies.assign(_bodies.begin(), _bodies.end());
+    state._dead.assign(_dead.begin(), _dead.end());
+    state._gravity = _gravity;
+    state._elasticity = _elasticity;
+    state._accum_time = _accum_time;
+    state._clean = _clean;
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::solve_step(const T dt, const T damping)
+{
+#ifdef MGL_PHYSICS_PROFILE
+    // Start profiling this timestep
+    _stats = physics_stats();
+    physics_timer timer;
+#endif
     if (_shapes.size() > 0)
     {
         // Create the spatial partitioning structure based off rigid bodies
         // This reorders the shapes vector so we need to reorganize the shape and body data to reflect this!
-        _spatial.insert(_shapes);
+        _spatial.insert(_shapes, _filters);
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.insert_time = timer.lap();
+#endif
 
         // Get the index map for reordering
         const std::vector<K> &map = _spatial.get_index_map();
 
         // Determine intersecting shapes for contact resolution
         const std::vector<std::pair<K, K>> &collisions = _spatial.get_collisions();
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.collisions_time = timer.lap();
+        _stats.shapes = _shapes.size();
+        _stats.cells = _spatial.get_cells_tested();
+        _stats.pairs = _spatial.get_pairs_tested();
+        _stats.collisions = collisions.size();
+#endif
 
         // Handle all collisions between objects
         for (const auto &c : collisions)
         {
             collide(map[c.first], map[c.second]);
         }
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.collide_time = timer.lap();
+#endif
 
         // Solve the simulation
-        solve_integrals(dt, damping);
+        solve_integrals(dt, damping, true);
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.integrate_time = timer.lap();
+#endif
     }
+#ifdef MGL_PHYSICS_PROFILE
+
+    // Store this timestep in the history
+    push_stats();
+#endif
 }
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
-void min::physics<T,K,L,vec,cell,shape,spatial>::solve_no_collide(const T dt, const T damping)
+void min::physics<T,K,L,vec,cell,shape,spatial>::solve(const T dt, const T damping)
 {
+    // Start a new batch of contact events
+    _contacts.clear();
+
     // Solve the simulation
-    solve_integrals(dt, damping);
+    solve_step(dt, damping);
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+size_t min::physics<T,K,L,vec,cell,shape,spatial>::solve_fixed(const T time, const T damping)
+{
+    // Start a new batch of contact events for all timesteps in this frame
+    _contacts.clear();
+
+    // Accumulate elapsed time and consume it in fixed timesteps
+    if (!std::isfinite(time))
+    {
+        throw std::runtime_error("physics: elapsed time must be finite");
+    }
+    _accum_time += time;
+
+    size_t steps = 0;
+    while (_accum_time >= _fixed_dt)
+    {
+        // If we fall too far behind, drop the remaining time to avoid a spiral of death
+        if (steps == _max_steps)
+        {
+            _accum_time = std::fmod(_accum_time, _fixed_dt);
+            break;
+        }
+
+        // Store the body state for interpolation
+        for (auto &b : _bodies)
+        {
+            b.update_previous();
+        }
+
+        // Solve the simulation
+        solve_step(_fixed_dt, damping);
+
+        // Consume the time
+        _accum_time -= _fixed_dt;
+        steps++;
+    }
+
+    // Return the number of timesteps simulated
+    return steps;
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::solve_no_collide(const T dt, const T damping)
+{
+#ifdef MGL_PHYSICS_PROFILE
+    // Start profiling this timestep
+    _stats = physics_stats();
+    physics_timer timer;
+#endif
+
+    // Solve the simulation, the spatial structure is not built so skip sweeping
+    solve_integrals(dt, damping, false);
+#ifdef MGL_PHYSICS_PROFILE
+    _stats.integrate_time = timer.lap();
+
+    // Store this timestep in the history
+    push_stats();
+#endif
 }
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
     template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
 void min::physics<T,K,L,vec,cell,shape,spatial>::solve_no_sort(const T dt, const T damping)
 {
+    // Start a new batch of contact events, even if there is nothing to collide
+    _contacts.clear();
+#ifdef MGL_PHYSICS_PROFILE
+
+    // Start profiling this timestep
+    _stats = physics_stats();
+    physics_timer timer;
+#endif
+
     if (_shapes.size() > 0)
     {
         // Create the spatial partitioning structure based off rigid bodies
         // This doesn't reorder the shapes vector
-        _spatial.insert_no_sort(_shapes);
+        _spatial.insert_no_sort(_shapes, _filters);
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.insert_time = timer.lap();
+#endif
 
         // Determine intersecting shapes for contact resolution
         const std::vector<std::pair<K, K>> &collisions = _spatial.get_collisions();
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.collisions_time = timer.lap();
+        _stats.shapes = _shapes.size();
+        _stats.cells = _spatial.get_cells_tested();
+        _stats.pairs = _spatial.get_pairs_tested();
+        _stats.collisions = collisions.size();
+#endif
 
         // Handle all collisions between objects
         for (const auto &c : collisions)
         {
             collide(c.first, c.second);
         }
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.collide_time = timer.lap();
+#endif
+
+        // Solve the simulation, sweeping needs the sorted index map so skip it
+        solve_integrals(dt, damping, false);
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.integrate_time = timer.lap();
+#endif
+    }
+#ifdef MGL_PHYSICS_PROFILE
 
-        // Solve the simulation
-        solve_integrals(dt, damping);
+    // Store this timestep in the history
+    push_stats();
+#endif
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::solve_parallel(thread_pool &pool, const T dt, const T damping)
+{
+    // Start a new batch of contact events
+    _contacts.clear();
+#ifdef MGL_PHYSICS_PROFILE
+
+    // Start profiling this timestep
+    _stats = physics_stats();
+    physics_timer timer;
+#endif
+
+    if (_shapes.size() > 0)
+    {
+        // Create the spatial partitioning structure based off rigid bodies
+        _spatial.insert(_shapes, _filters);
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.insert_time = timer.lap();
+#endif
+
+        // Get the index map for reordering
+        const std::vector<K> &map = _spatial.get_index_map();
+
+        // Determine intersecting shapes for contact resolution
+        const std::vector<std::pair<K, K>> &collisions = _spatial.get_collisions();
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.collisions_time = timer.lap();
+        _stats.shapes = _shapes.size();
+        _stats.cells = _spatial.get_cells_tested();
+        _stats.pairs = _spatial.get_pairs_tested();
+        _stats.collisions = collisions.size();
+#endif
+
+        // Convert collisions to body index pairs and sort them into a canonical order
+        _pairs.clear();
+        for (const auto &c : collisions)
+        {
+            const size_t a = map[c.first];
+            const size_t b = map[c.second];
+            if (a < b)
+            {
+                _pairs.emplace_back(a, b);
+            }
+            else
+            {
+                _pairs.emplace_back(b, a);
+            }
+        }
+        std::sort(_pairs.begin(), _pairs.end());
+
+        // Color the contact pairs into batches that share no bodies
+        // Each pair goes in the first batch after the last batch of both its bodies
+        // so every body sees its contacts in canonical order
+        const size_t size = _bodies.size();
+        const size_t pair_size = _pairs.size();
+        _pair_batch.resize(pair_size);
+        _body_batch.assign(size, 0);
+        size_t batches = 0;
+        for (size_t i = 0; i < pair_size; i++)
+        {
+            const size_t a = _pairs[i].first;
+            const size_t b = _pairs[i].second;
+            const size_t batch = std::max(_body_batch[a], _body_batch[b]);
+            _pair_batch[i] = batch;
+            _body_batch[a] = _body_batch[b] = batch + 1;
+            batches = std::max(batches, batch + 1);
+        }
+
+        // Count the contact pairs of each batch
+        _batch_offset.assign(batches + 1, 0);
+        for (size_t i = 0; i < pair_size; i++)
+        {
+            _batch_offset[_pair_batch[i] + 1]++;
+        }
+
+        // Prefix sum the counts into offsets
+        for (size_t i = 0; i < batches; i++)
+        {
+            _batch_offset[i + 1] += _batch_offset[i];
+        }
+
+        // List the contact pairs of each batch in canonical order
+        _batch_pairs.resize(pair_size);
+        _batch_fill.assign(_batch_offset.begin(), _batch_offset.end() - 1);
+        for (size_t i = 0; i < pair_size; i++)
+        {
+            _batch_pairs[_batch_fill[_pair_batch[i]]++] = i;
+        }
+
+        // Solve the batches in order, pairs within a batch touch different bodies so they are solved in parallel
+        // This gives the same result as solving the pairs serially in canonical order for any pool size
+        _pair_solve.resize(pair_size);
+        const auto solve_pair = [this](const size_t i) { collide_parallel(_batch_pairs[i]); };
+        for (size_t i = 0; i < batches; i++)
+        {
+            pool.run(solve_pair, _batch_offset[i], _batch_offset[i + 1]);
+        }
+
+        // Record the contact events in canonical order
+        for (size_t i = 0; i < pair_size; i++)
+        {
+            const contact_solve<T, vec> &c = _pair_solve[i];
+            if (c.hit)
+            {
+                _contacts.emplace_back(_pairs[i].first, _pairs[i].second, c.point, c.normal, c.impulse);
+            }
+        }
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.collide_time = timer.lap();
+#endif
+
+        // Solve the simulation, sweeping shares spatial buffers between threads so skip it
+        const auto integrate = [this, dt, damping](const size_t i) {
+            if (!_bodies[i].is_dead())
+            {
+                solve_integrals(i, dt, damping, false);
+            }
+        };
+        pool.run(integrate, 0, size);
+#ifdef MGL_PHYSICS_PROFILE
+        _stats.integrate_time = timer.lap();
+
+        // Count the dead bodies that were skipped
+        for (const auto &b : _bodies)
+        {
+            if (b.is_dead())
+            {
+                _stats.dead++;
+            }
+        }
+#endif
     }
+#ifdef MGL_PHYSICS_PROFILE
+
+    // Store this timestep in the history
+    push_stats();
+#endif
 }
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
@@ -871,3 +1463,30 @@ void min::physics<T,K,L,vec,cell,shape,spatial>::set_elasticity(const T e)
 {
     _elasticity = e;
 }
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::set_filter(const size_t index, const min::collision_filter &filter)
+{
+    _filters[index] = filter;
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class spatial>
+void min::physics<T,K,L,vec,cell,shape,spatial>::set_fixed_timestep(const T dt, const size_t max_steps)
+{
+    // A non positive timestep would never consume the accumulated time
+    if (!(dt > 0.0) || !std::isfinite(dt))
+    {
+        throw std::runtime_error("physics: fixed timestep must be positive and finite");
+    }
+
+    // Limit the substeps so one frame can't stall the caller
+    if (max_steps == 0 || max_steps > _fixed_step_limit)
+    {
+        throw std::runtime_error("physics: fixed timestep steps must be between 1 and 64");
+    }
+
+    _fixed_dt = dt;
+    _max_steps = max_steps;
+}
@@ -37,12 +37,18 @@ limitations under the License.
 // k3 = f(t_n + 0.5*dt, y_n + 0.5*k2*dt)
 // k4 = f(t_n + dt, y_n + k3*dt)
 
+#include <algorithm>
 #include <cmath>
-#include <functional>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#include "collision_filter.h"
+#include "contact.h"
+#include "physics_stats.h"
+#include "ray_hit.h"
 #include "geom/min/intersect.h"
+#include "platform/min/thread_pool.h"
 #include "template_math.h"
 
 namespace min
@@ -65,6 +71,8 @@ class body_base
     vec<T> _force;
     vec<T> _position; // This is at the center of mass
     rot<T> _rotation;
+    vec<T> _prev_position; // Previous state for render interpolation
+    rot<T> _prev_rotation;
     vec<T> _linear_velocity;
     angular _angular_velocity;
     T _mass;
@@ -72,6 +80,7 @@ class body_base
     size_t _id;
     body_data _data;
     bool _dead;
+    bool _ccd;
 
   public:
     body_base(const vec<T>&, const vec<T>&, const T, const size_t, const body_data);
@@ -86,11 +95,15 @@ class body_base
     const vec<T> &get_linear_velocity() const;
     const T get_mass() const;
     const T get_inv_mass() const;
+    vec<T> get_interpolated_position(const T) const;
+    rot<T> get_interpolated_rotation(const T) const;
     const rot<T> &get_rotation() const;
     const vec<T> &get_position() const;
+    bool is_ccd() const;
     bool is_dead() const;
     void kill();
     void set_angular_velocity(const angular);
+    void set_ccd(const bool);
     void set_data(const body_data);
     void set_linear_velocity(const vec<T>&);
     void set_no_move();
@@ -98,6 +111,7 @@ class body_base
     void set_rotation(const rot<T>&);
     const void move_offset(const vec<T>&);
     void update_position(const vec<T>&, const T, const vec<T>&, const vec<T>&);
+    void update_previous();
 
 };
 
@@ -110,14 +124,8 @@ class body : public body_base<T, vec, vec<T>, quat>
 template <typename T>
 class body<T, vec2> : public body_base<T, vec2, T, mat2>
 {
-  private:
-    std::function<void(body<T, vec2> &, body<T, vec2> &)> _f;
-
   public:
     body(const vec2<T>&, const vec2<T>&, const T, const size_t, const body_data);
-
-    void callback(body<T, vec2>&);
-    void register_callback(const std::function<void(body<T, vec2>&, body<T, vec2>&)>&);
     mat2<T> update_rotation(const T);
 };
 
@@ -125,14 +133,8 @@ class body<T, vec2> : public body_base<T, vec2, T, mat2>
 template <typename T>
 class body<T, vec3> : public body_base<T, vec3, vec3<T>, quat>
 {
-  private:
-    std::function<void(body<T, vec3> &, body<T, vec3> &)> _f;
-
   public:
     body(const vec3<T>&, const vec3<T>&, const T, const size_t, const body_data);
-
-    void callback(body<T, vec3>&);
-    void register_callback(const std::function<void(body<T, vec3>&, body<T, vec3>&)>&);
     quat<T> update_rotation(const T);
 };
 
@@ -140,15 +142,42 @@ class body<T, vec3> : public body_base<T, vec3, vec3<T>, quat>
 template <typename T>
 class body<T, vec4> : public body_base<T, vec4, vec4<T>, quat>
 {
+  public:
+    body(const vec4<T>&, const vec4<T>&, const T, const size_t, const body_data);
+    quat<T> update_rotation(const T);
+};
+
+template <typename T, template <typename> class vec, template <typename, template <typename> class> class shape>
+class physics_state
+{
+    // Only physics can read or write a snapshot
+    template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class,
+              template <typename, typename, typename, template <typename> class, template <typename, template <typename> class> class, template <typename, template <typename> class> class> class>
+    friend class physics;
+
   private:
-    std::function<void(body<T, vec4> &, body<T, vec4> &)> _f;
+    std::vector<shape<T, vec>> _shapes;
+    std::vector<collision_filter> _filters;
+    std::vector<body<T, vec>> _bodies;
+    std::vector<size_t> _dead;
+    vec<T> _gravity;
+    T _elasticity;
+    T _accum_time;
+    bool _clean;
 
   public:
-    body(const vec4<T>&, const vec4<T>&, const T, const size_t, const body_data);
+    physics_state() : _elasticity(1.0), _accum_time(0.0), _clean(true) {}
+};
 
-    void callback(body<T, vec4>&);
-    void register_callback(const std::function<void(body<T, vec4>&, body<T, vec4>&)>&);
-    quat<T> update_rotation(const T);
+// The contact event of one pair solved by the parallel solver
+// Events are recorded after solving in canonical pair order
+template <typename T, template <typename> class vec>
+struct contact_solve
+{
+    vec<T> normal;
+    vec<T> point;
+    T impulse;
+    bool hit;
 };
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape,
@@ -158,15 +187,41 @@ class physics
   private:
     spatial<T, K, L, vec, cell, shape> _spatial;
     std::vector<shape<T, vec>> _shapes;
+    std::vector<collision_filter> _filters;
     std::vector<body<T, vec>> _bodies;
+    std::vector<contact<T, vec>> _contacts;
     std::vector<size_t> _dead;
+    std::vector<std::pair<size_t, size_t>> _pairs;
+    std::vector<contact_solve<T, vec>> _pair_solve;
+    std::vector<size_t> _pair_batch;
+    std::vector<size_t> _body_batch;
+    std::vector<size_t> _batch_offset;
+    std::vector<size_t> _batch_fill;
+    std::vector<size_t> _batch_pairs;
     vec<T> _gravity;
     T _elasticity;
+    T _fixed_dt;
+    T _accum_time;
+    size_t _max_steps;
     bool _clean;
 
     static constexpr T _collision_tolerance = 1E-4;
+    static constexpr size_t _ccd_iterations = 8;
+    static constexpr size_t _fixed_step_limit = 64;
+    static constexpr size_t _ray_block = 64;
+    mutable std::vector<std::vector<std::pair<K, vec<T>>>> _ray_hits;
+    mutable std::vector<std::vector<std::vector<size_t>>> _ray_cache;
+#ifdef MGL_PHYSICS_PROFILE
+    static constexpr size_t _stats_history = 64;
+    physics_stats _stats;
+    std::vector<physics_stats> _history;
+    size_t _history_index = 0;
+
+    void push_stats();
+#endif
 
     void collide(const size_t, const size_t);
+    void collide_parallel(const size_t);
     bool collide_static(const size_t, const shape<T, vec>&);
 
     // The normal axis is defined to be the vector between b1 and b2, pointing towards b1
@@ -179,12 +234,18 @@ class physics
     // dL1 = (P - C1) x J1
     // dL2 = (P - C2) x J2
 
+    // Impulse along the collision normal, zero if the bodies are separating
+    T calculate_impulse(const body<T, vec>&, const body<T, vec>&, const vec<T>&) const;
     // Intersection piont intersect
-    void solve_energy_conservation(body<T, vec>&, body<T, vec>&, const vec<T>&, const vec<T>&);
+    T solve_energy_conservation(body<T, vec>&, body<T, vec>&, const vec<T>&, const vec<T>&);
     // Collision with object of infinite mass
     void solve_energy_conservation_static(body<T, vec>&, const vec<T>&, const vec<T>&);
-    void solve_integrals(const size_t, const T, const T);
-    void solve_integrals(const T, const T);
+    void solve_integrals(const size_t, const T, const T, const bool);
+    void solve_integrals(const T, const T, const bool);
+
+    // Sweeps the body shape along the displacement and returns the time of impact on [0, 1]
+    T solve_toi(const size_t, const vec<T>&);
+    void solve_step(const T, const T);
 
   public:
     physics(const cell<T, vec> &world, const vec<T> &gravity);
@@ -193,26 +254,41 @@ class physics
     vec<T> clamp_bounds(const vec<T>&) const;
     void clear_body(const size_t);
     void clear();
+    void clear_contacts();
     bool collide(const size_t, const shape<T, vec>&);
     const body<T, vec> &get_body(const size_t) const;
     body<T, vec> &get_body(const size_t);
     const std::vector<body<T, vec>> &get_bodies() const;
     std::vector<body<T, vec>> &get_bodies();
     const std::vector<std::pair<K, vec<T>>> &get_collisions(const ray<T, vec>&) const;
+    void get_collisions(thread_pool&, const std::vector<ray<T, vec>>&, const std::vector<uint32_t>&, std::vector<ray_hit<T, vec>>&) const;
+    const std::vector<contact<T, vec>> &get_contacts() const;
+    const collision_filter &get_filter(const size_t) const;
+#ifdef MGL_PHYSICS_PROFILE
+    const physics_stats &get_stats() const;
+    const physics_stats &get_stats(const size_t) const;
+    size_t get_stats_size() const;
+#endif
     const vec<T> &get_gravity() const;
     const std::vector<K> &get_index_map() const;
     const std::vector<std::pair<K, K>> &get_overlap(const shape<T, vec>&) const;
     const size_t get_scale() const;
+    T get_interpolation() const;
     const shape<T, vec> &get_shape(const size_t) const;
+    void load_state(const physics_state<T, vec, shape>&);
     void prune_after(const size_t);
     void prune_after_force(const size_t);
-    void register_callback(const size_t, const std::function<void(body<T, vec>&, body<T, vec>&)>&);
     void reserve(const size_t);
+    void save_state(physics_state<T, vec, shape>&) const;
     void solve(const T, const T);
+    size_t solve_fixed(const T, const T);
     void solve_no_collide(const T, const T);
     void solve_no_sort(const T, const T);
+    void solve_parallel(thread_pool&, const T, const T);
     T get_total_energy() const;
     void set_elasticity(const T);
+    void set_filter(const size_t, const collision_filter&);
+    void set_fixed_timestep(const T, const size_t);
 
 };
 }
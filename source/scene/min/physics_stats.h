@@ -0,0 +1,68 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef PHYSICS_STATS
+#define PHYSICS_STATS
+
+#include <chrono>
+#include <cstddef>
+
+// Physics profiling is only compiled in when MGL_PHYSICS_PROFILE is defined
+
+namespace min
+{
+
+// Per phase wall times in seconds and counts for a single physics timestep
+struct physics_stats
+{
+    double insert_time;
+    double collisions_time;
+    double collide_time;
+    double integrate_time;
+    size_t shapes;
+    size_t cells;
+    size_t pairs;
+    size_t collisions;
+    size_t dead;
+    physics_stats()
+        : insert_time(0.0), collisions_time(0.0), collide_time(0.0), integrate_time(0.0),
+          shapes(0), cells(0), pairs(0), collisions(0), dead(0) {}
+
+    inline double get_total_time() const
+    {
+        return insert_time + collisions_time + collide_time + integrate_time;
+    }
+};
+
+class physics_timer
+{
+  private:
+    std::chrono::high_resolution_clock::time_point _start;
+
+  public:
+    physics_timer() : _start(std::chrono::high_resolution_clock::now()) {}
+
+    // Returns the seconds since the last lap and restarts the timer
+    inline double lap()
+    {
+        const std::chrono::high_resolution_clock::time_point now = std::chrono::high_resolution_clock::now();
+        const double out = std::chrono::duration<double>(now - _start).count();
+        _start = now;
+
+        return out;
+    }
+};
+}
+
+#endif
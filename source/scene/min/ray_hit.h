@@ -0,0 +1,57 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef RAY_HIT
+#define RAY_HIT
+
+#include <cstddef>
+
+namespace min
+{
+
+// The closest body hit by a ray, the body index is only valid if is_hit() is true
+template <typename T, template <typename> class vec>
+class ray_hit
+{
+  private:
+    size_t _index;
+    vec<T> _point;
+    T _distance;
+    bool _hit;
+
+  public:
+    ray_hit() : _index(0), _distance(0.0), _hit(false) {}
+    ray_hit(const size_t index, const vec<T> &point, const T distance)
+        : _index(index), _point(point), _distance(distance), _hit(true) {}
+
+    inline T get_distance() const
+    {
+        return _distance;
+    }
+    inline size_t get_index() const
+    {
+        return _index;
+    }
+    inline const vec<T> &get_point() const
+    {
+        return _point;
+    }
+    inline bool is_hit() const
+    {
+        return _hit;
+    }
+};
+}
+
+#endif
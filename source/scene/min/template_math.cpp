@@ -103,9 +103,9 @@ T min::inverse(const T x)
 template <typename T>
 min::vec3<T> min::inverse(const min::vec3<T> &v)
 {
-    const T x = 1.0 / v.x();
-    const T y = 1.0 / v.y();
-    const T z = 1.0 / v.z();
+    const T x = 1.0 / v.x;
+    const T y = 1.0 / v.y;
+    const T z = 1.0 / v.z;
 
     return vec3<T>(x, y, z);
 }
@@ -120,6 +120,35 @@ min::vec4<T> min::inverse(const min::vec4<T> &v)
     return vec4<T>(x, y, z, 1.0);
 }
 
+template <typename T>
+min::mat2<T> min::interpolate(const min::mat2<T> &m0, const min::mat2<T> &m1, const T t)
+{
+    // Extract the rotation angles from the rotated x axis
+    const vec2<T> x0 = m0.transform(vec2<T>(1.0, 0.0));
+    const vec2<T> x1 = m1.transform(vec2<T>(1.0, 0.0));
+    const T a0 = std::atan2(x0.y, x0.x);
+    T delta = std::atan2(x1.y, x1.x) - a0;
+
+    // Take the shortest path between the two angles
+    if (delta > var<T>::PI)
+    {
+        delta -= 2.0 * var<T>::PI;
+    }
+    else if (delta < -var<T>::PI)
+    {
+        delta += 2.0 * var<T>::PI;
+    }
+
+    // Create rotation matrix from interpolated angle in degrees
+    return mat2<T>(rad_to_deg<T>(a0 + delta * t));
+}
+
+template <typename T>
+min::quat<T> min::interpolate(const min::quat<T> &q0, const min::quat<T> &q1, const T t)
+{
+    return quat<T>::interpolate(q0, q1, t);
+}
+
 // AABB
 template <typename T>
 T min::get_inertia(const min::aabbox<T, min::vec2> &box, const T mass)
@@ -128,7 +157,7 @@ T min::get_inertia(const min::aabbox<T, min::vec2> &box, const T mass)
     const vec3<T> &b = box.get_extent();
 
     // return the local inertia
-    return (b.x() * b.x() + b.y() * b.y()) * mass * 0.0833;
+    return (b.x * b.x + b.y * b.y) * mass * 0.0833;
 }
 
 template <typename T>
@@ -138,9 +167,9 @@ min::vec3<T> min::get_inertia(const min::aabbox<T, min::vec3> &box, const T mass
     // Iy = (1/12) * (x^2 + z^2)
     // Iz = (1/12) * (x^2 + y^2)
     const vec3<T> &b = box.get_extent();
-    const T x2 = b.x() * b.x();
-    const T y2 = b.y() * b.y();
-    const T z2 = b.z() * b.z();
+    const T x2 = b.x * b.x;
+    const T y2 = b.y * b.y;
+    const T z2 = b.z * b.z;
 
     // return the local inertia
     return vec3<T>(y2 + z2, x2 + z2, x2 + y2) * mass * 0.0833;
@@ -153,9 +182,9 @@ min::vec4<T> min::get_inertia(const min::aabbox<T, min::vec4> &box, const T mass
     // Iy = (1/12) * (x^2 + z^2)
     // Iz = (1/12) * (x^2 + y^2)
     const vec3<T> &b = box.get_extent();
-    const T x2 = b.x() * b.x();
-    const T y2 = b.y() * b.y();
-    const T z2 = b.z() * b.z();
+    const T x2 = b.x * b.x;
+    const T y2 = b.y * b.y;
+    const T z2 = b.z * b.z;
 
     // return the local inertia
     return vec3<T>(y2 + z2, x2 + z2, x2 + y2) * mass * 0.0833;
@@ -169,7 +198,7 @@ T min::get_inertia(const min::oobbox<T, min::vec2> &box, const T mass)
     const vec3<T> &b = box.get_extent();
 
     // return the local inertia
-    return (b.x() * b.x() + b.y() * b.y()) * mass * 0.0833;
+    return (b.x * b.x + b.y * b.y) * mass * 0.0833;
 }
 
 template <typename T>
@@ -179,9 +208,9 @@ min::vec3<T> min::get_inertia(const min::oobbox<T, min::vec3> &box, const T mass
     // Iy = (1/12) * (x^2 + z^2)
     // Iz = (1/12) * (x^2 + y^2)
     const vec3<T> &b = box.get_extent();
-    const T x2 = b.x() * b.x();
-    const T y2 = b.y() * b.y();
-    const T z2 = b.z() * b.z();
+    const T x2 = b.x * b.x;
+    const T y2 = b.y * b.y;
+    const T z2 = b.z * b.z;
 
     // return the local inertia
     return vec3<T>(y2 + z2, x2 + z2, x2 + y2) * mass * 0.0833;
@@ -194,9 +223,9 @@ min::vec4<T> min::get_inertia(const min::oobbox<T, min::vec4> &box, const T mass
     // Iy = (1/12) * (x^2 + z^2)
     // Iz = (1/12) * (x^2 + y^2)
     const vec3<T> &b = box.get_extent();
-    const T x2 = b.x() * b.x();
-    const T y2 = b.y() * b.y();
-    const T z2 = b.z() * b.z();
+    const T x2 = b.x * b.x;
+    const T y2 = b.y * b.y;
+    const T z2 = b.z * b.z;
 
     // return the local inertia
     return vec4<T>(y2 + z2, x2 + z2, x2 + y2, 1.0) * mass * 0.0833;
@@ -43,6 +43,8 @@ template <typename T> T dot(const vec4<T>&, const vec4<T>&);
 template <typename T> T inverse(const T);
 template <typename T> vec3<T> inverse(const vec3<T>&);
 template <typename T> vec4<T> inverse(const vec4<T>&);
+template <typename T> mat2<T> interpolate(const mat2<T>&, const mat2<T>&, const T);
+template <typename T> quat<T> interpolate(const quat<T>&, const quat<T>&, const T);
 template <typename T> T get_inertia(const aabbox<T, vec2>&, const T);
 template <typename T> vec3<T> get_inertia(const aabbox<T, vec3>&, const T);
 template <typename T> vec4<T> get_inertia(const aabbox<T, vec4>&, const T);
@@ -63,12 +63,6 @@ const cell<T, vec> &min::tree_node<T,K,L,vec,cell,shape>::get_cell() const
     return _cell;
 }
 
-template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
-std::vector<size_t> &min::tree_node<T,K,L,vec,cell,shape>::get_sub_ray_cache() const
-{
-    return _sub_ray_cache;
-}
-
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 bool min::tree_node<T,K,L,vec,cell,shape>::point_inside(const vec<T> &point) const
 {
@@ -226,6 +220,12 @@ void min::tree<T,K,L,vec,cell,shape>::get_pairs(const min::tree_node<T, K, L, ve
     // Perform an N^2-N intersection test for all shapes in this cell
     const std::vector<K> &keys = node.get_keys();
     const K size = keys.size();
+#ifdef MGL_PHYSICS_PROFILE
+    if (size > 1)
+    {
+        _cells_tested++;
+    }
+#endif
     for (K i = 0; i < size; i++)
     {
         for (K j = i + 1; j < size; j++)
@@ -239,12 +239,21 @@ void min::tree<T,K,L,vec,cell,shape>::get_pairs(const min::tree_node<T, K, L, ve
                 b = keys[i];
             }
 
+            // Skip pairs whose layers can't collide before doing any work
+            if (_filters.size() > 0 && !_filters[a].collides(_filters[b]))
+            {
+                continue;
+            }
+
             // Add the test to flags to avoid retesting
             if (!_flags.get_set_on(a, b))
             {
                 // Get the two cells
                 const shape<T, vec> &a_shape = _shapes[a];
                 const shape<T, vec> &b_shape = _shapes[b];
+#ifdef MGL_PHYSICS_PROFILE
+                _pairs_tested++;
+#endif
                 if (intersect(a_shape, b_shape))
                 {
                     _hits.emplace_back(a, b);
@@ -284,7 +293,7 @@ void min::tree<T,K,L,vec,cell,shape>::get_pairs(const min::tree_node<T, K, L, ve
 }
 
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
-void min::tree<T,K,L,vec,cell,shape>::get_ray_intersect(const min::tree_node<T, K, L, vec, cell, shape> &node, const min::ray<T, vec> &r, const K depth) const
+void min::tree<T,K,L,vec,cell,shape>::get_ray_intersect(const min::tree_node<T, K, L, vec, cell, shape> &node, const min::ray<T, vec> &r, const K depth, const uint32_t mask, std::vector<std::pair<K, vec<T>>> &hits, std::vector<std::vector<size_t>> &cache) const
 {
     // We are at a leaf node and we have hit the stopping criteria
     if (depth == 0)
@@ -296,10 +305,17 @@ void min::tree<T,K,L,vec,cell,shape>::get_ray_intersect(const min::tree_node<T,
         for (K i = 0; i < size; i++)
         {
             const K key = keys[i];
+
+            // Skip shapes that are not on the ray layers
+            if (_filters.size() > 0 && !(_filters[key].get_category() & mask))
+            {
+                continue;
+            }
+
             const shape<T, vec> &s = _shapes[key];
             if (intersect(s, r, point))
             {
-                _ray_hits.emplace_back(key, point);
+                hits.emplace_back(key, point);
             }
         }
     }
@@ -311,15 +327,15 @@ void min::tree<T,K,L,vec,cell,shape>::get_ray_intersect(const min::tree_node<T,
         // Get the current node cell
         const cell<T, vec> &c = node.get_cell();
 
-        // For all child nodes intersecting ray
-        std::vector<size_t> &keys = node.get_sub_ray_cache();
+        // For all child nodes intersecting ray, each depth has its own scratch list
+        std::vector<size_t> &keys = cache[depth];
         vec<T>::subdivide_ray(keys, c.get_min(), c.get_max(), r.get_origin(), r.get_direction(), r.get_inverse());
         for (const size_t k : keys)
         {
             // If we haven't hit anything yet
-            if (_ray_hits.size() == 0)
+            if (hits.size() == 0)
             {
-                get_ray_intersect(children[k], r, depth - 1);
+                get_ray_intersect(children[k], r, depth - 1, mask, hits, cache);
             }
         }
     }
@@ -394,6 +410,18 @@ void min::tree<T,K,L,vec,cell,shape>::sort(const std::vector<shape<T, vec>> &sha
     }
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::tree<T,K,L,vec,cell,shape>::sort_filters(const std::vector<collision_filter> &filters)
+{
+    // Store filters in the same order as the sorted shapes
+    _filters.clear();
+    _filters.reserve(_index_map.size());
+    for (const auto &i : _index_map)
+    {
+        _filters.emplace_back(filters[i]);
+    }
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 min::tree<T,K,L,vec,cell,shape>::tree(const cell<T, vec> &c)
     : _root(c),
@@ -501,6 +529,10 @@ const std::vector<std::pair<K, K>> &min::tree<T,K,L,vec,cell,shape>::get_collisi
     _flags.clear();
     _hits.clear();
     _hits.reserve(_shapes.size());
+#ifdef MGL_PHYSICS_PROFILE
+    _cells_tested = 0;
+    _pairs_tested = 0;
+#endif
 
     // get all intersecting pairs
     get_pairs(_root, _depth);
@@ -534,16 +566,31 @@ template <typename T, typename K, typename L, template <typename> class vec, tem
 const std::vector<std::pair<K, vec<T>>> &min::tree<T,K,L,vec,cell,shape>::get_collisions(const min::ray<T, vec> &r) const
 {
     // Output vector
-    _ray_hits.clear();
     _ray_hits.reserve(_shapes.size());
 
-    // Get shapes intersecting ray with early stop
-    get_ray_intersect(_root, r, _depth);
+    // Get shapes intersecting ray on all layers
+    get_collisions(r, 0xFFFFFFFF, _ray_hits, _ray_cache);
 
     // Return the collision list
     return _ray_hits;
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::tree<T,K,L,vec,cell,shape>::get_collisions(const min::ray<T, vec> &r, const uint32_t mask, std::vector<std::pair<K, vec<T>>> &hits, std::vector<std::vector<size_t>> &cache) const
+{
+    // This overload only writes to the output and cache, so it can be called from many threads
+    hits.clear();
+
+    // Allocate a subdivision list for each depth
+    if (cache.size() < static_cast<size_t>(_depth) + 1)
+    {
+        cache.resize(_depth + 1);
+    }
+
+    // Get shapes intersecting ray with early stop
+    get_ray_intersect(_root, r, _depth, mask, hits, cache);
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 K min::tree<T,K,L,vec,cell,shape>::get_depth() const
 {
@@ -556,6 +603,20 @@ const std::vector<K> &min::tree<T,K,L,vec,cell,shape>::get_index_map() const
     return _index_map;
 }
 
+#ifdef MGL_PHYSICS_PROFILE
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+size_t min::tree<T,K,L,vec,cell,shape>::get_cells_tested() const
+{
+    return _cells_tested;
+}
+
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+size_t min::tree<T,K,L,vec,cell,shape>::get_pairs_tested() const
+{
+    return _pairs_tested;
+}
+#endif
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 const std::vector<std::pair<K, K>> &min::tree<T,K,L,vec,cell,shape>::get_overlap(const shape<T, vec> &overlap) const
 {
@@ -586,6 +647,9 @@ bool min::tree<T,K,L,vec,cell,shape>::inside(const vec<T> &point) const
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 void min::tree<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &shapes)
 {
+    // Don't filter any pairs
+    _filters.clear();
+
     // Set the tree depth
     optimize_depth(shapes);
 
@@ -605,6 +669,9 @@ void min::tree<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &s
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 void min::tree<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &shapes, const K depth)
 {
+    // Don't filter any pairs
+    _filters.clear();
+
     // Set the depth
     _depth = depth;
 
@@ -625,9 +692,22 @@ void min::tree<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &s
     build(_root, _depth);
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::tree<T,K,L,vec,cell,shape>::insert(const std::vector<shape<T, vec>> &shapes, const std::vector<collision_filter> &filters)
+{
+    // Insert and sort the shapes
+    insert(shapes);
+
+    // Sort the filters to match the shapes
+    sort_filters(filters);
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 void min::tree<T,K,L,vec,cell,shape>::insert_no_sort(const std::vector<shape<T, vec>> &shapes)
 {
+    // Don't filter any pairs
+    _filters.clear();
+
     // Set the tree depth
     optimize_depth(shapes);
 
@@ -635,6 +715,10 @@ void min::tree<T,K,L,vec,cell,shape>::insert_no_sort(const std::vector<shape<T,
     _shapes.clear();
     _shapes.insert(_shapes.end(), shapes.begin(), shapes.end());
 
+    // Keys are the shape indices
+    _index_map.resize(_shapes.size());
+    std::iota(_index_map.begin(), _index_map.end(), 0);
+
     // Clear out the root node
     _root.clear();
 
@@ -645,6 +729,16 @@ void min::tree<T,K,L,vec,cell,shape>::insert_no_sort(const std::vector<shape<T,
     build(_root, _depth);
 }
 
+template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
+void min::tree<T,K,L,vec,cell,shape>::insert_no_sort(const std::vector<shape<T, vec>> &shapes, const std::vector<collision_filter> &filters)
+{
+    // Insert shapes without sorting
+    insert_no_sort(shapes);
+
+    // Insert filters without sorting
+    _filters.insert(_filters.end(), filters.begin(), filters.end());
+}
+
 template <typename T, typename K, typename L, template <typename> class vec, template <typename, template <typename> class> class cell, template <typename, template <typename> class> class shape>
 const std::vector<K> &min::tree<T,K,L,vec,cell,shape>::point_inside(const vec<T> &point) const
 {
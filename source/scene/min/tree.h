@@ -20,6 +20,7 @@ limitations under the License.
 #include <stdexcept>
 #include <vector>
 
+#include "collision_filter.h"
 #include "geom/min/intersect.h"
 #include "math/min/utility.h"
 
@@ -49,7 +50,6 @@ class tree_node
     std::vector<tree_node<T, K, L, vec, cell, shape>> _child;
     std::vector<K> _keys;
     cell<T, vec> _cell;
-    mutable std::vector<size_t> _sub_ray_cache;
 
     void add_key(K);
     void clear();
@@ -62,7 +62,6 @@ class tree_node
     const std::vector<tree_node<T, K, L, vec, cell, shape>> &get_children() const;
     const std::vector<K> &get_keys() const;
     const cell<T, vec> &get_cell() const;
-    std::vector<size_t> &get_sub_ray_cache() const;
     bool point_inside(const vec<T>&) const;
     K size() const;
 };
@@ -72,6 +71,7 @@ class tree
 {
   private:
     std::vector<shape<T, vec>> _shapes;
+    std::vector<collision_filter> _filters;
     std::vector<K> _index_map;
     std::vector<size_t> _key_cache;
     std::vector<K> _sort_copy;
@@ -79,6 +79,7 @@ class tree
     mutable bit_flag<K, L> _flags;
     mutable std::vector<std::pair<K, K>> _hits;
     mutable std::vector<std::pair<K, vec<T>>> _ray_hits;
+    mutable std::vector<std::vector<size_t>> _ray_cache;
     tree_node<T, K, L, vec, cell, shape> _root;
     vec<T> _lower_bound;
     vec<T> _upper_bound;
@@ -87,6 +88,10 @@ class tree
     vec<T> _cell_extent;
     bool _depth_override;
     size_t _flag_size;
+#ifdef MGL_PHYSICS_PROFILE
+    mutable size_t _cells_tested = 0;
+    mutable size_t _pairs_tested = 0;
+#endif
 
     void build(tree_node<T, K, L, vec, cell, shape>&, const K);
     void create_keys();
@@ -95,9 +100,10 @@ class tree
     void get_overlap(const tree_node<T, K, L, vec, cell, shape>&, const vec<T>&, const vec<T>&, const K) const;
     void get_pairs(const tree_node<T, K, L, vec, cell, shape>&) const;
     void get_pairs(const tree_node<T, K, L, vec, cell, shape>&, const K) const;
-    void get_ray_intersect(const tree_node<T, K, L, vec, cell, shape>&, const ray<T, vec>&, const K) const;
+    void get_ray_intersect(const tree_node<T, K, L, vec, cell, shape>&, const ray<T, vec>&, const K, const uint32_t, std::vector<std::pair<K, vec<T>>>&, std::vector<std::vector<size_t>>&) const;
     K optimize_depth(const std::vector<shape<T, vec>>&);
     void sort(const std::vector<shape<T, vec>>&);
+    void sort_filters(const std::vector<collision_filter>&);
 
   public:
     tree(const cell<T, vec>&);
@@ -113,13 +119,20 @@ class tree
     const std::vector<std::pair<K, K>> &get_collisions() const;
     const std::vector<std::pair<K, K>> &get_collisions(const vec<T>&) const;
     const std::vector<std::pair<K, vec<T>>> &get_collisions(const ray<T, vec>&) const;
+    void get_collisions(const ray<T, vec>&, const uint32_t, std::vector<std::pair<K, vec<T>>>&, std::vector<std::vector<size_t>>&) const;
     K get_depth() const;
     const std::vector<K> &get_index_map() const;
+#ifdef MGL_PHYSICS_PROFILE
+    size_t get_cells_tested() const;
+    size_t get_pairs_tested() const;
+#endif
     const std::vector<std::pair<K, K>> &get_overlap(const shape<T, vec>&) const;
     bool inside(const vec<T>&) const;
     void insert(const std::vector<shape<T, vec>>&);
     void insert(const std::vector<shape<T, vec>>&, const K depth);
+    void insert(const std::vector<shape<T, vec>>&, const std::vector<collision_filter>&);
     void insert_no_sort(const std::vector<shape<T, vec>>&);
+    void insert_no_sort(const std::vector<shape<T, vec>>&, const std::vector<collision_filter>&);
     const std::vector<K> &point_inside(const vec<T>&) const;
     void set_depth(const K depth);
 
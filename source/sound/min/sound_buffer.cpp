@@ -68,6 +68,23 @@ size_t min::sound_buffer::add_pcm_data(const ALvoid *const data, const ALenum fo
     // Return the index for this data
     return _buffers.size() - 1;
 }
+size_t min::sound_buffer::add_stream(std::unique_ptr<min::ogg_stream> ogg)
+{
+    // Get the al_format and the buffer block size for this stream
+    const ALenum format = al_format(ogg->is_stereo(), ogg->get_bits_per_sample());
+    const size_t block = ogg->get_block_size(STREAM_BLOCK_MS);
+
+    // The stream thread walks the stream list
+    std::lock_guard<std::mutex> lock(_stream_lock);
+
+    // Create the stream and generate the ring of buffers
+    _streams.emplace_back(std::make_unique<sound_stream>(std::move(ogg), format, block));
+    sound_stream &stream = *_streams.back();
+    alGenBuffers(stream._buffers.size(), stream._buffers.data());
+
+    // Return the index for this stream
+    return _streams.size() - 1;
+}
 void min::sound_buffer::clear_error() const
 {
     ALCenum error = alcGetError(_device);
@@ -118,8 +135,44 @@ void min::sound_buffer::create_openal_context()
     // Check for any errors
     throw_internal_error();
 }
+bool min::sound_buffer::fill_stream(sound_stream &stream, const ALuint buffer)
+{
+    // Decode the next block of PCM
+    uint8_t *const block = stream._block.data();
+    const size_t size = stream._block.size();
+    size_t bytes = stream._ogg->decode(block, size);
+
+    // Wrap around to the start of the file if looping
+    if (bytes < size && stream._loop)
+    {
+        stream._ogg->rewind();
+        bytes += stream._ogg->decode(block + bytes, size - bytes);
+    }
+
+    // The stream has ended
+    if (bytes == 0)
+    {
+        return false;
+    }
+
+    // Buffer data into buffer
+    alBufferData(buffer, stream._format, block, bytes, stream._ogg->get_sample_rate());
+
+    return true;
+}
 void min::sound_buffer::shutdown()
 {
+    // Stop the stream thread before deleting the sources it refills
+    {
+        std::lock_guard<std::mutex> lock(_stream_lock);
+        _stream_kill = true;
+    }
+    _stream_wake.notify_one();
+    if (_stream_thread.joinable())
+    {
+        _stream_thread.join();
+    }
+
     // Check for any errors
     throw_internal_error();
 
@@ -135,6 +188,12 @@ void min::sound_buffer::shutdown()
         alDeleteBuffers(1, &b);
     }
 
+    // Delete stream buffers
+    for (const auto &s : _streams)
+    {
+        alDeleteBuffers(s->_buffers.size(), s->_buffers.data());
+    }
+
     // Release the current context
     const ALCboolean current = alcMakeContextCurrent(nullptr);
     if (!current)
@@ -152,7 +211,70 @@ void min::sound_buffer::shutdown()
         throw std::runtime_error("openal: Could not close device");
     }
 }
-min::sound_buffer::sound_buffer()
+void min::sound_buffer::stream_loop()
+{
+    std::unique_lock<std::mutex> lock(_stream_lock);
+    while (!_stream_kill)
+    {
+        // Refill the played buffers of every playing stream
+        for (const auto &s : _streams)
+        {
+            if (s->_playing)
+            {
+                try
+                {
+                    update_stream(*s);
+                }
+                catch (const std::exception &ex)
+                {
+                    // Stop the broken stream and release its buffers, there is no caller to throw to
+                    std::cout << "sound_buffer: stream stopped: " << ex.what() << std::endl;
+                    alSourceStop(_sources[s->_source]);
+                    alSourcei(_sources[s->_source], AL_BUFFER, 0);
+                    s->_playing = false;
+                }
+            }
+        }
+
+        // Sleep until the next poll or shutdown
+        _stream_wake.wait_for(lock, std::chrono::milliseconds(STREAM_POLL_MS));
+    }
+}
+void min::sound_buffer::update_stream(sound_stream &stream)
+{
+    const ALuint source = _sources[stream._source];
+
+    // Refill and requeue buffers that finished playing
+    ALint processed = 0;
+    alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+    for (ALint i = 0; i < processed; i++)
+    {
+        ALuint buffer;
+        alSourceUnqueueBuffers(source, 1, &buffer);
+        if (fill_stream(stream, buffer))
+        {
+            alSourceQueueBuffers(source, 1, &buffer);
+        }
+    }
+
+    // If nothing is queued the stream has finished
+    ALint queued = 0;
+    alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+    if (queued == 0)
+    {
+        stream._playing = false;
+        return;
+    }
+
+    // If the source ran dry before we refilled it, restart it
+    ALint state;
+    alGetSourcei(source, AL_SOURCE_STATE, &state);
+    if (state == AL_STOPPED)
+    {
+        alSourcePlay(source);
+    }
+}
+min::sound_buffer::sound_buffer() : _device(nullptr), _context(nullptr), _stream_kill(false)
 {
     static_assert(std::is_same<float, ALfloat>::value,
                   "ALfloat must be implemented as float");
@@ -196,6 +318,9 @@ void min::sound_buffer::enumerate_devices() const
 }
 size_t min::sound_buffer::add_source()
 {
+    // The stream thread reads the source list
+    std::lock_guard<std::mutex> lock(_stream_lock);
+
     // Create a new source
     _sources.emplace_back();
 
@@ -236,6 +361,14 @@ size_t min::sound_buffer::add_ogg_pcm(const min::ogg &ogg)
     // Add audio data
     return add_pcm_data(data, format, size, freq);
 }
+size_t min::sound_buffer::add_ogg_stream(const std::string &file)
+{
+    return add_stream(std::make_unique<ogg_stream>(file));
+}
+size_t min::sound_buffer::add_ogg_stream(const min::mem_file &mem)
+{
+    return add_stream(std::make_unique<ogg_stream>(mem));
+}
 void min::sound_buffer::bind(const size_t buffer, const size_t source) const
 {
     // Bind source to buffer
@@ -269,18 +402,84 @@ bool min::sound_buffer::is_playing(const size_t source) const
 
     return state == AL_PLAYING;
 }
+bool min::sound_buffer::is_streaming(const size_t stream) const
+{
+    std::lock_guard<std::mutex> lock(_stream_lock);
+
+    return _streams[stream]->_playing;
+}
 void min::sound_buffer::play_async(const size_t source) const
 {
     // This call is asynch!!
     const ALuint &s = _sources[source];
     alSourcePlay(s);
 }
+void min::sound_buffer::play_stream(const size_t stream, const size_t source)
+{
+    std::lock_guard<std::mutex> lock(_stream_lock);
+    sound_stream &s = *_streams[stream];
+
+    // If the stream is already playing, release its source
+    if (s._playing)
+    {
+        alSourceStop(_sources[s._source]);
+        alSourcei(_sources[s._source], AL_BUFFER, 0);
+    }
+
+    // Stop any other stream playing on the new source
+    for (const auto &other : _streams)
+    {
+        if (other.get() != &s && other->_playing && other->_source == source)
+        {
+            other->_playing = false;
+        }
+    }
+
+    // Detach anything bound to the new source and restart the decoder
+    const ALuint src = _sources[source];
+    alSourceStop(src);
+    alSourcei(src, AL_BUFFER, 0);
+    s._ogg->rewind();
+    s._source = source;
+
+    // Prime the ring of buffers and queue them on the source
+    ALsizei count = 0;
+    const ALsizei size = s._buffers.size();
+    while (count < size && fill_stream(s, s._buffers[count]))
+    {
+        count++;
+    }
+    alSourceQueueBuffers(src, count, s._buffers.data());
+
+    // This call is asynch!!
+    alSourcePlay(src);
+    s._playing = count > 0;
+
+    // Start the refill thread on first use
+    if (!_stream_thread.joinable())
+    {
+        _stream_thread = std::thread(&sound_buffer::stream_loop, this);
+    }
+}
 void min::sound_buffer::stop_async(const size_t source) const
 {
     // This call is asynch!!
     const ALuint &s = _sources[source];
     alSourceStop(s);
 }
+void min::sound_buffer::stop_stream(const size_t stream)
+{
+    std::lock_guard<std::mutex> lock(_stream_lock);
+    sound_stream &s = *_streams[stream];
+
+    // Stop the source and release the queued buffers
+    if (s._playing)
+    {
+        alSourceStop(_sources[s._source]);
+        alSourcei(_sources[s._source], AL_BUFFER, 0);
+        s._playing = false;
+    }
+}
 void min::sound_buffer::play_sync(const size_t source) const
 {
     // This call is asynch so we need to poll
@@ -362,3 +561,8 @@ void min::sound_buffer::set_source_velocity(const size_t source, const min::vec3
     const ALfloat vel[3] = {-v.x, v.y, v.z};
     alSourcefv(_sources[source], AL_VELOCITY, vel);
 }
+void min::sound_buffer::set_stream_loop(const size_t stream, const bool flag)
+{
+    std::lock_guard<std::mutex> lock(_stream_lock);
+    _streams[stream]->_loop = flag;
+}
@@ -17,8 +17,13 @@ limitations under the License.
 
 #include <AL/al.h>
 #include <AL/alc.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -33,20 +38,50 @@ namespace min
 bool check_al_error();
 void throw_al_error();
 
+// A streamed ogg file plays through a small ring of buffers queued on a source
+// Played buffers are refilled with the next block of PCM by the stream thread
+struct sound_stream
+{
+  public:
+    std::unique_ptr<ogg_stream> _ogg;
+    std::array<ALuint, 4> _buffers;
+    std::vector<uint8_t> _block;
+    ALenum _format;
+    size_t _source;
+    bool _loop;
+    bool _playing;
+
+    sound_stream(std::unique_ptr<ogg_stream> ogg, const ALenum format, const size_t block)
+        : _ogg(std::move(ogg)), _buffers{}, _block(block), _format(format), _source(0), _loop(false), _playing(false) {}
+};
+
 class sound_buffer
 {
   private:
+    // Each stream buffer holds 100 ms of audio, the refill thread wakes every 20 ms
+    static constexpr unsigned STREAM_BLOCK_MS = 100;
+    static constexpr unsigned STREAM_POLL_MS = 20;
+
     ALCdevice *_device;
     ALCcontext *_context;
     std::vector<ALuint> _buffers;
     std::vector<ALuint> _sources;
     vec3<float> _listener;
+    std::vector<std::unique_ptr<sound_stream>> _streams;
+    mutable std::mutex _stream_lock;
+    std::condition_variable _stream_wake;
+    std::thread _stream_thread;
+    bool _stream_kill;
 
     static ALenum al_format(const bool, const unsigned);
     size_t add_pcm_data(const ALvoid *const, const ALenum, const ALsizei, const ALsizei);
+    size_t add_stream(std::unique_ptr<ogg_stream>);
     void clear_error() const;
     void create_openal_context();
+    bool fill_stream(sound_stream&, const ALuint);
     void shutdown();
+    void stream_loop();
+    void update_stream(sound_stream&);
 
   public:
     sound_buffer();
@@ -57,12 +92,17 @@ class sound_buffer
     size_t add_source();
     size_t add_wave_pcm(const wave&);
     size_t add_ogg_pcm(const ogg&);
+    size_t add_ogg_stream(const std::string&);
+    size_t add_ogg_stream(const mem_file&);
     void bind(const size_t, const size_t) const;
     bool check_error() const;
     void throw_internal_error() const;
     bool is_playing(const size_t) const;
+    bool is_streaming(const size_t) const;
     void play_async(const size_t) const;
+    void play_stream(const size_t, const size_t);
     void stop_async(const size_t) const;
+    void stop_stream(const size_t);
     void play_sync(const size_t) const;
     void set_distance_model(const ALenum model) const;
     void set_listener_position(const vec3<float>&);
@@ -78,6 +118,7 @@ class sound_buffer
     void set_source_ref_dist(const size_t, const float) const;
     void set_source_rolloff(const size_t, const float) const;
     void set_source_velocity(const size_t, const vec3<float>&) const;
+    void set_stream_loop(const size_t, const bool);
 
 };
 }
@@ -0,0 +1,132 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "tasset_loader.h"
+
+bool test_asset_loader()
+{
+    bool out = true;
+
+    // Test loading files and returning futures
+    {
+        min::asset_loader loader(4, 8);
+        out = out && compare(4, loader.get_size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed asset_loader size");
+        }
+
+        std::future<std::shared_ptr<min::bmp>> b = loader.load<min::bmp>("data/texture/art_cube.bmp");
+        std::future<std::shared_ptr<min::dds>> d = loader.load<min::dds>("data/texture/stone.dds");
+        std::future<std::shared_ptr<min::wavefront<double, uint16_t>>> w = loader.load<min::wavefront<double, uint16_t>>("data/models/cube.obj");
+
+        // Compare against loading on this thread
+        const min::bmp b1("data/texture/art_cube.bmp");
+        const min::dds d1("data/texture/stone.dds");
+        const std::shared_ptr<min::bmp> b2 = b.get();
+        const std::shared_ptr<min::dds> d2 = d.get();
+        out = out && compare(b1.get_size(), b2->get_size());
+        out = out && (b1.get_pixels() == b2->get_pixels());
+        out = out && compare(d1.get_size(), d2->get_size());
+        out = out && compare(2, w.get()->get_meshes().size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed asset_loader future load");
+        }
+
+        // Test errors are stored in the future
+        std::future<std::shared_ptr<min::bmp>> e = loader.load<min::bmp>("data/texture/missing.bmp");
+        bool thrown = false;
+        try
+        {
+            e.get();
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed asset_loader future error");
+        }
+    }
+
+    // Test loading many assets from a mem_chunk with callbacks
+    {
+        min::mem_chunk chunk;
+        chunk.add_file("data/texture/art_cube.bmp", true);
+        chunk.add_file("data/texture/stone.dds", true);
+        chunk.write_memory_file("bin/asset_loader_test");
+        min::mem_chunk packed("bin/asset_loader_test");
+
+        // Use a small upload queue so workers must wait for the render thread
+        min::asset_loader loader(4, 2);
+        std::vector<uint32_t> sizes;
+        const std::function<void(const std::shared_ptr<min::bmp>&)> on_bmp = [&sizes](const std::shared_ptr<min::bmp> &bmp) {
+            sizes.push_back(bmp->get_size());
+        };
+        const std::function<void(const std::shared_ptr<min::dds>&)> on_dds = [&sizes](const std::shared_ptr<min::dds> &dds) {
+            sizes.push_back(dds->get_size());
+        };
+        for (size_t i = 0; i < 8; i++)
+        {
+            loader.load<min::bmp>(packed, "data/texture/art_cube.bmp", on_bmp);
+            loader.load<min::dds>(packed, "data/texture/stone.dds", on_dds);
+        }
+
+        // Callbacks only run on this thread when asked
+        loader.finish();
+        out = out && compare(16, sizes.size());
+        out = out && compare(0, loader.get_pending());
+        if (!out)
+        {
+            throw std::runtime_error("Failed asset_loader callback load");
+        }
+
+        // Compare decoded sizes
+        const min::bmp b("data/texture/art_cube.bmp");
+        const min::dds d("data/texture/stone.dds");
+        size_t bmps = 0;
+        for (const uint32_t size : sizes)
+        {
+            bmps += (size == b.get_size());
+            out = out && (size == b.get_size() || size == d.get_size());
+        }
+        out = out && compare(8, bmps);
+        if (!out)
+        {
+            throw std::runtime_error("Failed asset_loader callback data");
+        }
+
+        // Test errors are rethrown on the render thread
+        loader.load<min::bmp>(packed, "data/texture/missing.bmp", on_bmp);
+        bool thrown = false;
+        try
+        {
+            loader.finish();
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed asset_loader callback error");
+        }
+    }
+
+    return out;
+}
@@ -42,5 +42,91 @@ bool test_dds()
         throw std::runtime_error("Failed dds image size");
     }
 
+    // Stream the same image one mip level at a time
+    {
+        min::dds_stream stream("data/texture/stone.dds");
+        out = out && compare(256, stream.get_width());
+        out = out && compare(256, stream.get_height());
+        out = out && compare(9, stream.get_mips());
+        out = out && compare(43704, stream.get_size());
+        out = out && (image.get_format() == stream.get_format());
+        if (!out)
+        {
+            throw std::runtime_error("Failed dds_stream properties");
+        }
+
+        // Read the smallest level first, then each larger level
+        size_t offset = 43704;
+        std::vector<uint8_t> level;
+        for (uint32_t i = 9; i-- > 0;)
+        {
+            const size_t size = stream.get_level_size(i);
+            offset -= size;
+            stream.read_level(i, level);
+            out = out && compare(std::max(1, 256 >> i), stream.get_level_width(i));
+            out = out && compare(std::max(1, 256 >> i), stream.get_level_height(i));
+            out = out && std::equal(level.begin(), level.end(), data.begin() + offset);
+        }
+        out = out && compare(0, offset);
+        out = out && compare(32768, stream.get_level_size(0));
+        out = out && compare(8, stream.get_level_size(8));
+        if (!out)
+        {
+            throw std::runtime_error("Failed dds_stream read levels");
+        }
+
+        // Stream from memory
+        std::vector<uint8_t> file = image.to_file();
+        const min::mem_file mem(&file, 0, file.size());
+        min::dds_stream mem_stream(mem);
+        mem_stream.read_level(2, level);
+        out = out && compare(2048, level.size());
+        out = out && std::equal(level.begin(), level.end(), data.begin() + 32768 + 8192);
+        if (!out)
+        {
+            throw std::runtime_error("Failed dds_stream mem_file");
+        }
+
+        // A truncated file is rejected from the header alone
+        file.resize(file.size() - 1);
+        const min::mem_file short_mem(&file, 0, file.size());
+        bool thrown = false;
+        try
+        {
+            min::dds_stream bad(short_mem);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed dds_stream truncated file");
+        }
+
+        // A mip count longer than the chain down to 1x1 is rejected before allocating
+        for (const uint32_t mips : {10u, 64u, 0xFFFFFFFFu})
+        {
+            std::vector<uint8_t> header(file.begin(), file.begin() + 136);
+            min::write_le<uint32_t>(header, mips, 28);
+            const min::mem_file bad_mem(&header, 0, header.size());
+            thrown = false;
+            try
+            {
+                min::dds_stream bad(bad_mem);
+            }
+            catch (const std::runtime_error &)
+            {
+                thrown = true;
+            }
+            out = out && thrown;
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed dds_stream bad mip count");
+        }
+    }
+
     return out;
 }
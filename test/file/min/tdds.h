@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TESTDDS
 #define TESTDDS
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "file/min/dds.h"
@@ -0,0 +1,137 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "tdxt_encoder.h"
+
+double dxt_psnr(const std::vector<uint8_t> &one, const std::vector<uint8_t> &two, const unsigned first, const unsigned last)
+{
+    // Peak signal to noise ratio over the channels [first, last]
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < one.size(); i += 4)
+    {
+        for (unsigned c = first; c <= last; c++)
+        {
+            const double d = static_cast<double>(one[i + c]) - static_cast<double>(two[i + c]);
+            sum += d * d;
+            count++;
+        }
+    }
+
+    const double mse = sum / count;
+    return (mse > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / mse) : 100.0;
+}
+
+bool test_dxt_encoder()
+{
+    bool out = true;
+
+    // Compress a 24 bit bmp to DXT1 with a full mip chain
+    {
+        const min::bmp image("data/texture/art_cube.bmp");
+        const std::vector<uint8_t> rgba = min::dxt_encoder::to_rgba(image);
+        const min::dxt_encoder encoder;
+        const min::dds d = encoder.compress_bmp_dds_dxt1(image);
+        out = out && compare(256, d.get_width());
+        out = out && compare(256, d.get_height());
+        out = out && compare(9, d.get_mips());
+        out = out && compare(43704, d.get_size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder dxt1 properties");
+        }
+
+        // Check the compression quality of the top level
+        const std::vector<uint8_t> decoded = min::dxt_encoder::decompress(d, 0);
+        out = out && compare(rgba.size(), decoded.size());
+        out = out && (dxt_psnr(rgba, decoded, 0, 2) > 32.0);
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder dxt1 psnr");
+        }
+
+        // The smallest mip level is a single pixel
+        out = out && compare(4, min::dxt_encoder::decompress(d, 8).size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder dxt1 mip levels");
+        }
+
+        // Higher quality should never be worse than the fast path
+        min::dxt_encoder fast(min::dxt_encoder::FAST);
+        min::dxt_encoder high(min::dxt_encoder::HIGH);
+        fast.disable_mip_maps();
+        high.disable_mip_maps();
+        const double fast_psnr = dxt_psnr(rgba, min::dxt_encoder::decompress(fast.compress_bmp_dds_dxt1(image), 0), 0, 2);
+        const double high_psnr = dxt_psnr(rgba, min::dxt_encoder::decompress(high.compress_bmp_dds_dxt1(image), 0), 0, 2);
+        out = out && (fast_psnr > 30.0);
+        out = out && (high_psnr >= fast_psnr);
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder quality levels");
+        }
+    }
+
+    // Compress a 32 bit bmp to DXT3 and DXT5 and check the alpha channel
+    {
+        const min::bmp image("data/texture/stone.bmp");
+        const std::vector<uint8_t> rgba = min::dxt_encoder::to_rgba(image);
+        const min::dxt_encoder encoder;
+        const min::dds dxt3 = encoder.compress_bmp_dds_dxt3(image);
+        const min::dds dxt5 = encoder.compress_bmp_dds_dxt5(image);
+        out = out && compare(87408, dxt3.get_size());
+        out = out && compare(87408, dxt5.get_size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder dxt3/dxt5 properties");
+        }
+
+        const std::vector<uint8_t> decoded3 = min::dxt_encoder::decompress(dxt3, 0);
+        const std::vector<uint8_t> decoded5 = min::dxt_encoder::decompress(dxt5, 0);
+        out = out && (dxt_psnr(rgba, decoded3, 0, 2) > 32.0);
+        out = out && (dxt_psnr(rgba, decoded3, 3, 3) > 30.0);
+        out = out && (dxt_psnr(rgba, decoded5, 0, 2) > 32.0);
+        out = out && (dxt_psnr(rgba, decoded5, 3, 3) > 40.0);
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder dxt3/dxt5 psnr");
+        }
+
+        // The encoded texture survives a round trip through the dds file format
+        std::vector<uint8_t> file = dxt5.to_file();
+        const min::mem_file mem(&file, 0, file.size());
+        const min::dds loaded(mem);
+        out = out && compare(dxt5.get_mips(), loaded.get_mips());
+        out = out && (dxt5.get_pixels() == loaded.get_pixels());
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder dds round trip");
+        }
+    }
+
+    // Compressing on a thread pool gives the same result as a single thread
+    {
+        const min::bmp image("data/texture/stone.bmp");
+        min::thread_pool pool(4);
+        const min::dxt_encoder serial(min::dxt_encoder::HIGH);
+        const min::dxt_encoder parallel(pool, min::dxt_encoder::HIGH);
+        out = out && (serial.compress_bmp_dds_dxt5(image).get_pixels() == parallel.compress_bmp_dds_dxt5(image).get_pixels());
+        if (!out)
+        {
+            throw std::runtime_error("Failed dxt_encoder thread pool");
+        }
+    }
+
+    return out;
+}
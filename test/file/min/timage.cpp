@@ -0,0 +1,150 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "timage.h"
+
+bool test_image()
+{
+    bool out = true;
+
+    // Build a full mip chain from a bmp
+    {
+        const min::image image(min::bmp("data/texture/art_cube.bmp"));
+        out = out && compare(256, image.get_width());
+        out = out && compare(256, image.get_height());
+        out = out && compare(3, image.get_pixel_size());
+        out = out && compare(196608, image.get_pixels().size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed image bmp properties");
+        }
+
+        const std::vector<min::image> mips = image.mip_chain();
+        out = out && compare(9, mips.size());
+        out = out && compare(128, mips[1].get_width());
+        out = out && compare(128, mips[1].get_height());
+        out = out && compare(1, mips[8].get_width());
+        out = out && compare(1, mips[8].get_height());
+        out = out && compare(3, mips[8].get_pixels().size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed image mip chain");
+        }
+
+        // The first box filtered level is the average of each 2x2 quad
+        const std::vector<uint8_t> &p0 = image.get_pixels();
+        const std::vector<uint8_t> &p1 = mips[1].get_pixels();
+        bool average = true;
+        for (size_t y = 0; y < 128; y++)
+        {
+            for (size_t x = 0; x < 128; x++)
+            {
+                for (size_t c = 0; c < 3; c++)
+                {
+                    const size_t i = ((2 * y) * 256 + 2 * x) * 3 + c;
+                    const int sum = p0[i] + p0[i + 3] + p0[i + 768] + p0[i + 771];
+                    average = average && std::abs(sum - 4 * p1[(y * 128 + x) * 3 + c]) <= 2;
+                }
+            }
+        }
+        out = out && average;
+        if (!out)
+        {
+            throw std::runtime_error("Failed image box filter");
+        }
+
+        // Filtering on a thread pool gives the same result as a single thread
+        min::thread_pool pool(4);
+        const std::vector<min::image> kaiser = image.mip_chain(min::image::KAISER, true);
+        const std::vector<min::image> parallel = image.mip_chain(min::image::KAISER, true, &pool);
+        for (size_t i = 0; i < kaiser.size(); i++)
+        {
+            out = out && (kaiser[i].get_pixels() == parallel[i].get_pixels());
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed image thread pool");
+        }
+    }
+
+    // Gamma correct filtering of a black and white checkerboard
+    {
+        std::vector<uint8_t> pixels(4 * 4 * 4, 0);
+        for (size_t i = 0; i < 16; i++)
+        {
+            const uint8_t v = ((i % 4 + i / 4) % 2) ? 255 : 0;
+            pixels[i * 4] = 255;
+            pixels[i * 4 + 1] = v;
+            pixels[i * 4 + 2] = v;
+            pixels[i * 4 + 3] = v;
+        }
+        const min::image checker(4, 4, 4, pixels);
+
+        // Linear filtering gives mid gray in sRGB space and keeps alpha
+        const min::image srgb = checker.resize(2, 2, min::image::BOX, true);
+        out = out && compare(255, srgb.get_pixels()[0]);
+        out = out && compare(188, srgb.get_pixels()[1]);
+        if (!out)
+        {
+            throw std::runtime_error("Failed image srgb filter");
+        }
+
+        // Without gamma correction the average is taken on the encoded values
+        const min::image plain = checker.resize(2, 2, min::image::BOX, false);
+        out = out && compare(128, plain.get_pixels()[1]);
+        if (!out)
+        {
+            throw std::runtime_error("Failed image linear filter");
+        }
+    }
+
+    // Arbitrary resampling preserves a solid color
+    {
+        const min::image solid(8, 8, 3, std::vector<uint8_t>(8 * 8 * 3, 100));
+        for (const unsigned filter : {min::image::BOX, min::image::KAISER})
+        {
+            const min::image down = solid.resize(3, 5, filter);
+            const min::image up = solid.resize(13, 21, filter);
+            out = out && compare(3, down.get_width());
+            out = out && compare(5, down.get_height());
+            out = out && compare(13 * 21 * 3, up.get_pixels().size());
+            out = out && (down.get_pixels() == std::vector<uint8_t>(3 * 5 * 3, 100));
+            out = out && (up.get_pixels() == std::vector<uint8_t>(13 * 21 * 3, 100));
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed image resize");
+        }
+    }
+
+    // Invalid pixel data throws
+    {
+        bool thrown = false;
+        try
+        {
+            const min::image bad(4, 4, 3, std::vector<uint8_t>(10, 0));
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed image invalid pixel data");
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,139 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "tlz.h"
+
+bool lz_round_trip(const std::vector<uint8_t> &in)
+{
+    // Compress and decompress the data
+    std::vector<uint8_t> compressed;
+    min::lz::compress(in.data(), in.size(), compressed);
+    std::vector<uint8_t> out(in.size());
+    min::lz::decompress(compressed.data(), compressed.size(), out.data(), out.size());
+
+    return in == out;
+}
+
+bool test_lz()
+{
+    bool out = true;
+
+    // Test an empty buffer
+    {
+        out = out && lz_round_trip(std::vector<uint8_t>());
+        if (!out)
+        {
+            throw std::runtime_error("Failed lz empty round trip");
+        }
+    }
+
+    // Test small blocks that are all literals
+    {
+        for (size_t i = 0; i < 20; i++)
+        {
+            std::vector<uint8_t> data(i);
+            for (size_t j = 0; j < i; j++)
+            {
+                data[j] = j * 37;
+            }
+            out = out && lz_round_trip(data);
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed lz literal round trip");
+        }
+    }
+
+    // Test long runs and overlapping matches
+    {
+        std::vector<uint8_t> run(70000, 'a');
+        out = out && lz_round_trip(run);
+
+        // Repeating pattern shorter than eight bytes, with some noise
+        std::vector<uint8_t> pattern(70000);
+        uint32_t seed = 1;
+        for (size_t i = 0; i < pattern.size(); i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            pattern[i] = "abcabd"[i % 6] ^ ((seed >> 16) % 64 == 0);
+        }
+        out = out && lz_round_trip(pattern);
+        if (!out)
+        {
+            throw std::runtime_error("Failed lz match round trip");
+        }
+
+        // Test the run compresses
+        std::vector<uint8_t> compressed;
+        min::lz::compress(run.data(), run.size(), compressed);
+        out = out && compressed.size() < 512;
+        if (!out)
+        {
+            throw std::runtime_error("Failed lz compression ratio");
+        }
+    }
+
+    // Test random data that does not compress
+    {
+        std::vector<uint8_t> data(65536);
+        uint32_t seed = 7;
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            data[i] = seed >> 16;
+        }
+        out = out && lz_round_trip(data);
+        if (!out)
+        {
+            throw std::runtime_error("Failed lz random round trip");
+        }
+    }
+
+    // Test corrupt data is detected
+    {
+        std::vector<uint8_t> run(1000, 'b');
+        std::vector<uint8_t> compressed;
+        min::lz::compress(run.data(), run.size(), compressed);
+
+        // Decompressing to the wrong size must fail
+        bool thrown = false;
+        try
+        {
+            min::lz::decompress(compressed.data(), compressed.size(), run.data(), run.size() - 1);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+
+        // Truncated data must fail
+        thrown = false;
+        try
+        {
+            min::lz::decompress(compressed.data(), compressed.size() - 1, run.data(), run.size());
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed lz corrupt data");
+        }
+    }
+
+    return out;
+}
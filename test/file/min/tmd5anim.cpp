@@ -150,5 +150,105 @@ bool test_md5_anim()
     // Test interpolate for 0.5 seconds
     mech_anim.step(0.5);
 
+    // Test nlerp interpolation matches slerp
+    const min::md5_anim<float> fast_anim = min::md5_anim<float>("data/models/mech_warrior_stand.md5anim");
+    fast_anim.set_nlerp(true);
+    out = out && fast_anim.get_nlerp();
+    mech_anim.set_loop_count(1);
+    mech_anim.set_time(0.0);
+    fast_anim.set_loop_count(1);
+    for (size_t i = 0; i < 60; i++)
+    {
+        mech_anim.step(0.0137);
+        fast_anim.step(0.0137);
+        const std::vector<min::mat3x4<float>> &slow = mech_anim.get_current_frame();
+        const std::vector<min::mat3x4<float>> &fast = fast_anim.get_current_frame();
+        for (size_t j = 0; j < slow.size(); j++)
+        {
+            const min::vec4<float> rows[6] = {slow[j].one(), slow[j].two(), slow[j].three(), fast[j].one(), fast[j].two(), fast[j].three()};
+            for (size_t k = 0; k < 3; k++)
+            {
+                out = out && compare(rows[k].x(), rows[k + 3].x(), 1E-3);
+                out = out && compare(rows[k].y(), rows[k + 3].y(), 1E-3);
+                out = out && compare(rows[k].z(), rows[k + 3].z(), 1E-3);
+                out = out && compare(rows[k].w(), rows[k + 3].w(), 1E-3);
+            }
+        }
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 mech anim nlerp");
+    }
+
+    // Bake the animation and reload it from the binary file
+    mech_anim.to_file("data/models/mech_warrior_stand.banim");
+    const min::md5_anim<float> baked_anim = min::md5_anim<float>("data/models/mech_warrior_stand.banim");
+
+    // Test the baked hierarchy, bounds and frame data
+    out = out && compare(15, baked_anim.get_nodes().size());
+    out = out && compare("right_foot", baked_anim.get_nodes()[14].get_name());
+    out = out && compare(mech_anim.get_nodes()[14].get_parent(), baked_anim.get_nodes()[14].get_parent());
+    out = out && compare(mech_anim.get_nodes()[14].get_flag(), baked_anim.get_nodes()[14].get_flag());
+    out = out && compare(15, baked_anim.get_transforms().size());
+    out = out && compare(0.0014, baked_anim.get_transforms()[0].get_position().y, 1E-4);
+    out = out && compare(60, baked_anim.get_frame_rate());
+    out = out && compare(60, baked_anim.get_bounds().size());
+    out = out && compare(-3.6695, baked_anim.get_bounds()[0].get_min().y, 1E-4);
+    out = out && compare(60, baked_anim.get_frame_data().size());
+    out = out && compare(0.5282, baked_anim.get_frame_data()[0].get_data()[4], 1E-4);
+    out = out && compare(60, baked_anim.get_frames().size());
+    out = out && compare(mech_anim.get_length(), baked_anim.get_length(), 1E-6);
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 mech anim bake");
+    }
+
+    // Test the baked frames are identical to the parsed frames
+    for (size_t i = 0; i < 60; i++)
+    {
+        const std::vector<min::mat3x4<float>> &parsed = mech_anim.get_frames()[i].get_bones();
+        const std::vector<min::mat3x4<float>> &baked = baked_anim.get_frames()[i].get_bones();
+        out = out && compare(parsed.size(), baked.size());
+        for (size_t j = 0; j < parsed.size(); j++)
+        {
+            const min::vec4<float> rows[6] = {parsed[j].one(), parsed[j].two(), parsed[j].three(), baked[j].one(), baked[j].two(), baked[j].three()};
+            for (size_t k = 0; k < 3; k++)
+            {
+                out = out && compare(rows[k].x(), rows[k + 3].x(), 1E-6);
+                out = out && compare(rows[k].y(), rows[k + 3].y(), 1E-6);
+                out = out && compare(rows[k].z(), rows[k + 3].z(), 1E-6);
+                out = out && compare(rows[k].w(), rows[k + 3].w(), 1E-6);
+            }
+        }
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 mech anim baked frames");
+    }
+
+    // Test truncated baked files throw instead of reading past the end
+    std::vector<uint8_t> baked_data;
+    mech_anim.serialize(baked_data);
+    const size_t cuts[4] = {6, 20, baked_data.size() / 2, baked_data.size() - 1};
+    for (size_t i = 0; i < 4; i++)
+    {
+        std::vector<uint8_t> cut(baked_data.begin(), baked_data.begin() + cuts[i]);
+        const min::mem_file mem(&cut, 0, cut.size());
+        bool thrown = false;
+        try
+        {
+            const min::md5_anim<float> bad_anim(mem);
+        }
+        catch (const std::runtime_error &ex)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 mech anim truncated bake");
+    }
+
     return out;
 }
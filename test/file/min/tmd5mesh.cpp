@@ -62,5 +62,46 @@ bool test_md5_mesh()
         throw std::runtime_error("Failed mech_md5 joint/bone sizes");
     }
 
+    // Bake the mesh and reload it from memory
+    std::vector<uint8_t> stream;
+    mech_md5.serialize(stream);
+    const min::mem_file mem(&stream, 0, stream.size());
+    const min::md5_mesh<float, uint16_t> baked_md5 = min::md5_mesh<float, uint16_t>(mem);
+
+    // Test the baked joints
+    out = out && compare(15, baked_md5.get_joints().size());
+    for (size_t i = 0; i < 15; i++)
+    {
+        const min::md5_joint<float> &parsed = mech_md5.get_joints()[i];
+        const min::md5_joint<float> &baked = baked_md5.get_joints()[i];
+        out = out && compare(parsed.get_name(), baked.get_name());
+        out = out && compare(parsed.get_id(), baked.get_id());
+        out = out && compare(parsed.get_position().y, baked.get_position().y, 1E-6);
+        out = out && compare(parsed.get_rotation().w(), baked.get_rotation().w(), 1E-6);
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Failed mech_md5 baked joints");
+    }
+
+    // Test the baked mesh
+    const min::mesh<float, uint16_t> &parsed = mech_md5.get_meshes()[0];
+    const min::mesh<float, uint16_t> &baked = baked_md5.get_meshes()[0];
+    out = out && compare(1, baked_md5.get_meshes().size());
+    out = out && compare(parsed.get_name(), baked.get_name());
+    out = out && compare(1516, baked.vertex.size());
+    out = out && compare(1516, baked.uv.size());
+    out = out && compare(5856, baked.index.size());
+    out = out && compare(1516, baked.bone_index.size());
+    out = out && compare(1516, baked.bone_weight.size());
+    out = out && compare(parsed.vertex[1000].y(), baked.vertex[1000].y(), 1E-6);
+    out = out && compare(parsed.uv[1000].x, baked.uv[1000].x, 1E-6);
+    out = out && compare(parsed.index[5000], baked.index[5000]);
+    out = out && compare(parsed.bone_weight[1000].x(), baked.bone_weight[1000].x(), 1E-6);
+    if (!out)
+    {
+        throw std::runtime_error("Failed mech_md5 baked mesh");
+    }
+
     return out;
 }
@@ -100,5 +100,160 @@ bool test_mem_chunk()
         }
     }
 
+    // Map that mem_chunk file into new set
+    {
+        min::mem_chunk chunk3("bin/mem_chunk_test", true);
+        out = out && chunk3.is_mapped();
+        out = out && compare(2, chunk3.size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk3 map test");
+        }
+
+        // Compare mapped data against the loaded data
+        const min::mem_file &dds2 = chunk2.get_file("data/texture/stone.dds");
+        const min::mem_file &dds3 = chunk3.get_file("data/texture/stone.dds");
+        out = out && dds3.is_view();
+        out = out && compare(dds2.offset(), dds3.offset());
+        out = out && compare(dds2.size(), dds3.size());
+        out = out && (dds2.to_string() == dds3.to_string());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk3 dds compare");
+        }
+
+        // Test loading an image from a mapped file
+        const min::bmp b2(chunk2.get_file("data/texture/art_cube.bmp"));
+        const min::bmp b3(chunk3.get_file("data/texture/art_cube.bmp"));
+        out = out && compare(b2.get_size(), b3.get_size());
+        out = out && (b2.get_pixels() == b3.get_pixels());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk3 bmp load");
+        }
+
+        // Add a file to the mapped set and write it out
+        chunk3.add_file("data/models/cube.obj");
+        chunk3.write_memory_file("bin/mem_chunk_test_map");
+    }
+
+    // Load the mapped set that was written out
+    {
+        min::mem_chunk chunk4("bin/mem_chunk_test_map");
+        out = out && compare(3, chunk4.size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk4 load test");
+        }
+
+        // Compare old and appended files
+        min::mem_chunk cube;
+        cube.add_file("data/models/cube.obj");
+        const std::string a = chunk4.get_file("data/models/cube.obj").to_string();
+        const std::string b = cube.get_file("data/models/cube.obj").to_string();
+        const std::string c = chunk4.get_file("data/texture/stone.dds").to_string();
+        const std::string d = chunk1.get_file("data/texture/stone.dds").to_string();
+        out = out && (a == b);
+        out = out && (c == d);
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk4 data compare");
+        }
+    }
+
+    // Test writing a mapped set over its own file keeps the mapped views valid
+    {
+        min::mem_chunk chunk5("bin/mem_chunk_test_map", true);
+        chunk5.write_memory_file("bin/mem_chunk_test_map");
+        const std::string a = chunk5.get_file("data/texture/stone.dds").to_string();
+        const std::string b = chunk1.get_file("data/texture/stone.dds").to_string();
+        out = out && (a == b);
+
+        // Test the replaced file loads
+        const min::mem_chunk chunk6("bin/mem_chunk_test_map");
+        out = out && compare(3, chunk6.size());
+        out = out && (chunk6.get_file("data/texture/stone.dds").to_string() == b);
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk5 overwrite mapped file");
+        }
+    }
+
+    // Compress files in the set
+    {
+        min::mem_chunk chunk5;
+        chunk5.add_file("data/texture/art_cube.bmp", true);
+        chunk5.add_file("data/texture/stone.dds", true);
+        chunk5.add_file("data/models/cube.obj");
+        chunk5.write_memory_file("bin/mem_chunk_test_lz");
+
+        // Test the archive is smaller
+        std::ifstream raw("bin/mem_chunk_test_map", std::ios::binary | std::ios::ate);
+        std::ifstream packed("bin/mem_chunk_test_lz", std::ios::binary | std::ios::ate);
+        out = out && (packed.tellg() < raw.tellg());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk compression size");
+        }
+    }
+
+    // Load and map the compressed set
+    for (size_t i = 0; i < 2; i++)
+    {
+        const bool map = (i == 1);
+        min::mem_chunk chunk6("bin/mem_chunk_test_lz", map);
+        out = out && compare(3, chunk6.size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk6 compressed load");
+        }
+
+        // Compare compressed and raw files
+        const std::string a = chunk6.get_file("data/texture/art_cube.bmp").to_string();
+        const std::string b = chunk1.get_file("data/texture/art_cube.bmp").to_string();
+        const std::string c = chunk6.get_file("data/texture/stone.dds").to_string();
+        const std::string d = chunk1.get_file("data/texture/stone.dds").to_string();
+        out = out && (a == b);
+        out = out && (c == d);
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk6 decompress compare");
+        }
+
+        // Test writing a partially decompressed set keeps the files compressed
+        chunk6.write_memory_file("bin/mem_chunk_test_lz2");
+        min::mem_chunk chunk7("bin/mem_chunk_test_lz2");
+        const std::string e = chunk7.get_file("data/texture/art_cube.bmp").to_string();
+        const std::string f = chunk7.get_file("data/models/cube.obj").to_string();
+        const std::string g = chunk1.get_file("data/texture/art_cube.bmp").to_string();
+        out = out && (e == g);
+        out = out && compare(f.size(), chunk6.get_file("data/models/cube.obj").size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk7 compressed write");
+        }
+    }
+
+    // Load a version 1 archive, which has no magic number and no compression
+    {
+        std::vector<uint8_t> stream;
+        min::write_le<uint32_t>(stream, 5);
+        min::write_le<uint32_t>(stream, 1);
+        min::write_le<uint32_t>(stream, 0);
+        min::write_le<uint32_t>(stream, 5);
+        min::write_le<uint32_t>(stream, 3);
+        stream.insert(stream.end(), {'o', 'l', 'd', 'h', 'e', 'l', 'l', 'o'});
+        std::ofstream file("bin/mem_chunk_test_v1", std::ios::binary);
+        file.write(reinterpret_cast<const char *>(stream.data()), stream.size());
+        file.close();
+
+        min::mem_chunk chunk8("bin/mem_chunk_test_v1");
+        out = out && compare("hello", chunk8.get_file("old").to_string());
+        if (!out)
+        {
+            throw std::runtime_error("Failed mem_chunk version 1 load");
+        }
+    }
+
     return out;
 }
@@ -15,8 +15,12 @@ limitations under the License.
 #ifndef __TEST_MEM_CHUNK__
 #define __TEST_MEM_CHUNK__
 
+#include <fstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "file/min/bmp.h"
 #include "file/min/mem_chunk.h"
 #include "platform/min/test.h"
 
@@ -66,5 +66,59 @@ bool test_ogg()
         }
     }
 
+    // Stream the invention ogg file in blocks
+    {
+        const min::ogg sound = min::ogg("data/sound/invention_no_1.ogg");
+        min::ogg_stream stream("data/sound/invention_no_1.ogg");
+
+        // Test the stream format
+        out = out && stream.is_stereo();
+        out = out && compare(16, stream.get_bits_per_sample());
+        out = out && compare(44100, stream.get_sample_rate());
+        if (!out)
+        {
+            throw std::runtime_error("Failed ogg stream format");
+        }
+
+        // Test size of 100 ms of 16 bit stereo PCM
+        std::vector<uint8_t> block(stream.get_block_size(100));
+        out = out && compare(17640, block.size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed ogg stream block size");
+        }
+
+        // Decode the whole file in blocks, it must match the full decode
+        const std::vector<uint8_t> &data = sound.data();
+        size_t offset = 0;
+        while (!stream.is_eof())
+        {
+            const size_t bytes = stream.decode(block.data(), block.size());
+            out = out && (offset + bytes <= data.size());
+            out = out && std::memcmp(block.data(), &data[offset], bytes) == 0;
+            offset += bytes;
+            if (!out)
+            {
+                throw std::runtime_error("Failed ogg stream decode");
+            }
+        }
+        out = out && compare(1360896, offset);
+        if (!out)
+        {
+            throw std::runtime_error("Failed ogg stream data size");
+        }
+
+        // Rewind and decode the first block again
+        stream.rewind();
+        const size_t bytes = stream.decode(block.data(), block.size());
+        out = out && compare(block.size(), bytes);
+        out = out && std::memcmp(block.data(), data.data(), bytes) == 0;
+        out = out && !stream.is_eof();
+        if (!out)
+        {
+            throw std::runtime_error("Failed ogg stream rewind");
+        }
+    }
+
     return out;
 }
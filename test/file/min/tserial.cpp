@@ -328,5 +328,64 @@ bool test_serial()
         }
     }
 
+    // Read with a stream cursor
+    {
+        // Write little endian data to stream
+        std::vector<uint8_t> stream;
+        const std::vector<unsigned> a = {7, 19567, 2105678};
+        const std::vector<min::vec3<float>> b = {min::vec3<float>(1.0, 0.1, 3.2), min::vec3<float>(-3.0, -4.1, 7.2)};
+        const std::vector<double> c = {19567.545, -2105678.351};
+        min::write_le_vector<unsigned>(stream, a);
+        min::write_le_vector_vec3<float>(stream, b);
+        min::write_le<float>(stream, 0.5);
+        min::write_le<double>(stream, c[0]);
+        min::write_le<double>(stream, c[1]);
+
+        // Read the data back from the stream and from a mem_file
+        const min::mem_file mem(&stream, 0, stream.size());
+        min::stream_cursor cursors[2] = {min::stream_cursor(stream), min::stream_cursor(mem)};
+        for (auto &cursor : cursors)
+        {
+            std::vector<unsigned> ra;
+            std::vector<min::vec3<float>> rb;
+            double rc[2];
+            cursor.read_le_vector<unsigned>(ra);
+            cursor.read_le_vector_vec3<float>(rb);
+            const float f = cursor.read_le<float>();
+            cursor.read_le<double>(rc, 2);
+            out = out && compare(3, ra.size());
+            out = out && compare(19567, ra[1]);
+            out = out && compare(2105678, ra[2]);
+            out = out && compare(2, rb.size());
+            out = out && compare(0.1, rb[0].y, 1E-4);
+            out = out && compare(7.2, rb[1].z, 1E-4);
+            out = out && compare(0.5, f, 1E-4);
+            out = out && compare(19567.545, rc[0], 1E-4);
+            out = out && compare(-2105678.351, rc[1], 1E-4);
+            out = out && compare(stream.size(), cursor.next());
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed stream cursor read");
+        }
+
+        // Reading past the end of the stream must throw
+        bool thrown = false;
+        try
+        {
+            min::stream_cursor cursor(stream, stream.size() - 2);
+            cursor.read_le<float>();
+        }
+        catch (const std::exception&)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed stream cursor bounds check");
+        }
+    }
+
     return out;
 }
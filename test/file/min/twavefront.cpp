@@ -192,6 +192,113 @@ bool test_wavefront()
         }
     }
 
+    // Test chunked parsing on a thread pool
+    {
+        // Generate two objects large enough to be split into several chunks
+        std::string obj;
+        for (size_t k = 0; k < 2; k++)
+        {
+            obj += "o grid" + std::to_string(k) + "\n";
+            for (size_t i = 0; i < 40000; i++)
+            {
+                obj += "v " + std::to_string(i * 0.5) + " -" + std::to_string(k) + ".25 1e-2\n";
+                obj += "vt 0.5 " + std::to_string(i % 2) + "\n";
+            }
+            obj += "vn 0.0 0.0 1.0\r\n";
+            for (size_t i = 1; i < 40000; i += 2)
+            {
+                const std::string a = std::to_string(i);
+                const std::string b = std::to_string(i + 1);
+                obj += "f " + a + "/" + a + "/1 " + b + "/" + b + "/1\t" + a + "/" + a + "/1\n";
+            }
+        }
+
+        // Parse serially and on a thread pool
+        std::vector<uint8_t> data(obj.begin(), obj.end());
+        const min::mem_file mem(&data, 0, data.size());
+        min::thread_pool pool(4);
+        min::wavefront<float, uint32_t> serial(mem);
+        min::wavefront<float, uint32_t> parallel(mem, pool);
+        const std::vector<min::mesh<float, uint32_t>> &sm = serial.get_meshes();
+        const std::vector<min::mesh<float, uint32_t>> &pm = parallel.get_meshes();
+
+        // Test mesh counts and names
+        out = out && compare(2, sm.size());
+        out = out && compare(2, pm.size());
+        out = out && compare("grid1", pm[1].get_name());
+        if (!out)
+        {
+            throw std::runtime_error("Failed wavefront thread pool mesh count");
+        }
+
+        // Test attributes are deduplicated, each vertex shares a uv and normal
+        out = out && compare(40000, pm[1].vertex.size());
+        out = out && compare(60000, pm[1].index.size());
+        out = out && compare(10.5, pm[1].vertex[21].x(), 1E-6);
+        out = out && compare(-1.25, pm[1].vertex[21].y(), 1E-6);
+        out = out && compare(0.01, pm[1].vertex[21].z(), 1E-6);
+        out = out && compare(1.0, pm[1].uv[21].y, 1E-6);
+        if (!out)
+        {
+            throw std::runtime_error("Failed wavefront thread pool data parse");
+        }
+
+        // Test serial and thread pool results are identical
+        for (size_t k = 0; k < 2; k++)
+        {
+            out = out && compare(sm[k].vertex.size(), pm[k].vertex.size());
+            out = out && std::equal(sm[k].index.begin(), sm[k].index.end(), pm[k].index.begin());
+            for (size_t i = 0; i < sm[k].vertex.size(); i++)
+            {
+                out = out && compare(sm[k].vertex[i].x(), pm[k].vertex[i].x(), 1E-6);
+                out = out && compare(sm[k].uv[i].y, pm[k].uv[i].y, 1E-6);
+            }
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed wavefront thread pool serial comparison");
+        }
+
+        // Test errors in a later chunk are still reported
+        data.insert(data.end() - 2, '/');
+        const min::mem_file bad(&data, 0, data.size());
+        bool thrown = false;
+        try
+        {
+            min::wavefront<float, uint32_t> w(bad, pool);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed wavefront thread pool error");
+        }
+    }
+
+    // Test face indices that do not fit in the index type
+    {
+        const std::string obj = "v 0.0 0.0 0.0\nvt 0.0 0.0\nvn 0.0 0.0 1.0\nf 65537/1/1 1/1/1 1/1/1\n";
+        std::vector<uint8_t> data(obj.begin(), obj.end());
+        const min::mem_file mem(&data, 0, data.size());
+        bool thrown = false;
+        try
+        {
+            min::wavefront<double, uint16_t> w(mem);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        if (!out)
+        {
+            throw std::runtime_error("Failed wavefront index type overflow");
+        }
+    }
+
     // Test large wavefront file
     {
         // Since we are using a BMESH, assert floating point compatibility
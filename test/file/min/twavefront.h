@@ -15,10 +15,14 @@ limitations under the License.
 #ifndef TESTWAVEFRONT
 #define TESTWAVEFRONT
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "file/min/wavefront.h"
+#include "platform/min/thread_pool.h"
 #include "platform/min/test.h"
 
 bool test_wavefront();
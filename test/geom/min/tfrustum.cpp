@@ -222,3 +222,89 @@ bool test_frustum()
 
     return out;
 }
+
+template <typename T>
+bool test_frustum_cull_type()
+{
+    bool out = true;
+
+    // Local variables
+    min::frustum<T> f(1.33, 45.0, 0.1, 5);
+    const min::vec3<T> eye(0.0, 0.0, 0.0);
+    const min::vec3<T> forward(0.0, 0.0, 1.0);
+    min::vec3<T> up = min::vec3<T>::up();
+    f.perspective();
+    f.look_at(eye, forward, up);
+
+    // Add a grid of boxes and spheres around the frustum
+    min::cull_list<T> list;
+    std::vector<min::aabbox<T, min::vec3>> boxes;
+    std::vector<min::sphere<T, min::vec3>> spheres;
+    for (int i = -6; i <= 6; i++)
+    {
+        for (int j = -6; j <= 6; j++)
+        {
+            for (int k = -2; k <= 7; k++)
+            {
+                const min::vec3<T> c(i * 0.5, j * 0.5, k);
+                const min::vec3<T> e(0.1, 0.2, 0.3);
+                boxes.emplace_back(c - e, c + e);
+                spheres.emplace_back(c, 0.25);
+                list.add(boxes.back());
+                list.add(spheres.back());
+            }
+        }
+    }
+
+    // Camera for each pass, the second pass reuses the first to hit the cached planes then the camera moves and rotates
+    const min::vec3<T> eyes[4] = {eye, eye, min::vec3<T>(0.5, 0.25, -1.0), min::vec3<T>(-0.5, 0.0, 0.5)};
+    const min::vec3<T> forwards[4] = {forward, forward, min::vec3<T>(0.6, 0.0, 0.8), min::vec3<T>(-0.28, 0.0, 0.96)};
+
+    // Test the batch cull matches the single bound tests
+    for (size_t pass = 0; pass < 4; pass++)
+    {
+        up = min::vec3<T>::up();
+        f.look_at(eyes[pass], forwards[pass], up);
+
+        // Test the frustum planes are finite, NaN planes make every comparison pass
+        for (size_t i = 0; i < 6; i++)
+        {
+            const min::plane<T, min::vec3> &p = f.get_plane(i);
+            out = out && std::isfinite(p.get_normal().x);
+            out = out && std::isfinite(p.get_normal().y);
+            out = out && std::isfinite(p.get_normal().z);
+            out = out && std::isfinite(p.get_distance(eyes[pass]));
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed frustum batch cull planes");
+        }
+
+        list.cull(f);
+        size_t visible = 0;
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            out = out && (list.is_visible(2 * i) == f.between(boxes[i].get_min(), boxes[i].get_max()));
+            out = out && (list.is_visible(2 * i + 1) == f.point_within(spheres[i].get_center(), spheres[i].get_radius()));
+            visible += list.is_visible(2 * i) + list.is_visible(2 * i + 1);
+        }
+
+        // Test some bounds are culled and some are visible
+        out = out && visible > 0 && visible < list.size();
+        if (!out)
+        {
+            throw std::runtime_error("Failed frustum batch cull");
+        }
+    }
+
+    return out;
+}
+
+bool test_frustum_cull()
+{
+    bool out = true;
+    out = out && test_frustum_cull_type<float>();
+    out = out && test_frustum_cull_type<double>();
+
+    return out;
+}
@@ -15,12 +15,15 @@ limitations under the License.
 #ifndef TESTFRUSTUM
 #define TESTFRUSTUM
 
+#include <cmath>
 #include <stdexcept>
 
+#include "geom/min/cull_list.h"
 #include "geom/min/frustum.h"
 #include "math/min/mat4.h"
 #include "platform/min/test.h"
 
 bool test_frustum();
+bool test_frustum_cull();
 
 #endif
@@ -14,8 +14,12 @@ limitations under the License.
 */
 #include <iostream>
 
+#include "file/min/tasset_loader.h"
 #include "file/min/tbmp.h"
 #include "file/min/tdds.h"
+#include "file/min/tdxt_encoder.h"
+#include "file/min/timage.h"
+#include "file/min/tlz.h"
 #include "file/min/tmd5anim.h"
 #include "file/min/tmd5mesh.h"
 #include "file/min/tmem_chunk.h"
@@ -34,10 +38,12 @@ limitations under the License.
 #include "geom/min/tsphere.h"
 #include "geom/min/tsphinter.h"
 #include "geom/min/tsphresolve.h"
+#include "math/min/tbatch.h"
 #include "math/min/tbitflag.h"
 #include "math/min/tcubic.h"
 #include "math/min/tmat2.h"
 #include "math/min/tmat3.h"
+#include "math/min/tmat3x4.h"
 #include "math/min/tmat4.h"
 #include "math/min/tquat.h"
 #include "math/min/tsample.h"
@@ -47,6 +53,7 @@ limitations under the License.
 #include "math/min/tvec2.h"
 #include "math/min/tvec3.h"
 #include "math/min/tvec4.h"
+#include "platform/min/tthread_pool.h"
 #include "scene/min/taabbgrid.h"
 #include "scene/min/taabbtree.h"
 #include "scene/min/tcamera.h"
@@ -69,7 +76,9 @@ int main()
         out = out && test_quat();
         out = out && test_mat2();
         out = out && test_mat3();
+        out = out && test_mat3x4();
         out = out && test_mat4();
+        out = out && test_batch();
         out = out && test_tran2();
         out = out && test_tran3();
         out = out && test_bezier_cubic();
@@ -89,6 +98,7 @@ int main()
         out = out && test_oobbox_intersect();
         out = out && test_oobb_resolve();
         out = out && test_frustum();
+        out = out && test_frustum_cull();
         out = out && test_frustum_intersect();
         out = out && test_camera();
         out = out && test_sample();
@@ -96,6 +106,8 @@ int main()
         out = out && test_model();
         out = out && test_bmp();
         out = out && test_dds();
+        out = out && test_image();
+        out = out && test_dxt_encoder();
         out = out && test_aabb_tree();
         out = out && test_sphere_tree();
         out = out && test_bit_flag();
@@ -106,8 +118,18 @@ int main()
         out = out && test_md5_mesh();
         out = out && test_md5_model();
         out = out && test_physics_aabb_grid();
+        out = out && test_physics_ccd();
+        out = out && test_physics_filter();
+        out = out && test_physics_fixed();
+        out = out && test_physics_contacts();
+        out = out && test_physics_state();
+        out = out && test_physics_stats();
+        out = out && test_physics_raycast();
         out = out && test_serial();
+        out = out && test_thread_pool();
         out = out && test_mem_chunk();
+        out = out && test_lz();
+        out = out && test_asset_loader();
         if (out)
         {
             std::cout << "Graphics tests passed!" << std::endl;
@@ -0,0 +1,108 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __TESTBATCH__
+#define __TESTBATCH__
+
+#include <min/batch.h>
+#include <min/test.h>
+#include <stdexcept>
+#include <vector>
+
+bool test_batch()
+{
+    bool out = true;
+
+    // Local variables
+    const min::mat4<float> A(2.0, 0.0, 1.0, 0.0, 1.0, 3.0, 0.0, 0.0, 0.0, 1.0, 4.0, 0.0, 1.0, 2.0, 3.0, 1.0);
+    const min::mat4<float> B(1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, -1.0, 0.0, 0.0, 5.0, 6.0, 7.0, 1.0);
+    const min::vec4<float> v(1.0, 2.0, 3.0, 1.0);
+
+    // Test multiply matrices matches per element multiply, with output aliasing the input
+    {
+        std::vector<min::mat4<float>> a(5, A);
+        const std::vector<min::mat4<float>> b(5, B);
+        min::multiply_matrices(a.data(), b.data(), a.data(), a.size());
+        const min::vec4<float> e = (A * B) * v;
+        for (const auto &m : a)
+        {
+            const min::vec4<float> p = m * v;
+            out = out && compare(e.x(), p.x(), 1E-4);
+            out = out && compare(e.y(), p.y(), 1E-4);
+            out = out && compare(e.z(), p.z(), 1E-4);
+            out = out && compare(e.w(), p.w(), 1E-4);
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed batch multiply matrices");
+        }
+    }
+
+    // Test transform points matches per element transform
+    {
+        std::vector<min::vec4<float>> p(7, v);
+        min::transform_points(A, p.data(), p.size());
+        const min::vec4<float> e = A * v;
+        for (const auto &q : p)
+        {
+            out = out && compare(e.x(), q.x(), 1E-4);
+            out = out && compare(e.y(), q.y(), 1E-4);
+            out = out && compare(e.z(), q.z(), 1E-4);
+            out = out && compare(e.w(), q.w(), 1E-4);
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed batch transform points");
+        }
+    }
+
+    // Test translate points leaves w unchanged
+    {
+        std::vector<min::vec4<double>> p(3, min::vec4<double>(1.0, 2.0, 3.0, 0.5));
+        min::translate_points(min::vec4<double>(-1.0, 1.0, 2.0, 4.0), p.data(), p.size());
+        out = out && compare(0.0, p[2].x(), 1E-4);
+        out = out && compare(3.0, p[2].y(), 1E-4);
+        out = out && compare(5.0, p[2].z(), 1E-4);
+        out = out && compare(0.5, p[2].w(), 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed batch translate points");
+        }
+    }
+
+    // Test rotate points matches quaternion transform
+    {
+        const min::quat<double> q(min::vec3<double>(0.0, 0.0, 1.0), 90.0);
+        std::vector<min::vec3<double>> p(4, min::vec3<double>(1.0, 2.0, 3.0));
+        min::rotate_points(q, p.data(), p.size());
+        const min::vec3<double> e = q.transform(min::vec3<double>(1.0, 2.0, 3.0));
+        out = out && compare(-2.0, e.x, 1E-4);
+        out = out && compare(1.0, e.y, 1E-4);
+        out = out && compare(3.0, e.z, 1E-4);
+        for (const auto &r : p)
+        {
+            out = out && compare(e.x, r.x, 1E-4);
+            out = out && compare(e.y, r.y, 1E-4);
+            out = out && compare(e.z, r.z, 1E-4);
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed batch rotate points");
+        }
+    }
+
+    return out;
+}
+
+#endif
@@ -0,0 +1,164 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef __TESTMATRIX3X4__
+#define __TESTMATRIX3X4__
+
+#include <min/mat3x4.h>
+#include <min/mat4.h>
+#include <min/test.h>
+#include <stdexcept>
+
+template <typename T>
+bool compare_mat3x4(const min::mat3x4<T> &a, const min::mat4<T> &b, const double tol)
+{
+    bool out = true;
+
+    // Compare by transforming the basis vectors and origin
+    const min::vec4<T> basis[4] = {
+        min::vec4<T>(1.0, 0.0, 0.0, 0.0),
+        min::vec4<T>(0.0, 1.0, 0.0, 0.0),
+        min::vec4<T>(0.0, 0.0, 1.0, 0.0),
+        min::vec4<T>(0.0, 0.0, 0.0, 1.0)};
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        const min::vec4<T> x = a * basis[i];
+        const min::vec4<T> y = b * basis[i];
+        out = out && compare(y.x(), x.x(), tol);
+        out = out && compare(y.y(), x.y(), tol);
+        out = out && compare(y.z(), x.z(), tol);
+        out = out && compare(y.w(), x.w(), tol);
+    }
+
+    return out;
+}
+
+template <typename T>
+bool test_mat3x4_type(const double tol)
+{
+    bool out = true;
+
+    // Local variables
+    const min::vec3<T> t1(1.0, -2.0, 3.0);
+    const min::vec3<T> t2(-0.5, 4.0, 2.0);
+    const min::quat<T> q1(min::vec3<T>(0.0, 1.0, 0.0), 30.0);
+    const min::quat<T> q2(min::vec3<T>(1.0, 0.0, 0.0), -45.0);
+    const min::mat3x4<T> a(t1, q1);
+    const min::mat3x4<T> b(t2, q2);
+    const min::mat4<T> a4(t1, q1);
+    const min::mat4<T> b4(t2, q2);
+
+    // Test construction matches mat4
+    out = out && compare_mat3x4(a, a4, tol);
+    out = out && compare_mat3x4(min::mat3x4<T>(a4), a4, tol);
+    out = out && compare_mat3x4(a, min::mat4<T>(a), tol);
+    if (!out)
+    {
+        throw std::runtime_error("Failed mat3x4 construction");
+    }
+
+    // Test multiply matches mat4
+    min::mat3x4<T> m = a * b;
+    out = out && compare_mat3x4(m, a4 * b4, tol);
+    m = a;
+    m *= b;
+    out = out && compare_mat3x4(m, a4 * b4, tol);
+    m = b;
+    m *= m;
+    out = out && compare_mat3x4(m, b4 * b4, tol);
+    if (!out)
+    {
+        throw std::runtime_error("Failed mat3x4 multiply");
+    }
+
+    // Test point transform, translate then rotate
+    const min::vec3<T> p = min::mat3x4<T>(t1) * min::vec3<T>(1.0, 1.0, 1.0);
+    out = out && compare(2.0, p.x, tol);
+    out = out && compare(-1.0, p.y, tol);
+    out = out && compare(4.0, p.z, tol);
+    const min::vec3<T> r = a * min::vec3<T>(1.0, 1.0, 1.0);
+    const min::vec4<T> r4 = a4 * min::vec4<T>(1.0, 1.0, 1.0, 1.0);
+    out = out && compare(r4.x(), r.x, tol);
+    out = out && compare(r4.y(), r.y, tol);
+    out = out && compare(r4.z(), r.z, tol);
+    if (!out)
+    {
+        throw std::runtime_error("Failed mat3x4 vector transform");
+    }
+
+    // Test translation
+    out = out && compare(t1.x, a.get_translation().x, tol);
+    out = out && compare(t1.y, a.get_translation().y, tol);
+    out = out && compare(t1.z, a.get_translation().z, tol);
+    m = a;
+    m.set_translation(t2);
+    out = out && compare(t2.x, m.get_translation().x, tol);
+    out = out && compare(t2.y, m.get_translation().y, tol);
+    out = out && compare(t2.z, m.get_translation().z, tol);
+    if (!out)
+    {
+        throw std::runtime_error("Failed mat3x4 translation");
+    }
+
+    // Test inverse matches mat4 and undoes the transform
+    m = a * b;
+    min::mat4<T> m4 = a4 * b4;
+    out = out && m.invert();
+    out = out && m4.invert();
+    out = out && compare_mat3x4(m, m4, tol);
+    out = out && compare_mat3x4(m * a * b, min::mat4<T>(), tol);
+
+    // Test scaled inverse
+    m = min::mat3x4<T>(min::mat4<T>(t1).set_scale(min::vec3<T>(2.0, 4.0, 0.5)));
+    m4 = min::mat4<T>(m);
+    out = out && m.invert();
+    out = out && m4.invert();
+    out = out && compare_mat3x4(m, m4, tol);
+
+    // Test singular matrix
+    m = min::mat3x4<T>(min::mat4<T>().set_scale(min::vec3<T>(1.0, 0.0, 1.0)));
+    out = out && !m.invert();
+    if (!out)
+    {
+        throw std::runtime_error("Failed mat3x4 invert");
+    }
+
+    // Test rows
+    const min::vec4<T> row = a.one();
+    const min::vec4<T> col = a4 * min::vec4<T>(1.0, 0.0, 0.0, 0.0);
+    out = out && compare(col.x(), row.x(), tol);
+    out = out && compare(t1.x, row.w(), tol);
+    out = out && compare(t1.y, a.two().w(), tol);
+    out = out && compare(t1.z, a.three().w(), tol);
+    if (!out)
+    {
+        throw std::runtime_error("Failed mat3x4 rows");
+    }
+
+    return out;
+}
+
+bool test_mat3x4()
+{
+    bool out = true;
+
+    // Test double and float, float uses SIMD if enabled
+    out = out && test_mat3x4_type<double>(1E-4);
+    out = out && test_mat3x4_type<float>(1E-4);
+
+    return out;
+}
+
+#endif
@@ -221,6 +221,35 @@ bool test_mat4()
         throw std::runtime_error("Failed mat4 invert matrix");
     }
 
+    // Test float multiply and invert, these use the SSE code path when enabled
+    {
+        const min::mat4<float> A(2.0, 0.0, 1.0, 0.0, 1.0, 3.0, 0.0, 0.0, 0.0, 1.0, 4.0, 0.0, 1.0, 2.0, 3.0, 1.0);
+        min::mat4<float> B = A;
+        out = out && B.invert();
+        const min::vec4<float> v = (A * B) * min::vec4<float>(1.0, 2.0, 3.0, 1.0);
+        out = out && compare(1.0, v.x(), 1E-4);
+        out = out && compare(2.0, v.y(), 1E-4);
+        out = out && compare(3.0, v.z(), 1E-4);
+        out = out && compare(1.0, v.w(), 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed mat4 float invert matrix");
+        }
+
+        // Test *= with itself as the argument
+        B = A;
+        B *= B;
+        const min::vec4<float> u = B * min::vec4<float>(1.0, 1.0, 1.0, 1.0);
+        out = out && compare(15.0, u.x(), 1E-4);
+        out = out && compare(28.0, u.y(), 1E-4);
+        out = out && compare(39.0, u.z(), 1E-4);
+        out = out && compare(1.0, u.w(), 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed mat4 float *= matrix");
+        }
+    }
+
     return out;
 }
 
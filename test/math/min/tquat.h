@@ -130,6 +130,40 @@ bool test_quat()
         throw std::runtime_error("Failed quat slerp vs lerp");
     }
 
+    // Test corrected nlerp x-axis -> y-axis
+    one = min::quat<double>(1.0, 1.0, 1.0);
+    two = min::quat<double>(-1.0, 1.0, -1.0);
+    q = min::quat<double>::nlerp(one, two, 0.2);
+    out = out && compare(0.6300, q.w(), 1E-3);
+    out = out && compare(0.3210, q.x(), 1E-3);
+    out = out && compare(0.6300, q.y(), 1E-3);
+    out = out && compare(0.3210, q.z(), 1E-3);
+    if (!out)
+    {
+        throw std::runtime_error("Failed quat nlerp vs slerp");
+    }
+
+    // Test corrected nlerp error is bounded against slerp
+    for (size_t i = 0; i < 8; i++)
+    {
+        one = min::quat<double>(min::vec3<double>(0.0, 1.0, 0.0), 10.0 * i);
+        two = min::quat<double>(min::vec3<double>(0.6, 0.0, 0.8), 10.0 * i + 60.0);
+        for (size_t j = 0; j <= 10; j++)
+        {
+            const double t = j * 0.1;
+            const min::quat<double> s = min::quat<double>::slerp(one, two, t);
+            q = min::quat<double>::nlerp(one, two, t);
+            out = out && compare(s.w(), q.w(), 1E-3);
+            out = out && compare(s.x(), q.x(), 1E-3);
+            out = out && compare(s.y(), q.y(), 1E-3);
+            out = out && compare(s.z(), q.z(), 1E-3);
+        }
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Failed quat nlerp error bound");
+    }
+
     // Test transform vector with quat
     x = min::vec3<double>(1.0, 0.0, 0.0);
     q = min::quat<double>(1.0, 1.0, 1.0); // x-axis to y-axis
@@ -271,6 +305,23 @@ bool test_quat()
         throw std::runtime_error("Failed quat inverse z-axis rotation");
     }
 
+    // Test float product matches double product, this uses the SSE code path when enabled
+    {
+        const min::quat<double> a(0.5, 0.1, -0.7, 0.3);
+        const min::quat<double> b(-0.2, 0.6, 0.4, -0.8);
+        const min::quat<double> c = a * b;
+        min::quat<float> f = min::quat<float>(0.5, 0.1, -0.7, 0.3);
+        f *= min::quat<float>(-0.2, 0.6, 0.4, -0.8);
+        out = out && compare(c.w(), f.w(), 1E-4);
+        out = out && compare(c.x(), f.x(), 1E-4);
+        out = out && compare(c.y(), f.y(), 1E-4);
+        out = out && compare(c.z(), f.z(), 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed quat float product");
+        }
+    }
+
     return out;
 }
 
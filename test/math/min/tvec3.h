@@ -118,6 +118,18 @@ bool test_vec3()
         throw std::runtime_error("Failed vec3 cross product Z operation");
     }
 
+    // Test cross product of non axis vectors, each component must use the original values
+    one = min::vec3<double>(1.0, 2.0, 3.0);
+    two = min::vec3<double>(4.0, 5.0, 6.0);
+    three = one.cross(two);
+    out = out && compare(-3.0, three.x, 1E-4);
+    out = out && compare(6.0, three.y, 1E-4);
+    out = out && compare(-3.0, three.z, 1E-4);
+    if (!out)
+    {
+        throw std::runtime_error("Failed vec3 cross product operation");
+    }
+
     // Test magnitude; should be 3.74
     one = min::vec3<double>(1.0, 2.0, 3.0);
     double mag = one.magnitude();
@@ -917,6 +917,24 @@ bool test_vec4()
         throw std::runtime_error("Failed vec4 sat penetration");
     }
 
+    // Test float operators leave w unchanged, these use the SSE code path when enabled
+    {
+        min::vec4<float> f(1.0, 2.0, 3.0, 0.5);
+        f += min::vec4<float>(1.0, 1.0, 1.0, 4.0);
+        f *= min::vec4<float>(2.0, 2.0, 2.0, 4.0);
+        f -= 1.0;
+        f /= min::vec4<float>(1.0, 1.0, 5.0, 4.0);
+        out = out && compare(3.0, f.x(), 1E-4);
+        out = out && compare(5.0, f.y(), 1E-4);
+        out = out && compare(1.4, f.z(), 1E-4);
+        out = out && compare(0.5, f.w(), 1E-4);
+        out = out && compare(17.2, f.dot(min::vec4<float>(1.0, 2.0, 3.0, 4.0)), 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed vec4 float operators");
+        }
+    }
+
     return out;
 }
 
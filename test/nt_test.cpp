@@ -0,0 +1,38 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <iostream>
+
+#include "scene/min/tphysics_nt.h"
+
+int main()
+{
+    try
+    {
+        bool out = true;
+        out = out && test_physics_nt_parallel();
+        if (out)
+        {
+            std::cout << "Physics no torque tests passed!" << std::endl;
+            return 0;
+        }
+    }
+    catch (std::exception &ex)
+    {
+        std::cout << ex.what() << std::endl;
+    }
+
+    std::cout << "Physics no torque tests failed!" << std::endl;
+    return -1;
+}
@@ -0,0 +1,90 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef TESTTHREADPOOL
+#define TESTTHREADPOOL
+
+#include "platform/min/test.h"
+#include "platform/min/thread_pool.h"
+#include <stdexcept>
+#include <vector>
+
+bool test_thread_pool()
+{
+    bool out = true;
+
+    // Run the same loop on pools of different sizes
+    for (size_t size = 1; size <= 4; size++)
+    {
+        min::thread_pool pool(size);
+        out = out && compare(size, pool.get_size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed thread_pool size");
+        }
+
+        // Square all numbers in parallel, each item is visited exactly once
+        std::vector<size_t> data(1000, 0);
+        const auto work = [&data](const size_t i) {
+            data[i] += i * i;
+        };
+        pool.run(work, 0, data.size());
+
+        // Test an empty loop does nothing
+        pool.run(work, 10, 10);
+
+        // Test the results
+        size_t sum = 0;
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            sum += data[i];
+        }
+        out = out && compare(332833500, sum);
+        out = out && compare(998001, data[999]);
+        if (!out)
+        {
+            throw std::runtime_error("Failed thread_pool run");
+        }
+
+        // Test an exception in the loop is rethrown on the caller
+        bool thrown = false;
+        const auto fail = [](const size_t i) {
+            if (i == 500)
+            {
+                throw std::runtime_error("thread_pool: test");
+            }
+        };
+        try
+        {
+            pool.run(fail, 0, data.size());
+        }
+        catch (const std::runtime_error &ex)
+        {
+            thrown = compare("thread_pool: test", ex.what());
+        }
+        out = out && thrown;
+
+        // Test the pool still works after the exception
+        pool.run(work, 0, data.size());
+        out = out && compare(2 * 998001, data[999]);
+        if (!out)
+        {
+            throw std::runtime_error("Failed thread_pool exception");
+        }
+    }
+
+    return out;
+}
+
+#endif
@@ -16,6 +16,7 @@ limitations under the License.
 #define __TESTMD5MODEL__
 
 #include "file/min/md5_mesh.h"
+#include "scene/min/md5_anim_cache.h"
 #include "scene/min/md5_model.h"
 #include "platform/min/test.h"
 #include <stdexcept>
@@ -48,6 +49,139 @@ bool test_md5_model()
         throw std::runtime_error("Failed md5 box model bone count");
     }
 
+    // Test shared animation cache
+    min::md5_anim_cache<float> cache(box_model.get_inverse_bind_pose(), 240.0);
+    const size_t walk = cache.add_animation("data/models/bob.md5anim");
+    out = out && compare(0, walk);
+    out = out && compare(1, cache.get_animation_size());
+
+    // Instances at the same quantized time share one palette
+    const min::mat3x4<float> *palette = cache.get_bones(walk, 0.5).data();
+    for (size_t i = 0; i < 100; i++)
+    {
+        out = out && (palette == cache.get_bones(walk, 0.5 + 0.001 * (i % 4)).data());
+    }
+    out = out && compare(1, cache.size());
+
+    // Palette matches the model bones, the animation has no loops so step() above kept the first frame
+    const std::vector<min::mat3x4<float>> &shared = cache.get_bones(walk, 0.0);
+    const std::vector<min::mat3x4<float>> &bones = box_model.get_bones();
+    out = out && compare(bones.size(), shared.size());
+    for (size_t i = 0; i < bones.size(); i++)
+    {
+        out = out && compare(bones[i].one().x(), shared[i].one().x(), 1E-3);
+        out = out && compare(bones[i].two().w(), shared[i].two().w(), 1E-3);
+        out = out && compare(bones[i].three().z(), shared[i].three().z(), 1E-3);
+    }
+
+    // Distinct times evaluate new palettes, older palettes stay valid
+    cache.get_bones(walk, 0.25);
+    cache.get_bones(walk, 0.25 + cache.get_animation(walk).get_length());
+    out = out && compare(3, cache.size());
+    out = out && (palette == cache.get_bones(walk, 0.5).data());
+
+    // Clear keeps memory but drops the lookup
+    cache.clear();
+    out = out && compare(0, cache.size());
+    cache.get_bones(walk, 0.75);
+    out = out && compare(1, cache.size());
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 animation cache");
+    }
+
+    // Test an animation without a finite length is rejected, a baked zero frame rate gives an infinite length
+    std::vector<uint8_t> baked;
+    cache.get_animation(walk).serialize(baked);
+    min::write_le<uint32_t>(baked, 0, 8);
+    bool thrown = false;
+    try
+    {
+        cache.add_animation(min::mem_file(&baked, 0, baked.size()));
+    }
+    catch (const std::runtime_error &ex)
+    {
+        thrown = true;
+    }
+    out = out && thrown;
+    out = out && compare(1, cache.get_animation_size());
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 animation cache length");
+    }
+
+    // Test lod selection by distance
+    box_model.add_lod(200.0, 4, 1);
+    box_model.add_lod(50.0, 2, 0);
+    box_model.set_lod_distance(10.0);
+    out = out && compare(1, box_model.get_lod_rate());
+    out = out && compare(0, box_model.get_lod_prune());
+    box_model.set_lod_distance(100.0);
+    out = out && compare(2, box_model.get_lod_rate());
+    out = out && compare(0, box_model.get_lod_prune());
+    box_model.set_lod_distance(300.0);
+    out = out && compare(4, box_model.get_lod_rate());
+    out = out && compare(1, box_model.get_lod_prune());
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 box model lod distance");
+    }
+
+    // Test lod update rate reuses the last pose
+    box_model.get_current_animation().set_loop_count(100);
+    box_model.set_lod(3, 0);
+    box_model.step(0.1);
+    box_model.step(0.1);
+    box_model.step(0.1);
+    const min::vec4<float> lod_row = box_model.get_bones()[1].one();
+    box_model.step(0.1);
+    box_model.step(0.1);
+    out = out && compare(lod_row.x(), box_model.get_bones()[1].one().x(), 1E-6);
+    out = out && compare(lod_row.w(), box_model.get_bones()[1].one().w(), 1E-6);
+    box_model.step(0.1);
+    out = out && !compare(lod_row.w(), box_model.get_bones()[1].one().w(), 1E-6);
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 box model lod update rate");
+    }
+
+    // Test pruned leaf joints follow their parent
+    box_model.set_lod(1, 1);
+    const std::vector<min::mat3x4<float>> prev_frame = box_model.get_current_animation().get_current_frame();
+    box_model.step(0.1);
+    const std::vector<min::mat3x4<float>> &frame = box_model.get_current_animation().get_current_frame();
+    const std::vector<min::md5_node> &nodes = box_model.get_current_animation().get_nodes();
+    std::vector<bool> leaf(nodes.size(), true);
+    for (const auto &n : nodes)
+    {
+        if (n.get_parent() >= 0)
+        {
+            leaf[n.get_parent()] = false;
+        }
+    }
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        if (leaf[i] && nodes[i].get_parent() >= 0)
+        {
+            const min::mat3x4<float> &a = box_model.get_bones()[i];
+            const min::mat3x4<float> &b = box_model.get_bones()[nodes[i].get_parent()];
+            out = out && compare(b.one().x(), a.one().x(), 1E-6);
+            out = out && compare(b.two().w(), a.two().w(), 1E-6);
+            out = out && compare(b.three().y(), a.three().y(), 1E-6);
+
+            // Pruned joints are never interpolated
+            out = out && compare(prev_frame[i].one().w(), frame[i].one().w(), 0.0);
+            out = out && compare(prev_frame[i].two().w(), frame[i].two().w(), 0.0);
+            out = out && compare(prev_frame[i].three().x(), frame[i].three().x(), 0.0);
+        }
+    }
+    out = out && compare(15, box_model.get_bones().size());
+    box_model.set_lod(1, 0);
+    if (!out)
+    {
+        throw std::runtime_error("Failed md5 box model lod prune");
+    }
+
     // Higher polygon mech warrior mesh
     min::md5_mesh<float, uint16_t> mech_md5 = min::md5_mesh<float, uint16_t>("data/models/mech_warrior.md5mesh");
     min::md5_model<float, uint16_t, min::vec4, min::aabbox> mech_model(std::move(mech_md5));
@@ -17,8 +17,10 @@ limitations under the License.
 
 #include "scene/min/grid.h"
 #include "scene/min/physics.h"
+#include "platform/min/thread_pool.h"
 #include "platform/min/test.h"
 #include "math/min/vec2.h"
+#include <limits>
 #include <stdexcept>
 
 bool test_physics_aabb_grid()
@@ -303,4 +305,486 @@ bool test_physics_aabb_grid()
     return out;
 }
 
+bool test_physics_ccd()
+{
+    bool out = true;
+
+    // vec2 grid simulation
+    {
+        // Local variables
+        const min::vec2<double> minW(-10.0, -10.0);
+        const min::vec2<double> maxW(10.0, 10.0);
+        const min::aabbox<double, min::vec2> world(minW, maxW);
+        const min::vec2<double> gravity(0.0, 0.0);
+        min::physics<double, uint_fast16_t, uint_fast32_t, min::vec2, min::aabbox, min::aabbox, min::grid> simulation(world, gravity);
+
+        // Add a thin static wall and a small fast moving projectile
+        const min::aabbox<double, min::vec2> wall(min::vec2<double>(0.0, -5.0), min::vec2<double>(0.1, 5.0));
+        const min::aabbox<double, min::vec2> bullet(min::vec2<double>(-2.1, -0.1), min::vec2<double>(-1.9, 0.1));
+        const size_t wall_id = simulation.add_body(wall, 1.0);
+        const size_t bullet_id = simulation.add_body(bullet, 1.0);
+
+        // The wall has infinite mass
+        min::body<double, min::vec2> &body1 = simulation.get_body(wall_id);
+        body1.set_no_move();
+        body1.set_no_rotate();
+
+        // The projectile moves 10 units in one timestep
+        min::body<double, min::vec2> &body2 = simulation.get_body(bullet_id);
+        body2.set_linear_velocity(min::vec2<double>(100.0, 0.0));
+        body2.set_ccd(true);
+
+        // Solve the simulation, the projectile should stop at the wall
+        simulation.solve(0.1, 0.0);
+        const min::vec2<double> &p = body2.get_position();
+        out = out && compare(-0.1, p.x, 1E-3);
+        out = out && compare(0.0, p.y, 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics ccd vec2 time of impact");
+        }
+
+        // Solve the simulation, the projectile should bounce off the wall
+        simulation.solve(0.1, 0.0);
+        const min::vec2<double> &v = body2.get_linear_velocity();
+        out = out && v.x < 0.0;
+        out = out && p.x < -0.1;
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics ccd vec2 collision");
+        }
+    }
+
+    return out;
+}
+
+bool test_physics_filter()
+{
+    bool out = true;
+
+    // vec2 grid simulation
+    {
+        // Local variables
+        const min::vec2<double> minW(-10.0, -10.0);
+        const min::vec2<double> maxW(10.0, 10.0);
+        const min::aabbox<double, min::vec2> world(minW, maxW);
+        const min::vec2<double> gravity(0.0, 0.0);
+        min::physics<double, uint_fast16_t, uint_fast32_t, min::vec2, min::aabbox, min::aabbox, min::grid> simulation(world, gravity);
+
+        // Add three overlapping debris boxes and a player box
+        const min::aabbox<double, min::vec2> box1(min::vec2<double>(0.0, 0.0), min::vec2<double>(1.0, 1.0));
+        const min::aabbox<double, min::vec2> box2(min::vec2<double>(0.5, 0.0), min::vec2<double>(1.5, 1.0));
+        const min::aabbox<double, min::vec2> box3(min::vec2<double>(5.0, 5.0), min::vec2<double>(6.0, 6.0));
+        const min::aabbox<double, min::vec2> box4(min::vec2<double>(5.5, 5.0), min::vec2<double>(6.5, 6.0));
+        const size_t body1_id = simulation.add_body(box1, 1.0);
+        const size_t body2_id = simulation.add_body(box2, 1.0);
+        const size_t body3_id = simulation.add_body(box3, 1.0);
+        const size_t body4_id = simulation.add_body(box4, 1.0);
+
+        // Debris never collides with debris, the player collides with everything
+        const min::collision_filter debris(0x2, ~0x2u);
+        const min::collision_filter player(0x1, 0xFFFFFFFF);
+        simulation.set_filter(body1_id, debris);
+        simulation.set_filter(body2_id, debris);
+        simulation.set_filter(body3_id, debris);
+        simulation.set_filter(body4_id, player);
+
+        // Move all bodies towards each other
+        min::body<double, min::vec2> &body1 = simulation.get_body(body1_id);
+        min::body<double, min::vec2> &body2 = simulation.get_body(body2_id);
+        min::body<double, min::vec2> &body3 = simulation.get_body(body3_id);
+        min::body<double, min::vec2> &body4 = simulation.get_body(body4_id);
+        body1.set_linear_velocity(min::vec2<double>(1.0, 0.0));
+        body2.set_linear_velocity(min::vec2<double>(-1.0, 0.0));
+        body3.set_linear_velocity(min::vec2<double>(1.0, 0.0));
+        body4.set_linear_velocity(min::vec2<double>(-1.0, 0.0));
+
+        // Solve the simulation
+        simulation.solve(0.01, 0.0);
+
+        // Test debris passed through each other
+        const min::vec2<double> &v1 = body1.get_linear_velocity();
+        const min::vec2<double> &v2 = body2.get_linear_velocity();
+        out = out && compare(1.0, v1.x, 1E-4);
+        out = out && compare(-1.0, v2.x, 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics filter debris");
+        }
+
+        // Test debris collided with the player
+        const min::vec2<double> &v3 = body3.get_linear_velocity();
+        const min::vec2<double> &v4 = body4.get_linear_velocity();
+        out = out && compare(-1.0, v3.x, 1E-4);
+        out = out && compare(1.0, v4.x, 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics filter player");
+        }
+    }
+
+    return out;
+}
+
+bool test_physics_fixed()
+{
+    bool out = true;
+
+    // vec2 grid simulation
+    {
+        // Local variables
+        const min::vec2<double> minW(-10.0, -10.0);
+        const min::vec2<double> maxW(10.0, 10.0);
+        const min::aabbox<double, min::vec2> world(minW, maxW);
+        const min::vec2<double> gravity(0.0, 0.0);
+        min::physics<double, uint_fast16_t, uint_fast32_t, min::vec2, min::aabbox, min::aabbox, min::grid> simulation(world, gravity);
+
+        // Add a moving body
+        const min::aabbox<double, min::vec2> box(min::vec2<double>(-0.5, -0.5), min::vec2<double>(0.5, 0.5));
+        const size_t body_id = simulation.add_body(box, 1.0);
+        min::body<double, min::vec2> &b = simulation.get_body(body_id);
+        b.set_linear_velocity(min::vec2<double>(1.0, 0.0));
+
+        // Use a fixed timestep of 0.01 with at most 4 steps per frame
+        simulation.set_fixed_timestep(0.01, 4);
+
+        // Test a frame of 0.025 runs two steps with half a step left over
+        size_t steps = simulation.solve_fixed(0.025, 0.0);
+        out = out && compare(2, steps);
+        out = out && compare(0.5, simulation.get_interpolation(), 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics fixed steps");
+        }
+
+        // Test the interpolated position is between the last two steps
+        const min::vec2<double> p = b.get_interpolated_position(simulation.get_interpolation());
+        out = out && compare(0.015, p.x, 1E-4);
+        out = out && compare(0.0, p.y, 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics fixed interpolation");
+        }
+
+        // Test a long frame is capped at the maximum number of steps
+        steps = simulation.solve_fixed(1.0, 0.0);
+        out = out && compare(4, steps);
+        out = out && compare(0.06, b.get_position().x, 1E-4);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics fixed step cap");
+        }
+
+        // Test invalid timesteps are rejected and the old timestep is kept
+        const double bad_dt[3] = {0.0, -0.01, std::numeric_limits<double>::infinity()};
+        for (size_t i = 0; i < 3; i++)
+        {
+            bool thrown = false;
+            try
+            {
+                simulation.set_fixed_timestep(bad_dt[i], 4);
+            }
+            catch (const std::runtime_error &ex)
+            {
+                thrown = true;
+            }
+            out = out && thrown;
+        }
+        bool thrown = false;
+        try
+        {
+            simulation.set_fixed_timestep(0.01, 0);
+        }
+        catch (const std::runtime_error &ex)
+        {
+            thrown = true;
+        }
+        out = out && thrown;
+        steps = simulation.solve_fixed(0.01, 0.0);
+        out = out && compare(1, steps);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics fixed invalid timestep");
+        }
+    }
+
+    return out;
+}
+
+bool test_physics_contacts()
+{
+    bool out = true;
+
+    // vec2 grid simulation
+    {
+        // Local variables
+        const min::vec2<double> minW(-10.0, -10.0);
+        const min::vec2<double> maxW(10.0, 10.0);
+        const min::aabbox<double, min::vec2> world(minW, maxW);
+        const min::vec2<double> gravity(0.0, 0.0);
+        min::physics<double, uint_fast16_t, uint_fast32_t, min::vec2, min::aabbox, min::aabbox, min::grid> simulation(world, gravity);
+
+        // Add two overlapping boxes moving towards each other
+        const min::aabbox<double, min::vec2> box1(min::vec2<double>(0.0, 0.0), min::vec2<double>(1.0, 1.0));
+        const min::aabbox<double, min::vec2> box2(min::vec2<double>(0.5, 0.0), min::vec2<double>(1.5, 1.0));
+        const size_t body1_id = simulation.add_body(box1, 1.0);
+        const size_t body2_id = simulation.add_body(box2, 1.0);
+        simulation.get_body(body1_id).set_linear_velocity(min::vec2<double>(1.0, 0.0));
+        simulation.get_body(body2_id).set_linear_velocity(min::vec2<double>(-1.0, 0.0));
+
+        // Solve the simulation
+        simulation.solve(0.01, 0.0);
+
+        // Test one contact event was recorded between both bodies
+        const std::vector<min::contact<double, min::vec2>> &contacts = simulation.get_contacts();
+        out = out && compare(1, contacts.size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics contacts size");
+        }
+
+        // Test the contact event data
+        const min::contact<double, min::vec2> &c = contacts[0];
+        out = out && compare(1, c.get_index1() + c.get_index2());
+        out = out && compare(2.0, c.get_impulse(), 1E-4);
+        const min::vec2<double> d = simulation.get_body(c.get_index1()).get_position() - simulation.get_body(c.get_index2()).get_position();
+        out = out && (c.get_normal().dot(d) > 0.0);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics contacts data");
+        }
+
+        // Test the bodies separate and the next solve records no contacts
+        simulation.solve(0.5, 0.0);
+        out = out && compare(0, simulation.get_contacts().size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics contacts drain");
+        }
+    }
+
+    return out;
+}
+
+bool test_physics_state()
+{
+    bool out = true;
+
+    // vec2 grid simulation
+    {
+        // Local variables
+        const min::vec2<double> minW(-10.0, -10.0);
+        const min::vec2<double> maxW(10.0, 10.0);
+        const min::aabbox<double, min::vec2> world(minW, maxW);
+        const min::vec2<double> gravity(0.0, -10.0);
+        min::physics<double, uint_fast16_t, uint_fast32_t, min::vec2, min::aabbox, min::aabbox, min::grid> simulation(world, gravity);
+
+        // Add a row of boxes moving towards each other
+        for (size_t i = 0; i < 8; i++)
+        {
+            const double x = -4.0 + i;
+            const min::aabbox<double, min::vec2> box(min::vec2<double>(x, 0.0), min::vec2<double>(x + 0.9, 0.9));
+            const size_t id = simulation.add_body(box, 1.0 + i);
+            simulation.get_body(id).set_linear_velocity(min::vec2<double>((i % 2) ? -3.0 : 3.0, 1.0));
+        }
+
+        // Simulate a few frames and take a snapshot
+        for (size_t i = 0; i < 4; i++)
+        {
+            simulation.solve(0.05, 0.1);
+        }
+        min::physics_state<double, min::vec2, min::aabbox> state;
+        simulation.save_state(state);
+
+        // Simulate eight frames and record the positions
+        std::vector<min::vec2<double>> position;
+        std::vector<min::vec2<double>> velocity;
+        for (size_t i = 0; i < 8; i++)
+        {
+            simulation.solve(0.05, 0.1);
+        }
+        for (const auto &b : simulation.get_bodies())
+        {
+            position.push_back(b.get_position());
+            velocity.push_back(b.get_linear_velocity());
+        }
+
+        // Rollback and resimulate the same eight frames
+        simulation.load_state(state);
+        for (size_t i = 0; i < 8; i++)
+        {
+            simulation.solve(0.05, 0.1);
+        }
+
+        // Test the resimulation is bit exact
+        const std::vector<min::body<double, min::vec2>> &bodies = simulation.get_bodies();
+        out = out && compare(8, bodies.size());
+        for (size_t i = 0; i < bodies.size(); i++)
+        {
+            out = out && compare(position[i].x, bodies[i].get_position().x, 0.0);
+            out = out && compare(position[i].y, bodies[i].get_position().y, 0.0);
+            out = out && compare(velocity[i].x, bodies[i].get_linear_velocity().x, 0.0);
+            out = out && compare(velocity[i].y, bodies[i].get_linear_velocity().y, 0.0);
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics state rollback");
+        }
+    }
+
+    return out;
+}
+
+bool test_physics_stats()
+{
+    bool out = true;
+
+#ifdef MGL_PHYSICS_PROFILE
+    // vec2 grid simulation
+    {
+        // Local variables
+        const min::vec2<double> minW(-10.0, -10.0);
+        const min::vec2<double> maxW(10.0, 10.0);
+        const min::aabbox<double, min::vec2> world(minW, maxW);
+        const min::vec2<double> gravity(0.0, 0.0);
+        min::physics<double, uint_fast16_t, uint_fast32_t, min::vec2, min::aabbox, min::aabbox, min::grid> simulation(world, gravity);
+
+        // Add two overlapping boxes and one dead box
+        const min::aabbox<double, min::vec2> box1(min::vec2<double>(0.0, 0.0), min::vec2<double>(1.0, 1.0));
+        const min::aabbox<double, min::vec2> box2(min::vec2<double>(0.5, 0.0), min::vec2<double>(1.5, 1.0));
+        const min::aabbox<double, min::vec2> box3(min::vec2<double>(5.0, 5.0), min::vec2<double>(6.0, 6.0));
+        simulation.add_body(box1, 1.0);
+        simulation.add_body(box2, 1.0);
+        const size_t body3_id = simulation.add_body(box3, 1.0);
+        simulation.clear_body(body3_id);
+
+        // Solve the simulation
+        simulation.solve(0.01, 0.0);
+
+        // Test the stats of the last timestep
+        const min::physics_stats &stats = simulation.get_stats();
+        out = out && compare(3, stats.shapes);
+        out = out && (stats.pairs >= stats.collisions);
+        out = out && compare(1, stats.collisions);
+        out = out && compare(1, stats.dead);
+        out = out && (stats.cells >= 1);
+        out = out && (stats.get_total_time() >= 0.0);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics stats counts");
+        }
+
+        // Test the rolling history
+        for (size_t i = 0; i < 100; i++)
+        {
+            simulation.solve(0.01, 0.0);
+        }
+        out = out && compare(64, simulation.get_stats_size());
+        out = out && compare(3, simulation.get_stats(63).shapes);
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics stats history");
+        }
+    }
+#endif
+
+    return out;
+}
+
+bool test_physics_raycast()
+{
+    bool out = true;
+
+    // vec2 grid simulation
+    {
+        // Local variables
+        const min::vec2<double> minW(-10.0, -10.0);
+        const min::vec2<double> maxW(10.0, 10.0);
+        const min::aabbox<double, min::vec2> world(minW, maxW);
+        const min::vec2<double> gravity(0.0, 0.0);
+        min::physics<double, uint_fast16_t, uint_fast32_t, min::vec2, min::aabbox, min::aabbox, min::grid> simulation(world, gravity);
+
+        // Add three boxes on the x axis, the closest box to the right is on layer 0x2
+        const min::aabbox<double, min::vec2> box1(min::vec2<double>(2.0, 0.0), min::vec2<double>(3.0, 1.0));
+        const min::aabbox<double, min::vec2> box2(min::vec2<double>(5.0, 0.0), min::vec2<double>(6.0, 1.0));
+        const min::aabbox<double, min::vec2> box3(min::vec2<double>(-4.0, 0.0), min::vec2<double>(-3.0, 1.0));
+        const size_t body1_id = simulation.add_body(box1, 1.0);
+        const size_t body2_id = simulation.add_body(box2, 1.0);
+        const size_t body3_id = simulation.add_body(box3, 1.0);
+        simulation.set_filter(body1_id, min::collision_filter(0x2, 0xFFFFFFFF));
+
+        // Solve the simulation to build the spatial structure
+        simulation.solve(0.01, 0.0);
+
+        // Create rays right, right without layer 0x2, left and a miss
+        const min::vec2<double> origin(0.0, 0.5);
+        const std::vector<min::ray<double, min::vec2>> rays = {
+            min::ray<double, min::vec2>(origin, min::vec2<double>(10.0, 0.5)),
+            min::ray<double, min::vec2>(origin, min::vec2<double>(10.0, 0.5)),
+            min::ray<double, min::vec2>(origin, min::vec2<double>(-10.0, 0.5)),
+            min::ray<double, min::vec2>(min::vec2<double>(0.0, 5.5), min::vec2<double>(10.0, 5.5))};
+        const std::vector<uint32_t> masks = {0xFFFFFFFF, ~0x2u, 0xFFFFFFFF, 0xFFFFFFFF};
+
+        // Cast the rays with a single thread
+        min::thread_pool pool1(1);
+        std::vector<min::ray_hit<double, min::vec2>> hits1;
+        simulation.get_collisions(pool1, rays, masks, hits1);
+        out = out && compare(4, hits1.size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics raycast size");
+        }
+
+        // Test the closest hit on each ray
+        out = out && hits1[0].is_hit();
+        out = out && compare(body1_id, hits1[0].get_index());
+        out = out && compare(2.0, hits1[0].get_distance(), 1E-4);
+        out = out && hits1[1].is_hit();
+        out = out && compare(body2_id, hits1[1].get_index());
+        out = out && compare(5.0, hits1[1].get_distance(), 1E-4);
+        out = out && hits1[2].is_hit();
+        out = out && compare(body3_id, hits1[2].get_index());
+        out = out && compare(3.0, hits1[2].get_distance(), 1E-4);
+        out = out && !hits1[3].is_hit();
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics raycast hits");
+        }
+
+        // Test many rays with several threads give the same results
+        std::vector<min::ray<double, min::vec2>> many;
+        std::vector<uint32_t> many_masks;
+        for (size_t i = 0; i < 200; i++)
+        {
+            many.push_back(rays[i % 4]);
+            many_masks.push_back(masks[i % 4]);
+        }
+        min::thread_pool pool4(4);
+        std::vector<min::ray_hit<double, min::vec2>> hits4;
+        simulation.get_collisions(pool4, many, many_masks, hits4);
+        out = out && compare(200, hits4.size());
+        for (size_t i = 0; i < 200; i++)
+        {
+            const min::ray_hit<double, min::vec2> &h = hits1[i % 4];
+            out = out && (h.is_hit() == hits4[i].is_hit());
+            out = out && compare(h.get_index(), hits4[i].get_index());
+            out = out && compare(h.get_distance(), hits4[i].get_distance(), 0.0);
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics raycast parallel");
+        }
+
+        // Test an empty mask list uses all layers
+        simulation.get_collisions(pool4, rays, std::vector<uint32_t>(), hits4);
+        out = out && compare(body1_id, hits4[1].get_index());
+        if (!out)
+        {
+            throw std::runtime_error("Failed physics raycast default mask");
+        }
+    }
+
+    return out;
+}
+
 #endif
@@ -0,0 +1,128 @@
+/* Copyright [2013-2018] [Aaron Springstroh, Minimal Graphics Library]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef TESTPHYSICSNT
+#define TESTPHYSICSNT
+
+#include "scene/min/grid.h"
+#include "scene/min/physics_nt.h"
+#include "platform/min/thread_pool.h"
+#include "platform/min/test.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+typedef min::physics<double, uint_fast16_t, uint_fast32_t, min::vec3, min::aabbox, min::aabbox, min::grid> physics_nt_sim;
+
+// Simulate a dense cluster of boxes where most bodies touch several others
+// Returns the body positions and velocities, the max speed seen and the final energy
+std::vector<double> run_physics_nt(const size_t threads, const bool parallel, double &max_speed, double &energy)
+{
+    const min::vec3<double> minW(-20.0, -20.0, -20.0);
+    const min::vec3<double> maxW(20.0, 20.0, 20.0);
+    const min::aabbox<double, min::vec3> world(minW, maxW);
+    const min::vec3<double> gravity(0.0, -10.0, 0.0);
+    physics_nt_sim simulation(world, gravity);
+
+    // Overlapping boxes with pseudo random mass and velocity
+    unsigned seed = 1;
+    const auto random = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return ((seed >> 8) & 0xFFFF) / 65535.0;
+    };
+    for (int i = 0; i < 8; i++)
+    {
+        for (int j = 0; j < 8; j++)
+        {
+            for (int k = 0; k < 8; k++)
+            {
+                const min::vec3<double> p(i * 0.9 - 4.0, j * 0.9 - 4.0, k * 0.9 - 4.0);
+                const min::aabbox<double, min::vec3> box(p, p + min::vec3<double>(1.0, 1.0, 1.0));
+                const size_t id = simulation.add_body(box, 1.0 + random());
+                const min::vec3<double> v(random() * 4.0 - 2.0, random() * 4.0 - 2.0, random() * 4.0 - 2.0);
+                simulation.get_body(id).set_linear_velocity(v);
+            }
+        }
+    }
+
+    // Solve the simulation and track the fastest body
+    min::thread_pool pool(threads);
+    max_speed = 0.0;
+    for (size_t i = 0; i < 30; i++)
+    {
+        if (parallel)
+        {
+            simulation.solve_parallel(pool, 1.0 / 60.0, 0.1);
+        }
+        else
+        {
+            simulation.solve(1.0 / 60.0, 0.1);
+        }
+
+        for (const auto &b : simulation.get_bodies())
+        {
+            max_speed = std::max(max_speed, b.get_linear_velocity().magnitude());
+        }
+    }
+    energy = simulation.get_total_energy();
+
+    // Store the body state
+    std::vector<double> out;
+    for (const auto &b : simulation.get_bodies())
+    {
+        const min::vec3<double> &p = b.get_position();
+        const min::vec3<double> &v = b.get_linear_velocity();
+        out.insert(out.end(), {p.x, p.y, p.z, v.x, v.y, v.z});
+    }
+
+    return out;
+}
+
+bool test_physics_nt_parallel()
+{
+    bool out = true;
+
+    // Solve the same scene serially and with different pool sizes
+    double speed_1, speed_2, speed_4, speed_serial;
+    double energy_1, energy_2, energy_4, energy_serial;
+    const std::vector<double> state_1 = run_physics_nt(1, true, speed_1, energy_1);
+    const std::vector<double> state_2 = run_physics_nt(2, true, speed_2, energy_2);
+    const std::vector<double> state_4 = run_physics_nt(4, true, speed_4, energy_4);
+    const std::vector<double> state_serial = run_physics_nt(1, false, speed_serial, energy_serial);
+
+    // Test the parallel solve is bit identical for any pool size
+    out = out && compare(state_1.size(), state_2.size());
+    out = out && compare(state_1.size(), state_4.size());
+    for (size_t i = 0; out && i < state_1.size(); i++)
+    {
+        out = out && compare(state_1[i], state_2[i], 0.0);
+        out = out && compare(state_1[i], state_4[i], 0.0);
+    }
+    if (!out)
+    {
+        throw std::runtime_error("Failed physics_nt parallel determinism");
+    }
+
+    // Test the parallel solve doesn't inject energy compared to the serial solve
+    out = out && speed_1 < speed_serial * 1.5;
+    out = out && compare(energy_serial, energy_1, std::abs(energy_serial) * 0.01);
+    if (!out)
+    {
+        throw std::runtime_error("Failed physics_nt parallel energy");
+    }
+
+    return out;
+}
+
+#endif
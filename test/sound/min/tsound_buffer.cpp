@@ -88,6 +88,44 @@ bool test_sound_buffer()
                 throw std::runtime_error("Failed sound buffer test");
             }
         }
+
+        // Stream a OGG file
+        {
+            // Alert what file we are playing
+            std::cout << "Streaming 'invention_no_1.ogg' OGG file" << std::endl;
+
+            // Load a sound buffer
+            min::sound_buffer player;
+
+            // Create a stream, only the compressed file is loaded
+            size_t o = player.add_ogg_stream("data/sound/invention_no_1.ogg");
+
+            // Create a source
+            size_t s = player.add_source();
+
+            // Test a second stream on the same source stops the first
+            const size_t o2 = player.add_ogg_stream("data/sound/invention_no_1.ogg");
+            player.play_stream(o2, s);
+            out = out && player.is_streaming(o2);
+
+            // Play the stream, buffers are refilled in the background
+            player.play_stream(o, s);
+            out = out && player.is_streaming(o);
+            out = out && !player.is_streaming(o2);
+
+            // Wait for the stream to finish
+            while (player.is_streaming(o))
+            {
+                std::this_thread::sleep_for(std::chrono::duration<double>(0.1));
+            }
+
+            // See if we got any errors
+            out = out && !min::check_al_error();
+            if (!out)
+            {
+                throw std::runtime_error("Failed sound buffer stream test");
+            }
+        }
     }
 
     return out;